@@ -0,0 +1,113 @@
+#include "bench_utils.hpp"
+#include "networking/client.hpp"
+#include "networking/server.hpp"
+#include "networking/socket_io.hpp"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Chatty small messages. Client side: a burst of kBurst 16-byte messages
+// sent one by one (one sendmsg each) or with sendBatch (one sendmsg).
+// Server side: each request is answered by kBurst replies from the
+// handler; the loop flushes them in one write after the dispatch.
+
+namespace {
+
+constexpr size_t kBurst = 16;
+constexpr size_t kBursts = 5000;
+constexpr size_t kRequests = 5000;
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+bool read_exact(int fd, void* out, size_t n) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    while (n > 0) {
+        ssize_t r = ::recv(fd, p, n, 0);
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+Message small(uint64_t value) {
+    Message m(1);
+    m << value << value;
+    return m;
+}
+
+void client_bursts(bool batched) {
+    Server server;
+    std::atomic<size_t> received{0};
+    server.defineAction(1, [&received](Server::ClientID, const Message&) { ++received; });
+    server.start(0);
+    Client client;
+    client.setNoDelay(true);
+    client.connect("127.0.0.1", server.getPort());
+
+    std::vector<Message> burst;
+    for (size_t i = 0; i < kBurst; ++i) burst.push_back(small(i));
+    double seconds = timeIt(1, [&] {
+        for (size_t b = 0; b < kBursts; ++b) {
+            if (batched) {
+                client.sendBatch(burst);
+            } else {
+                for (const Message& m : burst) client.send(m);
+            }
+        }
+        while (received.load() < kBursts * kBurst) std::this_thread::yield();
+    });
+    report(batched ? "Client::sendBatch" : "Client::send x16", seconds, kBursts * kBurst, 2 * sizeof(uint64_t));
+    client.disconnect();
+    server.stop();
+}
+
+void server_replies() {
+    Server server;
+    server.setDefaultNoDelay(true);
+    server.defineAction(1, [&server](Server::ClientID id, const Message&) {
+        for (size_t i = 0; i < kBurst; ++i) server.sendTo(small(i), id);
+    });
+    server.start(0);
+    int fd = connect_loopback(static_cast<uint16_t>(server.getPort()));
+
+    uint8_t request[FRAME_HEADER_SIZE];
+    encode_frame_header(request, 1, 0);
+    std::vector<uint8_t> replies(kBurst * (FRAME_HEADER_SIZE + 2 * sizeof(uint64_t)));
+    double seconds = timeIt(kRequests, [&] {
+        if (::send(fd, request, sizeof(request), MSG_NOSIGNAL) < 0) return;
+        read_exact(fd, replies.data(), replies.size());
+    });
+    report("request -> 16 replies (round trip)", seconds, kRequests, replies.size());
+    ::close(fd);
+    server.stop();
+}
+
+}
+
+int main() {
+    std::printf("Bursts of %zu small messages (ns/op = per message, per request for the round trip)\n", kBurst);
+    client_bursts(false);
+    client_bursts(true);
+    server_replies();
+    return 0;
+}
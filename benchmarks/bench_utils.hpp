@@ -0,0 +1,31 @@
+#ifndef BENCH_UTILS_HPP
+#define BENCH_UTILS_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+// Minimal helpers shared by the micro-benchmarks under benchmarks/.
+
+// Prevent the optimizer from discarding a computed value.
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run fn() `iterations` times and return the elapsed time in seconds.
+template<typename Fn>
+inline double timeIt(size_t iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+inline void report(const char* name, double seconds, size_t iterations, size_t bytesPerIteration) {
+    double nsPerOp = seconds * 1e9 / static_cast<double>(iterations);
+    double mbPerSec = static_cast<double>(bytesPerIteration) * static_cast<double>(iterations) / seconds / (1024.0 * 1024.0);
+    std::printf("  %-36s %10.1f ns/op %10.1f MB/s\n", name, nsPerOp, mbPerSec);
+}
+
+#endif // BENCH_UTILS_HPP
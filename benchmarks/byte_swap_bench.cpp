@@ -0,0 +1,68 @@
+#include "bench_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <vector>
+#include <cstdint>
+
+// Throughput of byte-order conversion for telemetry-sized arrays: plain
+// memcpy (the host-order path), the per-element scalar loop, the dispatched
+// SIMD kernel, and a full DataBuffer vector encode in big endian.
+
+namespace {
+
+constexpr size_t kBytes = 256 * 1024;
+constexpr size_t kIterations = 4000;
+
+template<typename T>
+void runWidth(const char* label) {
+    const size_t count = kBytes / sizeof(T);
+    std::vector<T> src(count);
+    for (size_t i = 0; i < count; ++i) src[i] = static_cast<T>(i * 2654435761u);
+    std::vector<T> dst(count);
+
+    std::printf("%s (%zu elements)\n", label, count);
+
+    double copy = timeIt(kIterations, [&] {
+        std::memcpy(dst.data(), src.data(), kBytes);
+        doNotOptimize(dst.data());
+    });
+    report("memcpy", copy, kIterations, kBytes);
+
+    double scalar = timeIt(kIterations, [&] {
+        byte_swap_copy_scalar(dst.data(), src.data(), count, sizeof(T));
+        doNotOptimize(dst.data());
+    });
+    report("scalar byteswap", scalar, kIterations, kBytes);
+
+    double simd = timeIt(kIterations, [&] {
+        byte_swap_copy(dst.data(), src.data(), count, sizeof(T));
+        doNotOptimize(dst.data());
+    });
+    report("byte_swap_copy", simd, kIterations, kBytes);
+
+    DataBuffer host(kBytes + 64);
+    double hostEncode = timeIt(kIterations, [&] {
+        host.clear();
+        host << src;
+        doNotOptimize(host.data());
+    });
+    report("DataBuffer << vector (host)", hostEncode, kIterations, kBytes);
+
+    DataBuffer big(kBytes + 64);
+    big.setByteOrder(DataBuffer::ByteOrder::Big);
+    double bigEncode = timeIt(kIterations, [&] {
+        big.clear();
+        big << src;
+        doNotOptimize(big.data());
+    });
+    report("DataBuffer << vector (big endian)", bigEncode, kIterations, kBytes);
+}
+
+}
+
+int main() {
+    std::printf("Byte swap kernel: %s, %zu KiB per iteration\n", byte_swap_kernel(), kBytes / 1024);
+    runWidth<uint16_t>("uint16_t");
+    runWidth<uint32_t>("uint32_t");
+    runWidth<uint64_t>("uint64_t");
+    return 0;
+}
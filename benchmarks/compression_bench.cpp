@@ -0,0 +1,72 @@
+#include "bench_utils.hpp"
+#include "networking/compression.hpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Ratio and throughput of the frame compressor on payloads shaped like the
+// ones we ship: a binary entity state dump, a text telemetry log, and
+// random bytes (the worst case, where frames are sent uncompressed).
+
+namespace {
+
+constexpr size_t kIterations = 200;
+
+std::vector<uint8_t> entityDump() {
+    DataBuffer buf;
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < 8000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        buf << i << float(i % 64) * 2.0f << float((seed >> 16) % 8) << float(0) << uint16_t(100)
+            << uint8_t(i % 3) << std::string(i % 5 ? "npc_guard" : "player");
+    }
+    return std::vector<uint8_t>(buf.data(), buf.data() + buf.size());
+}
+
+std::vector<uint8_t> telemetryLog() {
+    std::string text;
+    for (int i = 0; text.size() < 400000; ++i) {
+        text += "{\"tick\":" + std::to_string(100000 + i) + ",\"cpu\":" + std::to_string(30 + i % 17)
+              + ",\"mem\":" + std::to_string(2048 + (i * 7) % 300) + ",\"status\":\"ok\"}\n";
+    }
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+std::vector<uint8_t> randomBytes() {
+    std::vector<uint8_t> bytes(400000);
+    uint64_t state = 88172645463325252ULL;
+    for (auto& b : bytes) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        b = static_cast<uint8_t>(state);
+    }
+    return bytes;
+}
+
+void run(const char* name, const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> block(lz_compress_bound(input.size()));
+    std::vector<uint8_t> output(input.size());
+    size_t packed = 0;
+
+    double compress = timeIt(kIterations, [&] {
+        packed = lz_compress(input.data(), input.size(), block.data(), block.size());
+        doNotOptimize(packed);
+    });
+    double decompress = timeIt(kIterations, [&] {
+        lz_decompress(block.data(), packed, output.data(), output.size());
+        doNotOptimize(output.data());
+    });
+
+    std::printf("%s: %zu -> %zu bytes (ratio %.2f)\n", name, input.size(), packed,
+                static_cast<double>(input.size()) / static_cast<double>(packed));
+    report("compress", compress, kIterations, input.size());
+    report("decompress", decompress, kIterations, input.size());
+}
+
+}
+
+int main() {
+    run("entity state dump", entityDump());
+    run("text telemetry log", telemetryLog());
+    run("random bytes", randomBytes());
+    return 0;
+}
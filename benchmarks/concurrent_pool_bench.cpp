@@ -0,0 +1,76 @@
+#include "bench_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "data_structures/concurrent_pool.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// Acquire/release throughput with 1..8 threads sharing one pool: a Pool
+// behind a std::mutex versus the lock-free ConcurrentPool. Each thread
+// holds a few objects at a time, as a server handler would.
+
+namespace {
+
+constexpr size_t kOpsPerThread = 400000;
+constexpr size_t kBatch = 4;
+
+struct Job {
+    uint64_t id;
+    uint64_t payload[7];
+};
+
+template<typename Body>
+double runThreads(size_t threads, Body body) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) workers.emplace_back(body);
+    for (auto& w : workers) w.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main() {
+    std::printf("Pool acquire/release, %zu ops per thread, hardware threads: %u\n",
+                kOpsPerThread, std::thread::hardware_concurrency());
+
+    for (size_t threads : {1, 2, 4, 8}) {
+        std::printf("%zu thread(s)\n", threads);
+        const size_t total = threads * kOpsPerThread;
+
+        Pool<Job> locked;
+        locked.resize(threads * kBatch);
+        std::mutex lock;
+        double mutexTime = runThreads(threads, [&] {
+            Pool<Job>::Object* held[kBatch];
+            for (size_t i = 0; i < kOpsPerThread; i += kBatch) {
+                for (size_t k = 0; k < kBatch; ++k) {
+                    std::lock_guard<std::mutex> lg(lock);
+                    held[k] = &locked.acquire(Job{i + k, {}});
+                }
+                for (size_t k = 0; k < kBatch; ++k) {
+                    doNotOptimize(held[k]->object->id);
+                    std::lock_guard<std::mutex> lg(lock);
+                    locked.release(*held[k]);
+                }
+            }
+        });
+        report("mutex + Pool", mutexTime, total, sizeof(Job));
+
+        ConcurrentPool<Job> lockFree;
+        lockFree.resize(threads * kBatch);
+        double lockFreeTime = runThreads(threads, [&] {
+            ConcurrentPool<Job>::Object* held[kBatch];
+            for (size_t i = 0; i < kOpsPerThread; i += kBatch) {
+                for (size_t k = 0; k < kBatch; ++k) held[k] = &lockFree.acquire(Job{i + k, {}});
+                for (size_t k = 0; k < kBatch; ++k) {
+                    doNotOptimize(held[k]->object->id);
+                    lockFree.release(*held[k]);
+                }
+            }
+        });
+        report("ConcurrentPool", lockFreeTime, total, sizeof(Job));
+    }
+    return 0;
+}
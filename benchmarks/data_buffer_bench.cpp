@@ -0,0 +1,100 @@
+#include "bench_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <vector>
+#include <cstdint>
+
+// Compares the append engine against the previous operator<< implementation,
+// which called std::vector::resize() (value-initializing new bytes) on every
+// write. Each iteration serializes one 64-field record into a fresh buffer.
+
+namespace {
+
+constexpr size_t kFields = 64;
+constexpr size_t kIterations = 200000;
+
+// Copy of the former DataBuffer write path, kept here as the baseline.
+struct LegacyBuffer {
+    std::vector<uint8_t> bytes;
+    size_t size = 0;
+
+    template<typename T>
+    LegacyBuffer& operator<<(const T& value) {
+        bytes.resize(size + sizeof(T));
+        std::memcpy(bytes.data() + size, &value, sizeof(T));
+        size += sizeof(T);
+        return *this;
+    }
+};
+
+struct Record {
+    uint32_t fields[kFields];
+};
+
+}
+
+int main() {
+    Record rec;
+    for (size_t i = 0; i < kFields; ++i) rec.fields[i] = static_cast<uint32_t>(i * 2654435761u);
+    const size_t bytes = sizeof(rec);
+
+    std::printf("DataBuffer: %zu-field record, %zu iterations\n", kFields, kIterations);
+
+    double legacy = timeIt(kIterations, [&] {
+        LegacyBuffer buf;
+        for (size_t i = 0; i < kFields; ++i) buf << rec.fields[i];
+        doNotOptimize(buf.bytes.data());
+    });
+    report("legacy resize-per-write <<", legacy, kIterations, bytes);
+
+    double chained = timeIt(kIterations, [&] {
+        DataBuffer buf;
+        for (size_t i = 0; i < kFields; ++i) buf << rec.fields[i];
+        doNotOptimize(buf.data());
+    });
+    report("DataBuffer <<", chained, kIterations, bytes);
+
+    double reserved = timeIt(kIterations, [&] {
+        DataBuffer buf(bytes);
+        for (size_t i = 0; i < kFields; ++i) buf << rec.fields[i];
+        doNotOptimize(buf.data());
+    });
+    report("DataBuffer reserve + <<", reserved, kIterations, bytes);
+
+    double appended = timeIt(kIterations, [&] {
+        DataBuffer buf;
+        buf.append(rec.fields[0], rec.fields[1], rec.fields[2], rec.fields[3],
+                   rec.fields[4], rec.fields[5], rec.fields[6], rec.fields[7]);
+        for (size_t i = 8; i < kFields; i += 8) {
+            buf.append(rec.fields[i], rec.fields[i + 1], rec.fields[i + 2], rec.fields[i + 3],
+                       rec.fields[i + 4], rec.fields[i + 5], rec.fields[i + 6], rec.fields[i + 7]);
+        }
+        doNotOptimize(buf.data());
+    });
+    report("DataBuffer append(8 fields)", appended, kIterations, bytes);
+
+    double bulk = timeIt(kIterations, [&] {
+        DataBuffer buf;
+        buf.write(&rec, sizeof(rec));
+        doNotOptimize(buf.data());
+    });
+    report("DataBuffer write(record)", bulk, kIterations, bytes);
+
+    // Reuse: the hot loop in message building clears and refills one buffer.
+    DataBuffer reused;
+    double refill = timeIt(kIterations, [&] {
+        reused.clear();
+        for (size_t i = 0; i < kFields; ++i) reused << rec.fields[i];
+        doNotOptimize(reused.data());
+    });
+    report("DataBuffer clear + << (reused)", refill, kIterations, bytes);
+
+    LegacyBuffer legacyReused;
+    double legacyRefill = timeIt(kIterations, [&] {
+        legacyReused.size = 0;
+        for (size_t i = 0; i < kFields; ++i) legacyReused << rec.fields[i];
+        doNotOptimize(legacyReused.bytes.data());
+    });
+    report("legacy clear + << (reused)", legacyRefill, kIterations, bytes);
+
+    return 0;
+}
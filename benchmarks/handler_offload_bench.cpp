@@ -0,0 +1,109 @@
+#include "bench_utils.hpp"
+#include "networking/server.hpp"
+#include "networking/socket_io.hpp"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Round-trip time of a client with a trivial handler while another client
+// keeps requests whose handler blocks for kSlowHandler in flight. Inline
+// dispatch makes the fast client wait behind every slow handler; with
+// handler threads only the slow client's strand waits.
+
+namespace {
+
+constexpr size_t kPings = 200;
+constexpr size_t kSlowInFlight = 4;
+constexpr auto kSlowHandler = std::chrono::milliseconds(2);
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+bool read_exact(int fd, void* out, size_t n) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    while (n > 0) {
+        ssize_t r = ::recv(fd, p, n, 0);
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+void run(const char* label, size_t handlerThreads) {
+    Server server;
+    if (handlerThreads > 0) server.setHandlerThreads(handlerThreads);
+    server.defineAction(1, [&server](Server::ClientID id, const Message&) {
+        std::this_thread::sleep_for(kSlowHandler);
+        server.sendTo(Message(2), id);
+    });
+    server.defineAction(3, [&server](Server::ClientID id, const Message&) {
+        server.sendTo(Message(4), id);
+    });
+    server.start(0);
+    const uint16_t port = static_cast<uint16_t>(server.getPort());
+
+    int slow = connect_loopback(port);
+    int fast = connect_loopback(port);
+    if (slow < 0 || fast < 0) return;
+
+    // Keep kSlowInFlight slow requests queued until the pings are done
+    std::atomic<bool> done{false};
+    std::thread slowClient([&] {
+        uint8_t request[FRAME_HEADER_SIZE];
+        uint8_t reply[FRAME_HEADER_SIZE];
+        encode_frame_header(request, 1, 0);
+        for (size_t i = 0; i < kSlowInFlight; ++i) {
+            if (::send(slow, request, sizeof(request), MSG_NOSIGNAL) < 0) return;
+        }
+        while (!done.load()) {
+            if (!read_exact(slow, reply, sizeof(reply))) return;
+            if (::send(slow, request, sizeof(request), MSG_NOSIGNAL) < 0) return;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    uint8_t ping[FRAME_HEADER_SIZE];
+    uint8_t pong[FRAME_HEADER_SIZE];
+    encode_frame_header(ping, 3, 0);
+    double seconds = timeIt(kPings, [&] {
+        if (::send(fast, ping, sizeof(ping), MSG_NOSIGNAL) < 0) return;
+        read_exact(fast, pong, sizeof(pong));
+    });
+    report(label, seconds, kPings, 0);
+
+    done = true;
+    ::shutdown(slow, SHUT_RDWR);
+    slowClient.join();
+    ::close(slow);
+    ::close(fast);
+    server.stop();
+}
+
+}
+
+int main() {
+    std::printf("Fast client round trip while a neighbour's handler sleeps %lld ms (ns/op = per ping)\n",
+                static_cast<long long>(kSlowHandler.count()));
+    run("inline handlers", 0);
+    run("4 handler threads", 4);
+    return 0;
+}
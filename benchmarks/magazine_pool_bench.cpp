@@ -0,0 +1,92 @@
+#include "bench_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "data_structures/concurrent_pool.hpp"
+#include "data_structures/magazine_pool.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// Per-message object churn: each thread acquires a few objects and releases
+// them, through a mutex-wrapped Pool, the lock-free ConcurrentPool and a
+// per-thread MagazinePool cache.
+
+namespace {
+
+constexpr size_t kOpsPerThread = 1000000;
+constexpr size_t kBatch = 4;
+
+struct Msg {
+    uint64_t id;
+    uint64_t body[7];
+};
+
+template<typename Body>
+double runThreads(size_t threads, Body body) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) workers.emplace_back(body);
+    for (auto& w : workers) w.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main() {
+    std::printf("Acquire/release churn, %zu ops per thread, hardware threads: %u\n",
+                kOpsPerThread, std::thread::hardware_concurrency());
+
+    for (size_t threads : {1, 2, 4}) {
+        std::printf("%zu thread(s)\n", threads);
+        const size_t total = threads * kOpsPerThread;
+
+        Pool<Msg> locked;
+        locked.resize(threads * kBatch);
+        std::mutex lock;
+        double mutexTime = runThreads(threads, [&] {
+            Pool<Msg>::Object* held[kBatch];
+            for (size_t i = 0; i < kOpsPerThread; i += kBatch) {
+                for (size_t k = 0; k < kBatch; ++k) {
+                    std::lock_guard<std::mutex> lg(lock);
+                    held[k] = &locked.acquire(Msg{i + k, {}});
+                }
+                for (size_t k = 0; k < kBatch; ++k) {
+                    doNotOptimize(held[k]->object->id);
+                    std::lock_guard<std::mutex> lg(lock);
+                    locked.release(*held[k]);
+                }
+            }
+        });
+        report("mutex + Pool", mutexTime, total, sizeof(Msg));
+
+        ConcurrentPool<Msg> lockFree;
+        lockFree.resize(threads * kBatch);
+        double lockFreeTime = runThreads(threads, [&] {
+            ConcurrentPool<Msg>::Object* held[kBatch];
+            for (size_t i = 0; i < kOpsPerThread; i += kBatch) {
+                for (size_t k = 0; k < kBatch; ++k) held[k] = &lockFree.acquire(Msg{i + k, {}});
+                for (size_t k = 0; k < kBatch; ++k) {
+                    doNotOptimize(held[k]->object->id);
+                    lockFree.release(*held[k]);
+                }
+            }
+        });
+        report("ConcurrentPool", lockFreeTime, total, sizeof(Msg));
+
+        MagazinePool<Msg> magazines;
+        magazines.resize(threads * (2 * MagazinePool<Msg>::DEFAULT_MAGAZINE_SIZE + kBatch));
+        double magazineTime = runThreads(threads, [&] {
+            MagazinePool<Msg>::Cache cache(magazines);
+            MagazinePool<Msg>::Object* held[kBatch];
+            for (size_t i = 0; i < kOpsPerThread; i += kBatch) {
+                for (size_t k = 0; k < kBatch; ++k) held[k] = &cache.acquire(Msg{i + k, {}});
+                for (size_t k = 0; k < kBatch; ++k) {
+                    doNotOptimize(held[k]->object->id);
+                    cache.release(*held[k]);
+                }
+            }
+        });
+        report("MagazinePool cache", magazineTime, total, sizeof(Msg));
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "bench_utils.hpp"
+#include "data_structures/memory_resource.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <memory_resource>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Per-message temporaries (a few small vectors and strings plus a scratch
+// DataBuffer), allocated from the global heap, a SizeClassResource and a
+// FrameArena reset once per message.
+
+namespace {
+
+constexpr size_t kMessages = 100000;
+
+void buildTemporaries(std::pmr::memory_resource* resource, const std::vector<uint8_t>& blob) {
+    std::pmr::vector<std::pmr::string> fields(resource);
+    for (int i = 0; i < 8; ++i) {
+        fields.emplace_back("field value long enough to need the heap");
+    }
+    std::pmr::vector<uint32_t> ids(resource);
+    for (uint32_t i = 0; i < 64; ++i) ids.push_back(i);
+    DataBuffer scratch(resource);
+    scratch.write(blob.data(), blob.size());
+    doNotOptimize(fields.back().data());
+    doNotOptimize(ids.back());
+    doNotOptimize(scratch.data());
+}
+
+}
+
+int main() {
+    std::printf("Per-message temporaries, %zu messages\n", kMessages);
+    std::vector<uint8_t> blob(512, 0x42);
+
+    double heap = timeIt(kMessages, [&] {
+        buildTemporaries(std::pmr::new_delete_resource(), blob);
+    });
+    report("global heap", heap, kMessages, blob.size());
+
+    SizeClassResource classes;
+    double pooled = timeIt(kMessages, [&] {
+        buildTemporaries(&classes, blob);
+    });
+    report("SizeClassResource", pooled, kMessages, blob.size());
+
+    FrameArena frame;
+    double arena = timeIt(kMessages, [&] {
+        buildTemporaries(&frame, blob);
+        frame.reset();
+    });
+    report("FrameArena + reset", arena, kMessages, blob.size());
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "bench_utils.hpp"
+#include "networking/server.hpp"
+#include "networking/socket_io.hpp"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Broadcast to kReaders clients that keep up plus one that never reads.
+// Sends only queue and wake the loop, so the broadcasting thread does not
+// pay the socket writes, and the stalled client's backlog waits in its
+// outbound queue instead of blocking the sender or being disconnected.
+// The watermarks are raised so that no reader is dropped mid-run.
+
+namespace {
+
+constexpr size_t kReaders = 16;
+constexpr size_t kBroadcasts = 20000;
+constexpr size_t kPayload = 512;
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool read_exact(int fd, void* out, size_t n) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    while (n > 0) {
+        ssize_t r = ::recv(fd, p, n, 0);
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+}
+
+int main() {
+    Server server;
+    server.setOutboundWatermarks(64 * 1024 * 1024, 16 * 1024 * 1024);
+    server.start(0);
+    const uint16_t port = static_cast<uint16_t>(server.getPort());
+
+    std::vector<int> readers;
+    for (size_t i = 0; i < kReaders; ++i) readers.push_back(connect_loopback(port));
+    int stalled = connect_loopback(port);
+    while (server.clientCount() < kReaders + 1) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // One thread per reader so a slow recv on one does not hold up the others
+    std::vector<std::thread> threads;
+    for (int fd : readers) {
+        threads.emplace_back([fd] {
+            std::vector<uint8_t> frame(FRAME_HEADER_SIZE + kPayload);
+            for (size_t i = 0; i < kBroadcasts; ++i) {
+                if (!read_exact(fd, frame.data(), frame.size())) return;
+            }
+        });
+    }
+
+    Message message(1);
+    std::vector<uint8_t> payload(kPayload, 0x42);
+    message.payload().write(payload.data(), payload.size());
+
+    std::printf("Broadcast to %zu readers + 1 stalled client, %zu-byte payload\n", kReaders, kPayload);
+    auto start = std::chrono::steady_clock::now();
+    double sending = timeIt(kBroadcasts, [&] { server.sendToAll(message); });
+    for (auto& t : threads) t.join();
+    double delivered = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report("sendToAll (caller side)", sending, kBroadcasts, kPayload * (kReaders + 1));
+    report("sendToAll (until delivered)", delivered, kBroadcasts, kPayload * kReaders);
+    std::printf("  stalled client: %zu bytes queued, still connected: %s\n",
+                server.queuedBytes(kReaders + 1), server.clientCount() == kReaders + 1 ? "yes" : "no");
+
+    for (int fd : readers) ::close(fd);
+    ::close(stalled);
+    server.stop();
+    return 0;
+}
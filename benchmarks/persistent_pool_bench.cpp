@@ -0,0 +1,62 @@
+#include "bench_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "data_structures/persistent_pool.hpp"
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+
+// Startup cost for N records: rebuilding them in a fresh Pool versus
+// reopening a PersistentPool file that already holds them and walking the
+// live set once.
+
+namespace {
+
+constexpr size_t kRecords = 1000000;
+constexpr size_t kRuns = 5;
+
+struct Record {
+    uint64_t id;
+    uint64_t flags;
+    double balance;
+    char name[40];
+};
+
+Record makeRecord(uint64_t i) {
+    Record r{i, i * 2654435761u, static_cast<double>(i) * 0.5, {}};
+    const std::string name = "account-" + std::to_string(i);
+    name.copy(r.name, sizeof(r.name) - 1);
+    return r;
+}
+
+}
+
+int main() {
+    std::printf("Startup with %zu live records\n", kRecords);
+    const std::string path = "/tmp/libftpp_persistent_pool_bench_" + std::to_string(::getpid()) + ".pool";
+    ::unlink(path.c_str());
+    {
+        PersistentPool<Record> seed;
+        seed.open(path, kRecords);
+        for (uint64_t i = 0; i < kRecords; ++i) seed.acquire(makeRecord(i));
+    }
+
+    double rebuild = timeIt(kRuns, [] {
+        Pool<Record> pool;
+        pool.resize(kRecords);
+        for (uint64_t i = 0; i < kRecords; ++i) pool.acquire(makeRecord(i));
+        doNotOptimize(pool.usedCount());
+    });
+    report("rebuild in Pool", rebuild, kRuns * kRecords, sizeof(Record));
+
+    double reopen = timeIt(kRuns, [&] {
+        PersistentPool<Record> pool;
+        pool.open(path, kRecords);
+        uint64_t sum = 0;
+        pool.forEach([&](size_t, Record& r) { sum += r.id; });
+        doNotOptimize(sum);
+    });
+    report("reopen PersistentPool + walk", reopen, kRuns * kRecords, sizeof(Record));
+
+    ::unlink(path.c_str());
+    return 0;
+}
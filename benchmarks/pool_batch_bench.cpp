@@ -0,0 +1,60 @@
+#include "bench_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "data_structures/concurrent_pool.hpp"
+#include <vector>
+#include <cstdint>
+
+// A frame tick that needs kBatch objects: kBatch acquire()/release() calls
+// versus one acquireN()/releaseN() pair, for Pool and ConcurrentPool.
+
+namespace {
+
+constexpr size_t kTicks = 200000;
+constexpr size_t kBatch = 32;
+
+struct Event {
+    uint64_t id;
+    uint64_t body[3];
+};
+
+}
+
+int main() {
+    std::printf("Pool batches of %zu objects, %zu ticks\n", kBatch, kTicks);
+    const size_t ops = kTicks * kBatch;
+
+    Pool<Event> pool;
+    pool.resize(kBatch);
+    std::vector<Pool<Event>::Object*> held(kBatch);
+    double single = timeIt(kTicks, [&] {
+        for (size_t i = 0; i < kBatch; ++i) held[i] = &pool.acquire(Event{i, {}});
+        doNotOptimize(held[kBatch - 1]->object->id);
+        for (size_t i = 0; i < kBatch; ++i) pool.release(*held[i]);
+    });
+    report("Pool acquire/release", single, ops, sizeof(Event));
+
+    double batched = timeIt(kTicks, [&] {
+        pool.acquireN(held, [](size_t i) { return Event{i, {}}; });
+        doNotOptimize(held[kBatch - 1]->object->id);
+        pool.releaseN(held);
+    });
+    report("Pool acquireN/releaseN", batched, ops, sizeof(Event));
+
+    ConcurrentPool<Event> shared;
+    shared.resize(kBatch);
+    std::vector<ConcurrentPool<Event>::Object*> sharedHeld(kBatch);
+    double sharedSingle = timeIt(kTicks, [&] {
+        for (size_t i = 0; i < kBatch; ++i) sharedHeld[i] = &shared.acquire(Event{i, {}});
+        doNotOptimize(sharedHeld[kBatch - 1]->object->id);
+        for (size_t i = 0; i < kBatch; ++i) shared.release(*sharedHeld[i]);
+    });
+    report("ConcurrentPool acquire/release", sharedSingle, ops, sizeof(Event));
+
+    double sharedBatched = timeIt(kTicks, [&] {
+        shared.acquireN(sharedHeld, [](size_t i) { return Event{i, {}}; });
+        doNotOptimize(sharedHeld[kBatch - 1]->object->id);
+        shared.releaseN(sharedHeld);
+    });
+    report("ConcurrentPool acquireN/releaseN", sharedBatched, ops, sizeof(Event));
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "bench_utils.hpp"
+#include "data_structures/pool.hpp"
+#include <vector>
+#include <cstdint>
+#include <new>
+
+// Cost of sizing a 1M-slot pool and of touching every slot afterwards, for
+// the former one-operator-new-per-slot layout and the contiguous slab.
+
+namespace {
+
+constexpr size_t kSlots = 1000000;
+
+struct Particle {
+    float x, y, z, vx, vy, vz;
+};
+
+// The former Pool::resize() allocation pattern, kept as the baseline
+struct ScatteredSlots {
+    std::vector<Particle*> slots;
+    explicit ScatteredSlots(size_t n) {
+        slots.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            slots.push_back(static_cast<Particle*>(::operator new(sizeof(Particle), std::align_val_t(alignof(Particle)))));
+        }
+    }
+    ~ScatteredSlots() {
+        for (Particle* p : slots) ::operator delete(p, std::align_val_t(alignof(Particle)));
+    }
+};
+
+}
+
+int main() {
+    std::printf("Pool: %zu slots of %zu bytes\n", kSlots, sizeof(Particle));
+
+    double scatteredResize = timeIt(5, [&] {
+        ScatteredSlots slots(kSlots);
+        doNotOptimize(slots.slots.data());
+    });
+    report("per-slot operator new resize", scatteredResize, 5, kSlots * sizeof(Particle));
+
+    double slabResize = timeIt(5, [&] {
+        Pool<Particle> pool;
+        pool.resize(kSlots);
+        doNotOptimize(pool.capacity());
+    });
+    report("slab resize (heap)", slabResize, 5, kSlots * sizeof(Particle));
+
+    double hugeResize = timeIt(5, [&] {
+        Pool<Particle> pool;
+        pool.resize(kSlots, Pool<Particle>::SlabBacking::HugePages);
+        doNotOptimize(pool.capacity());
+    });
+    report("slab resize (huge pages)", hugeResize, 5, kSlots * sizeof(Particle));
+
+    // Acquire every slot, then sweep them as a simulation step would
+    ScatteredSlots scattered(kSlots);
+    for (Particle* p : scattered.slots) new (p) Particle{1, 2, 3, 0.1f, 0.2f, 0.3f};
+    double scatteredSweep = timeIt(20, [&] {
+        for (Particle* p : scattered.slots) { p->x += p->vx; p->y += p->vy; p->z += p->vz; }
+        doNotOptimize(scattered.slots[0]->x);
+    });
+    report("sweep scattered slots", scatteredSweep, 20, kSlots * sizeof(Particle));
+
+    Pool<Particle> pool;
+    pool.resize(kSlots);
+    std::vector<Particle*> live;
+    live.reserve(kSlots);
+    for (size_t i = 0; i < kSlots; ++i) live.push_back(pool.acquire(Particle{1, 2, 3, 0.1f, 0.2f, 0.3f}).object);
+    double slabSweep = timeIt(20, [&] {
+        for (Particle* p : live) { p->x += p->vx; p->y += p->vy; p->z += p->vz; }
+        doNotOptimize(live[0]->x);
+    });
+    report("sweep slab slots", slabSweep, 20, kSlots * sizeof(Particle));
+    return 0;
+}
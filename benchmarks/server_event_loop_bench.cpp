@@ -0,0 +1,118 @@
+#include "bench_utils.hpp"
+#include "networking/server.hpp"
+#include "networking/socket_io.hpp"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Round-trip latency of one active client while the server also holds
+// 100, 1k and 10k idle connections, for the epoll and poll backends.
+// The idle sockets live in a child process so both ends fit the fd limit.
+
+namespace {
+
+constexpr size_t kRoundTrips = 2000;
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool read_exact(int fd, void* out, size_t n) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    while (n > 0) {
+        ssize_t r = ::recv(fd, p, n, 0);
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+// Child: open `count` connections, report, then hold them until the pipe closes
+void hold_idle_connections(int portPipe, int donePipe, size_t count) {
+    uint16_t port = 0;
+    if (::read(portPipe, &port, sizeof(port)) != sizeof(port)) ::_exit(1);
+    std::vector<int> fds;
+    fds.reserve(count);
+    while (fds.size() < count) {
+        int fd = connect_loopback(port);
+        if (fd >= 0) fds.push_back(fd);
+    }
+    const char ready = 1;
+    if (::write(donePipe, &ready, 1) != 1) ::_exit(1);
+    char byte;
+    while (::read(portPipe, &byte, 1) > 0) {}
+    ::_exit(0);
+}
+
+void run(Poller::Backend backend, const char* name, size_t idle) {
+    int toChild[2];
+    int fromChild[2];
+    if (::pipe(toChild) < 0 || ::pipe(fromChild) < 0) return;
+    pid_t child = ::fork();
+    if (child == 0) {
+        ::close(toChild[1]);
+        ::close(fromChild[0]);
+        hold_idle_connections(toChild[0], fromChild[1], idle);
+    }
+    ::close(toChild[0]);
+    ::close(fromChild[1]);
+
+    Server server;
+    server.setEventBackend(backend);
+    server.defineAction(1, [&server](Server::ClientID id, const Message& m) { server.sendTo(m, id); });
+    server.start(0);
+    const uint16_t port = static_cast<uint16_t>(server.getPort());
+    char ready = 0;
+    if (::write(toChild[1], &port, sizeof(port)) != sizeof(port) || ::read(fromChild[0], &ready, 1) != 1) return;
+
+    int active = connect_loopback(port);
+    int one = 1;
+    ::setsockopt(active, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    while (server.clientCount() < idle + 1) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    uint8_t frame[FRAME_HEADER_SIZE + 8];
+    encode_frame_header(frame, 1, 8);
+    std::memset(frame + FRAME_HEADER_SIZE, 0x5a, 8);
+    uint8_t reply[sizeof(frame)];
+    double seconds = timeIt(kRoundTrips, [&] {
+        if (::send(active, frame, sizeof(frame), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(frame))) return;
+        read_exact(active, reply, sizeof(reply));
+        doNotOptimize(reply[0]);
+    });
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, %zu idle", name, idle);
+    report(label, seconds, kRoundTrips, sizeof(frame));
+
+    ::close(active);
+    ::close(toChild[1]);
+    ::close(fromChild[0]);
+    ::waitpid(child, nullptr, 0);
+    server.stop();
+}
+
+}
+
+int main() {
+    std::printf("Server round trip with idle connections, %zu round trips\n", kRoundTrips);
+    for (size_t idle : {size_t(100), size_t(1000), size_t(10000)}) {
+        run(Poller::Backend::Poll, "poll", idle);
+        run(Poller::Backend::Epoll, "epoll (edge-triggered)", idle);
+    }
+    return 0;
+}
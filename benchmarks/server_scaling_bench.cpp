@@ -0,0 +1,135 @@
+#include "bench_utils.hpp"
+#include "networking/server.hpp"
+#include "networking/socket_io.hpp"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Request throughput with 1..N event loops. Each request carries 2 KiB that
+// the handler hashes before replying, so the loops have CPU work to share.
+// The load comes from a child process: kGeneratorThreads threads, each
+// keeping one request in flight on each of its connections.
+
+namespace {
+
+constexpr size_t kGeneratorThreads = 4;
+constexpr size_t kConnectionsPerThread = 16;
+constexpr size_t kRounds = 200;
+constexpr size_t kPayload = 2048;
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+bool read_exact(int fd, void* out, size_t n) {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    while (n > 0) {
+        ssize_t r = ::recv(fd, p, n, 0);
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+void generate(const std::vector<int>& fds) {
+    std::vector<uint8_t> request(FRAME_HEADER_SIZE + kPayload, 0x33);
+    encode_frame_header(request.data(), 1, kPayload);
+    uint8_t reply[FRAME_HEADER_SIZE + sizeof(uint64_t)];
+    for (size_t round = 0; round < kRounds; ++round) {
+        for (int fd : fds) {
+            if (::send(fd, request.data(), request.size(), MSG_NOSIGNAL) < 0) return;
+        }
+        for (int fd : fds) {
+            if (!read_exact(fd, reply, sizeof(reply))) return;
+        }
+    }
+}
+
+// Child: connect, report ready, wait for the go byte, run the generators
+void load(int fromParent, int toParent) {
+    uint16_t port = 0;
+    if (::read(fromParent, &port, sizeof(port)) != sizeof(port)) ::_exit(1);
+    std::vector<std::vector<int>> fds(kGeneratorThreads);
+    for (auto& group : fds) {
+        for (size_t i = 0; i < kConnectionsPerThread; ++i) group.push_back(connect_loopback(port));
+    }
+    char byte = 1;
+    if (::write(toParent, &byte, 1) != 1 || ::read(fromParent, &byte, 1) != 1) ::_exit(1);
+    std::vector<std::thread> threads;
+    for (auto& group : fds) threads.emplace_back([&group] { generate(group); });
+    for (auto& t : threads) t.join();
+    ::_exit(0);
+}
+
+void run(size_t loops) {
+    int toChild[2];
+    int fromChild[2];
+    if (::pipe(toChild) < 0 || ::pipe(fromChild) < 0) return;
+    pid_t child = ::fork();
+    if (child == 0) {
+        ::close(toChild[1]);
+        ::close(fromChild[0]);
+        load(toChild[0], fromChild[1]);
+    }
+    ::close(toChild[0]);
+    ::close(fromChild[1]);
+
+    Server server;
+    server.setEventLoops(loops);
+    server.defineAction(1, [&server](Server::ClientID id, const Message& m) {
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < m.payload().size(); ++i) {
+            hash = (hash ^ m.payload().data()[i]) * 1099511628211ull;
+        }
+        Message reply(2);
+        reply << hash;
+        server.sendTo(reply, id);
+    });
+    server.start(0);
+    const uint16_t port = static_cast<uint16_t>(server.getPort());
+    char byte = 0;
+    if (::write(toChild[1], &port, sizeof(port)) != sizeof(port) || ::read(fromChild[0], &byte, 1) != 1) return;
+
+    const size_t requests = kGeneratorThreads * kConnectionsPerThread * kRounds;
+    double seconds = timeIt(1, [&] {
+        if (::write(toChild[1], &byte, 1) != 1) return;
+        ::waitpid(child, nullptr, 0);
+    });
+    char label[64];
+    std::snprintf(label, sizeof(label), "%zu event loop(s)", loops);
+    report(label, seconds, requests, kPayload);
+    ::close(toChild[1]);
+    ::close(fromChild[0]);
+    server.stop();
+}
+
+}
+
+int main() {
+    const size_t cores = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    const size_t maxLoops = cores > 4 ? cores : 4;
+    std::printf("Server throughput, %zu connections, %zu cores (ns/op = per request)\n",
+                kGeneratorThreads * kConnectionsPerThread, cores);
+    for (size_t loops = 1; loops <= maxLoops; loops *= 2) {
+        run(loops);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "bench_utils.hpp"
+#include "networking/server.hpp"
+#include "networking/socket_io.hpp"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Receive path of the Server: a raw socket streams pre-encoded frames and
+// an inline handler touches every payload. Reads land in the connection's
+// ring and payloads are handed to the handler in place, so the only copy
+// left is the kernel's; many small frames per read, then large frames
+// that span many reads.
+
+namespace {
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void run(const char* label, size_t payload, size_t frames) {
+    std::vector<uint8_t> stream;
+    stream.reserve(frames * (FRAME_HEADER_SIZE + payload));
+    uint8_t header[FRAME_HEADER_SIZE];
+    encode_frame_header(header, 1, payload);
+    for (size_t i = 0; i < frames; ++i) {
+        stream.insert(stream.end(), header, header + sizeof(header));
+        stream.resize(stream.size() + payload, static_cast<uint8_t>(i));
+    }
+
+    Server server;
+    std::atomic<size_t> received{0};
+    std::atomic<uint64_t> checksum{0};
+    server.defineAction(1, [&](Server::ClientID, const Message& m) {
+        checksum += m.payload().data()[m.payload().size() - 1];
+        ++received;
+    });
+    server.start(0);
+    int fd = connect_loopback(static_cast<uint16_t>(server.getPort()));
+
+    double seconds = timeIt(1, [&] {
+        size_t sent = 0;
+        while (sent < stream.size()) {
+            ssize_t w = ::send(fd, stream.data() + sent, stream.size() - sent, MSG_NOSIGNAL);
+            if (w <= 0) return;
+            sent += static_cast<size_t>(w);
+        }
+        while (received.load() < frames) std::this_thread::yield();
+    });
+    report(label, seconds, frames, payload);
+    ::close(fd);
+    server.stop();
+}
+
+}
+
+int main() {
+    std::printf("Server receive path, frames streamed from a raw socket (ns/op = per frame)\n");
+    run("16-byte frames", 16, 2000000);
+    run("1 KiB frames", 1024, 200000);
+    run("256 KiB frames", 256 * 1024, 400);
+    return 0;
+}
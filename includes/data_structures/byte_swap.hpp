@@ -0,0 +1,72 @@
+#ifndef BYTE_SWAP_HPP
+# define BYTE_SWAP_HPP
+
+# include <bit>
+# include <cstddef>
+# include <cstdint>
+# include <cstring>
+# include <type_traits>
+
+/**
+ * @file byte_swap.hpp
+ * @brief Byte-order conversion helpers used by DataBuffer.
+ *
+ * Scalars are swapped through an unsigned integer of the same width, so
+ * floating-point values never travel through an FP register in swapped
+ * form. Arrays go through byte_swap_copy(), which picks an AVX2 or SSSE3
+ * shuffle kernel at runtime and falls back to a scalar loop elsewhere.
+ */
+
+/** Types that have a byte order: integers, enums and floats of 2, 4 or 8 bytes. */
+template<typename T>
+constexpr bool is_byte_swappable() {
+    return (std::is_integral<T>::value || std::is_enum<T>::value || std::is_floating_point<T>::value)
+        && !std::is_same<T, bool>::value
+        && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+}
+
+namespace byte_swap_detail {
+
+template<size_t Width>
+struct UnsignedOfWidth;
+template<> struct UnsignedOfWidth<2> { using type = uint16_t; };
+template<> struct UnsignedOfWidth<4> { using type = uint32_t; };
+template<> struct UnsignedOfWidth<8> { using type = uint64_t; };
+
+}
+
+/** Store value at out (unaligned) with its bytes reversed. */
+template<typename T>
+inline void store_swapped(uint8_t* out, const T& value) noexcept {
+    static_assert(is_byte_swappable<T>(), "Type has no byte order to swap");
+    typename byte_swap_detail::UnsignedOfWidth<sizeof(T)>::type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    bits = std::byteswap(bits);
+    std::memcpy(out, &bits, sizeof(T));
+}
+
+/** Load a byte-reversed value from in (unaligned). */
+template<typename T>
+inline void load_swapped(T& value, const uint8_t* in) noexcept {
+    static_assert(is_byte_swappable<T>(), "Type has no byte order to swap");
+    typename byte_swap_detail::UnsignedOfWidth<sizeof(T)>::type bits;
+    std::memcpy(&bits, in, sizeof(T));
+    bits = std::byteswap(bits);
+    std::memcpy(&value, &bits, sizeof(T));
+}
+
+/**
+ * @brief Copy `count` elements of `width` bytes (2, 4 or 8), reversing each.
+ *
+ * Neither pointer needs to be aligned. dst may equal src (in-place swap)
+ * but the ranges must not otherwise overlap.
+ */
+void byte_swap_copy(void* dst, const void* src, size_t count, size_t width) noexcept;
+
+/** Scalar reference implementation of byte_swap_copy(). */
+void byte_swap_copy_scalar(void* dst, const void* src, size_t count, size_t width) noexcept;
+
+/** Name of the kernel byte_swap_copy() dispatches to: "avx2", "ssse3" or "scalar". */
+const char* byte_swap_kernel() noexcept;
+
+#endif // BYTE_SWAP_HPP
@@ -0,0 +1,225 @@
+#ifndef CONCURRENT_POOL_HPP
+# define CONCURRENT_POOL_HPP
+
+# include <atomic>
+# include <cstddef>
+# include <cstdint>
+# include <concepts>
+# include <ranges>
+# include <span>
+# include <memory>
+# include <new>
+# include <stdexcept>
+# include <utility>
+
+template <typename TType>
+/**
+ * @brief Thread-safe, lock-free counterpart of Pool.
+ *
+ * Any thread may acquire() and release() concurrently; no mutex is taken.
+ * Free slots form a Treiber stack whose head packs a 32-bit slot index with
+ * a 32-bit generation counter bumped on every update, so a slot popped and
+ * pushed back between a thread's load and its compare-and-swap cannot be
+ * mistaken for an unchanged head (ABA).
+ *
+ * Objects live in one contiguous slab like Pool. The per-slot metadata
+ * (Object) is padded to a cache line, so threads working on neighbouring
+ * slots do not false-share their bookkeeping.
+ *
+ * resize() and clear() are not thread-safe: call them before the pool is
+ * shared or after every user is done.
+ *
+ * @tparam TType type stored in the pool. Can be non-trivial.
+ */
+class ConcurrentPool {
+
+    public:
+        /** Size used to pad per-slot metadata and hot counters. */
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        /**
+         * @brief Per-slot metadata, one cache line each.
+         *
+         * Returned by acquire(); stays owned by the pool.
+         */
+        class alignas(CACHE_LINE_SIZE) Object {
+
+            public:
+                Object() noexcept;
+
+                Object(const Object&) = delete;
+                Object& operator=(const Object&) = delete;
+
+                /** Pointer to the raw memory where TType is constructed. */
+                TType * object;
+
+                /** Index of this slot inside the pool. */
+                uint32_t index;
+
+                /** True when the slot is currently in use (acquired). */
+                bool isInUse() const noexcept;
+
+                /** Access the managed object as a pointer/reference. */
+                TType * operator -> ();
+                const TType * operator -> () const;
+                TType & operator * ();
+                const TType & operator * () const;
+
+            private:
+                friend class ConcurrentPool<TType>;
+
+                // Next free slot while on the free stack
+                std::atomic<uint32_t> next;
+
+                // Set between acquire() and release(); catches double release
+                std::atomic<bool> inUse;
+        };
+
+        /** RAII handle releasing its object on destruction. Move-only. */
+        class Handle {
+        public:
+            Handle() noexcept;
+            ~Handle();
+
+            Handle(const Handle&) = delete;
+            Handle& operator=(const Handle&) = delete;
+
+            Handle(Handle&& other) noexcept;
+            Handle& operator=(Handle&& other) noexcept;
+
+            TType* operator->();
+            TType& operator*();
+
+            void release() noexcept;
+
+            bool valid() const noexcept;
+
+        private:
+            friend class ConcurrentPool<TType>;
+            ConcurrentPool<TType>* pool;
+            Object* obj;
+            explicit Handle(ConcurrentPool<TType>* p_pool, Object* p_obj) noexcept;
+        };
+
+        ConcurrentPool() noexcept;
+        ~ConcurrentPool() noexcept;
+
+        ConcurrentPool(const ConcurrentPool&) = delete;
+        ConcurrentPool& operator=(const ConcurrentPool&) = delete;
+
+        /**
+         * @brief Resize the pool to hold exactly numberOfObjectsStored slots.
+         *
+         * Existing storage is cleared. Not thread-safe. Throws
+         * std::invalid_argument if the size is zero or does not fit the
+         * 32-bit slot index.
+         */
+        void resize(const size_t& numberOfObjectsStored);
+
+        /**
+         * @brief Pop a free slot and construct a TType in it.
+         * @throws std::runtime_error if the pool is exhausted; whatever
+         *         TType's constructor throws (the slot is returned).
+         */
+        template<typename ... TArgs>
+        Object& acquire(TArgs&& ... p_args);
+
+        /** Non-throwing acquire(): nullptr if exhausted or if construction throws. */
+        template<typename ... TArgs>
+        Object* try_acquire(TArgs&& ... p_args) noexcept;
+
+        /** acquire() wrapped in an RAII Handle. */
+        template<typename ... TArgs>
+        Handle acquireHandle(TArgs&& ... p_args);
+
+        /**
+         * @brief Destroy the object and push its slot back on the free stack.
+         * @throws std::invalid_argument if the object is not from this pool,
+         *         std::runtime_error on double release.
+         */
+        void release(Object& p_object);
+
+        /**
+         * @brief Acquire out.size() objects with a single compare-and-swap.
+         *
+         * The batch is unlinked from the free stack in one step and object
+         * i is constructed from p_generator(i). Strong guarantee: throws
+         * std::runtime_error if fewer slots are free, and if a constructor
+         * throws the objects built so far are destroyed and the whole
+         * batch is pushed back (again with one CAS).
+         */
+        template<typename Generator>
+            requires std::invocable<Generator&, size_t>
+        void acquireN(std::span<Object*> out, Generator&& p_generator);
+
+        /** Same, constructing from the elements of a range (std::invalid_argument if shorter). */
+        template<std::ranges::input_range Range>
+        void acquireN(std::span<Object*> out, Range&& p_values);
+
+        /** Same, default-constructing each object. */
+        void acquireN(std::span<Object*> out);
+
+        /**
+         * @brief Release a batch of objects with a single compare-and-swap.
+         *
+         * Every object is checked first; a foreign, unacquired or repeated
+         * object throws like release() and nothing is released.
+         */
+        void releaseN(std::span<Object* const> p_objects);
+
+        /** Number of free slots (a snapshot while other threads run). */
+        size_t availableCount() const noexcept;
+
+        /** Number of slots currently in use (a snapshot while other threads run). */
+        size_t usedCount() const noexcept;
+
+        /** Total capacity. */
+        size_t capacity() const noexcept;
+
+        /** Destroy constructed objects and free memory. Not thread-safe. */
+        void clear() noexcept;
+
+    private:
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+
+        static uint64_t pack(uint32_t generation, uint32_t index) noexcept {
+            return (static_cast<uint64_t>(generation) << 32) | index;
+        }
+        static uint32_t indexOf(uint64_t head) noexcept { return static_cast<uint32_t>(head); }
+        static uint32_t generationOf(uint64_t head) noexcept { return static_cast<uint32_t>(head >> 32); }
+
+        /** Pop a free slot, nullptr if none. */
+        Object* pop() noexcept;
+
+        /** Push a slot back on the free stack. */
+        void push(Object& p_object) noexcept;
+
+        /** Unlink `count` free slots at once, chained through next; nullptr if fewer are free. */
+        Object* popChain(size_t count) noexcept;
+
+        /** Push `count` slots already chained from first to last, with one CAS. */
+        void pushChain(Object& first, Object& last, size_t count) noexcept;
+
+        /** Shared body of the acquireN() overloads (p_construct(TType*, i) builds object i). */
+        template<typename Construct>
+        void acquireBatch(std::span<Object*> out, Construct&& p_construct);
+
+        static constexpr size_t slabAlignment() noexcept {
+            return alignof(TType) > CACHE_LINE_SIZE ? alignof(TType) : CACHE_LINE_SIZE;
+        }
+
+        // Free stack head: generation in the high half, slot index in the low half
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head;
+
+        // Free slot count, on its own line so it does not slow down the head CAS
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> freeCount;
+
+        // Read-mostly layout data
+        alignas(CACHE_LINE_SIZE) Object* slots = nullptr;
+        unsigned char* slab = nullptr;
+        size_t slotCount = 0;
+};
+
+# include "concurrent_pool.tpp"
+
+#endif // CONCURRENT_POOL_HPP
@@ -0,0 +1,375 @@
+// ConcurrentPool implementation (included from concurrent_pool.hpp)
+
+template <typename TType>
+ConcurrentPool<TType>::Object::Object() noexcept
+    : object(nullptr), index(0), next(EMPTY), inUse(false) {}
+
+template <typename TType>
+bool ConcurrentPool<TType>::Object::isInUse() const noexcept {
+    return inUse.load(std::memory_order_acquire);
+}
+
+template <typename TType>
+TType * ConcurrentPool<TType>::Object::operator -> () { return object; }
+
+template <typename TType>
+const TType * ConcurrentPool<TType>::Object::operator -> () const { return object; }
+
+template <typename TType>
+TType & ConcurrentPool<TType>::Object::operator * () { return *object; }
+
+template <typename TType>
+const TType & ConcurrentPool<TType>::Object::operator * () const { return *object; }
+
+template <typename TType>
+ConcurrentPool<TType>::ConcurrentPool() noexcept
+    : head(pack(0, EMPTY)), freeCount(0) {}
+
+template <typename TType>
+ConcurrentPool<TType>::~ConcurrentPool() noexcept {
+    clear();
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::resize(const size_t& numberOfObjectsStored) {
+    if (numberOfObjectsStored == 0) {
+        throw std::invalid_argument("Pool size must be greater than 0");
+    }
+    if (numberOfObjectsStored >= EMPTY) {
+        throw std::invalid_argument("ConcurrentPool size must fit a 32-bit index");
+    }
+
+    // Allocate both blocks before touching the current state
+    std::unique_ptr<Object[]> newSlots(new Object[numberOfObjectsStored]);
+    unsigned char* newSlab = static_cast<unsigned char*>(
+        ::operator new(numberOfObjectsStored * sizeof(TType), std::align_val_t(slabAlignment())));
+
+    clear();
+    slots = newSlots.release();
+    slab = newSlab;
+    slotCount = numberOfObjectsStored;
+
+    // Chain every slot: 0 -> 1 -> ... -> n-1, so slots come out in address order
+    for (size_t i = 0; i < slotCount; ++i) {
+        slots[i].object = reinterpret_cast<TType*>(slab + i * sizeof(TType));
+        slots[i].index = static_cast<uint32_t>(i);
+        slots[i].next.store(i + 1 < slotCount ? static_cast<uint32_t>(i + 1) : EMPTY, std::memory_order_relaxed);
+    }
+    freeCount.store(slotCount, std::memory_order_relaxed);
+    head.store(pack(0, 0), std::memory_order_release);
+}
+
+template <typename TType>
+typename ConcurrentPool<TType>::Object* ConcurrentPool<TType>::pop() noexcept {
+    uint64_t current = head.load(std::memory_order_acquire);
+    while (true) {
+        const uint32_t index = indexOf(current);
+        if (index == EMPTY) {
+            return nullptr;
+        }
+        // May be stale if another thread pops this slot first; the
+        // generation makes the CAS below fail in that case
+        const uint32_t next = slots[index].next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(current, pack(generationOf(current) + 1, next),
+                                       std::memory_order_acq_rel, std::memory_order_acquire)) {
+            freeCount.fetch_sub(1, std::memory_order_relaxed);
+            return &slots[index];
+        }
+    }
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::push(Object& p_object) noexcept {
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+    uint64_t current = head.load(std::memory_order_relaxed);
+    while (true) {
+        p_object.next.store(indexOf(current), std::memory_order_relaxed);
+        if (head.compare_exchange_weak(current, pack(generationOf(current) + 1, p_object.index),
+                                       std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+template <typename TType>
+typename ConcurrentPool<TType>::Object* ConcurrentPool<TType>::popChain(size_t count) noexcept {
+    uint64_t current = head.load(std::memory_order_acquire);
+    while (true) {
+        // Walk to the count-th free slot; a stale walk is caught by the CAS
+        const uint32_t first = indexOf(current);
+        uint32_t last = first;
+        for (size_t i = 1; i < count && last != EMPTY; ++i) {
+            last = slots[last].next.load(std::memory_order_relaxed);
+        }
+        if (last == EMPTY) {
+            // Only trust the shortage if the stack did not move meanwhile
+            const uint64_t again = head.load(std::memory_order_acquire);
+            if (again == current) {
+                return nullptr;
+            }
+            current = again;
+            continue;
+        }
+        const uint32_t rest = slots[last].next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(current, pack(generationOf(current) + 1, rest),
+                                       std::memory_order_acq_rel, std::memory_order_acquire)) {
+            freeCount.fetch_sub(count, std::memory_order_relaxed);
+            return &slots[first];
+        }
+    }
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::pushChain(Object& first, Object& last, size_t count) noexcept {
+    freeCount.fetch_add(count, std::memory_order_relaxed);
+    uint64_t current = head.load(std::memory_order_relaxed);
+    while (true) {
+        last.next.store(indexOf(current), std::memory_order_relaxed);
+        if (head.compare_exchange_weak(current, pack(generationOf(current) + 1, first.index),
+                                       std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+template <typename TType>
+template<typename Construct>
+void ConcurrentPool<TType>::acquireBatch(std::span<Object*> out, Construct&& p_construct) {
+    const size_t count = out.size();
+    if (count == 0) {
+        return;
+    }
+    Object* first = popChain(count);
+    if (!first) {
+        throw std::runtime_error("Not enough available objects in the pool");
+    }
+    // The chain is private now: its links can be read without racing
+    Object* objPtr = first;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = objPtr;
+        if (i + 1 < count) {
+            objPtr = &slots[objPtr->next.load(std::memory_order_relaxed)];
+        }
+    }
+    size_t built = 0;
+    try {
+        for (; built < count; ++built) {
+            p_construct(out[built]->object, built);
+        }
+    } catch (...) {
+        while (built > 0) {
+            out[--built]->object->~TType();
+        }
+        // The links are untouched, so the batch goes back as one chain
+        pushChain(*first, *out[count - 1], count);
+        throw;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        out[i]->inUse.store(true, std::memory_order_release);
+    }
+}
+
+template <typename TType>
+template<typename Generator>
+    requires std::invocable<Generator&, size_t>
+void ConcurrentPool<TType>::acquireN(std::span<Object*> out, Generator&& p_generator) {
+    acquireBatch(out, [&](TType* memory, size_t i) {
+        new (memory) TType(p_generator(i));
+    });
+}
+
+template <typename TType>
+template<std::ranges::input_range Range>
+void ConcurrentPool<TType>::acquireN(std::span<Object*> out, Range&& p_values) {
+    auto it = std::ranges::begin(p_values);
+    auto end = std::ranges::end(p_values);
+    acquireBatch(out, [&](TType* memory, size_t) {
+        if (it == end) {
+            throw std::invalid_argument("Range is shorter than the batch");
+        }
+        new (memory) TType(*it);
+        ++it;
+    });
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::acquireN(std::span<Object*> out) {
+    acquireBatch(out, [](TType* memory, size_t) {
+        new (memory) TType();
+    });
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::releaseN(std::span<Object* const> p_objects) {
+    const size_t count = p_objects.size();
+    if (count == 0) {
+        return;
+    }
+    // Claiming inUse while validating also catches an object listed twice
+    for (size_t i = 0; i < count; ++i) {
+        Object* objPtr = p_objects[i];
+        const bool foreign = !objPtr || objPtr->index >= slotCount || &slots[objPtr->index] != objPtr;
+        if (foreign || !objPtr->inUse.exchange(false, std::memory_order_acq_rel)) {
+            for (size_t k = 0; k < i; ++k) {
+                p_objects[k]->inUse.store(true, std::memory_order_release);
+            }
+            if (foreign) {
+                throw std::invalid_argument("Attempting to release an object that does not belong to this pool");
+            }
+            throw std::runtime_error("Double release detected or object not acquired");
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        p_objects[i]->object->~TType();
+        if (i + 1 < count) {
+            p_objects[i]->next.store(p_objects[i + 1]->index, std::memory_order_relaxed);
+        }
+    }
+    pushChain(*p_objects[0], *p_objects[count - 1], count);
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename ConcurrentPool<TType>::Object& ConcurrentPool<TType>::acquire(TArgs && ... p_args) {
+    Object* objPtr = pop();
+    if (!objPtr) {
+        throw std::runtime_error("No available objects in the pool");
+    }
+    try {
+        new (objPtr->object) TType(std::forward<TArgs>(p_args)...);
+    } catch (...) {
+        push(*objPtr);
+        throw;
+    }
+    objPtr->inUse.store(true, std::memory_order_release);
+    return *objPtr;
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename ConcurrentPool<TType>::Object* ConcurrentPool<TType>::try_acquire(TArgs && ... p_args) noexcept {
+    Object* objPtr = pop();
+    if (!objPtr) {
+        return nullptr;
+    }
+    try {
+        new (objPtr->object) TType(std::forward<TArgs>(p_args)...);
+    } catch (...) {
+        push(*objPtr);
+        return nullptr;
+    }
+    objPtr->inUse.store(true, std::memory_order_release);
+    return objPtr;
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename ConcurrentPool<TType>::Handle ConcurrentPool<TType>::acquireHandle(TArgs && ... p_args) {
+    Object &obj = acquire(std::forward<TArgs>(p_args)...);
+    return Handle(this, &obj);
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::release(Object& p_object) {
+    if (p_object.index >= slotCount || &slots[p_object.index] != &p_object) {
+        throw std::invalid_argument("Attempting to release an object that does not belong to this pool");
+    }
+    if (!p_object.inUse.exchange(false, std::memory_order_acq_rel)) {
+        throw std::runtime_error("Double release detected or object not acquired");
+    }
+    p_object.object->~TType();
+    push(p_object);
+}
+
+template <typename TType>
+size_t ConcurrentPool<TType>::availableCount() const noexcept {
+    return freeCount.load(std::memory_order_relaxed);
+}
+
+template <typename TType>
+size_t ConcurrentPool<TType>::usedCount() const noexcept {
+    // the counter may briefly run ahead of the stack while threads race
+    const size_t available = availableCount();
+    return available < slotCount ? slotCount - available : 0;
+}
+
+template <typename TType>
+size_t ConcurrentPool<TType>::capacity() const noexcept {
+    return slotCount;
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::clear() noexcept {
+    for (size_t i = 0; i < slotCount; ++i) {
+        if (slots[i].inUse.load(std::memory_order_relaxed)) {
+            slots[i].object->~TType();
+            slots[i].inUse.store(false, std::memory_order_relaxed);
+        }
+    }
+    delete[] slots;
+    if (slab) {
+        ::operator delete(static_cast<void*>(slab), std::align_val_t(slabAlignment()));
+    }
+    slots = nullptr;
+    slab = nullptr;
+    slotCount = 0;
+    freeCount.store(0, std::memory_order_relaxed);
+    head.store(pack(0, EMPTY), std::memory_order_relaxed);
+}
+
+// Handle implementation
+template <typename TType>
+ConcurrentPool<TType>::Handle::Handle() noexcept
+    : pool(nullptr), obj(nullptr) {}
+
+template <typename TType>
+ConcurrentPool<TType>::Handle::Handle(ConcurrentPool<TType>* p_pool, Object* p_obj) noexcept
+    : pool(p_pool), obj(p_obj) {}
+
+template <typename TType>
+ConcurrentPool<TType>::Handle::~Handle() {
+    release();
+}
+
+template <typename TType>
+ConcurrentPool<TType>::Handle::Handle(Handle&& other) noexcept
+    : pool(other.pool), obj(other.obj) {
+    other.pool = nullptr;
+    other.obj = nullptr;
+}
+
+template <typename TType>
+typename ConcurrentPool<TType>::Handle& ConcurrentPool<TType>::Handle::operator=(Handle&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool = other.pool;
+        obj = other.obj;
+        other.pool = nullptr;
+        other.obj = nullptr;
+    }
+    return *this;
+}
+
+template <typename TType>
+TType* ConcurrentPool<TType>::Handle::operator->() {
+    return obj ? obj->object : nullptr;
+}
+
+template <typename TType>
+TType& ConcurrentPool<TType>::Handle::operator*() {
+    return *(obj->object);
+}
+
+template <typename TType>
+void ConcurrentPool<TType>::Handle::release() noexcept {
+    if (pool && obj) {
+        try { pool->release(*obj); } catch (...) {}
+        pool = nullptr;
+        obj = nullptr;
+    }
+}
+
+template <typename TType>
+bool ConcurrentPool<TType>::Handle::valid() const noexcept {
+    return pool != nullptr && obj != nullptr && obj->isInUse();
+}
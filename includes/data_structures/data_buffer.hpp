@@ -1,13 +1,25 @@
 #ifndef DATA_BUFFER_HPP
 # define DATA_BUFFER_HPP
 
-# include <vector>
 # include <cstring>
 # include <stdexcept>
 # include <type_traits>
 # include <string>
 # include <cstdint>
 # include <cstddef>
+# include <span>
+# include <string_view>
+# include <limits>
+# include <vector>
+# include <array>
+# include <map>
+# include <unordered_map>
+# include <optional>
+# include <variant>
+# include <utility>
+# include <bit>
+# include <memory_resource>
+# include "byte_swap.hpp"
 
 /**
  * @file data_buffer.hpp
@@ -16,8 +28,136 @@
  * DataBuffer stores raw bytes and provides streaming operators << and >>
  * for trivially-copyable types. A specialization handles std::string by
  * writing the length followed by the bytes of the string.
+ *
+ * Storage grows geometrically and bytes past size() are never
+ * value-initialized, so an append costs one capacity check and one memcpy.
+ *
+ * The first LIBFTPP_DATABUFFER_INLINE_CAPACITY bytes (64 by default) live
+ * inside the object itself, so small payloads never touch the allocator.
+ * Define the macro at compile time to change the inline size (0 disables it).
+ *
+ * Multi-byte values are written in host order unless a ByteOrder is chosen
+ * with setByteOrder(), in which case integers, enums, floats and length
+ * prefixes are converted on the way in and out.
  */
 
+# ifndef LIBFTPP_DATABUFFER_INLINE_CAPACITY
+#  define LIBFTPP_DATABUFFER_INLINE_CAPACITY 64
+# endif
+
+/**
+ * @brief Read-only view over `count` packed T values stored inside a buffer.
+ *
+ * The bytes are not copied and need not be aligned for T, so elements are
+ * returned by value through memcpy. When the storage happens to be suitably
+ * aligned, asSpan() exposes it directly as a std::span<const T>.
+ *
+ * If the view was read from a buffer whose byte order differs from the
+ * host's, elements are byte-swapped as they are copied out; bytes() still
+ * returns the wire representation and asSpan() is unavailable.
+ *
+ * Like every view returned by DataBuffer, it is invalidated by any write,
+ * clear() or destruction of the buffer it was taken from.
+ */
+template<typename T>
+class ArrayView {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "ArrayView element type must be trivially copyable");
+
+    public:
+        class const_iterator {
+            public:
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+
+                const_iterator() noexcept : m_ptr(nullptr), m_swapped(false) {}
+                explicit const_iterator(const uint8_t* p, bool swapped = false) noexcept
+                    : m_ptr(p), m_swapped(swapped) {}
+
+                T operator*() const noexcept {
+                    return ArrayView::load(m_ptr, m_swapped);
+                }
+                const_iterator& operator++() noexcept { m_ptr += sizeof(T); return *this; }
+                const_iterator operator++(int) noexcept { const_iterator tmp = *this; ++*this; return tmp; }
+                bool operator==(const const_iterator& other) const noexcept { return m_ptr == other.m_ptr; }
+
+            private:
+                const uint8_t* m_ptr;
+                bool m_swapped;
+        };
+
+        ArrayView() noexcept : m_bytes(nullptr), m_count(0), m_swapped(false) {}
+        ArrayView(const uint8_t* bytes, size_t count, bool swapped = false) noexcept
+            : m_bytes(bytes), m_count(count), m_swapped(swapped) {}
+
+        size_t size() const noexcept { return m_count; }
+        bool empty() const noexcept { return m_count == 0; }
+
+        /** Element i, copied out of the (possibly unaligned) storage. No bounds check. */
+        T operator[](size_t i) const noexcept {
+            return load(m_bytes + i * sizeof(T), m_swapped);
+        }
+
+        const_iterator begin() const noexcept { return const_iterator(m_bytes, m_swapped); }
+        const_iterator end() const noexcept { return const_iterator(m_bytes + m_count * sizeof(T), m_swapped); }
+
+        /** True if elements are byte-swapped when copied out. */
+        bool isSwapped() const noexcept { return m_swapped; }
+
+        /** Underlying wire bytes (size() * sizeof(T) of them). */
+        std::span<const uint8_t> bytes() const noexcept { return {m_bytes, m_count * sizeof(T)}; }
+
+        /** Copy every element into out, which must hold size() values. */
+        void copyTo(T* out) const noexcept {
+            if constexpr (is_byte_swappable<T>()) {
+                if (m_swapped) {
+                    byte_swap_copy(out, m_bytes, m_count, sizeof(T));
+                    return;
+                }
+            }
+            if (m_count > 0) {
+                std::memcpy(out, m_bytes, m_count * sizeof(T));
+            }
+        }
+
+        /** True if the storage is aligned for T and in host order, i.e. asSpan() is usable. */
+        bool isAligned() const noexcept {
+            return reinterpret_cast<std::uintptr_t>(m_bytes) % alignof(T) == 0;
+        }
+
+        /**
+         * @brief Typed span over the storage.
+         * @throws std::runtime_error if the storage is not aligned for T or
+         *         not in host byte order.
+         */
+        std::span<const T> asSpan() const {
+            if (m_swapped) {
+                throw std::runtime_error("ArrayView storage is not in host byte order");
+            }
+            if (!isAligned()) {
+                throw std::runtime_error("ArrayView storage is not aligned for the element type");
+            }
+            return {reinterpret_cast<const T*>(m_bytes), m_count};
+        }
+
+    private:
+        static T load(const uint8_t* p, bool swapped) noexcept {
+            T value;
+            if constexpr (is_byte_swappable<T>()) {
+                if (swapped) {
+                    load_swapped(value, p);
+                    return value;
+                }
+            }
+            std::memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        const uint8_t* m_bytes;
+        size_t m_count;
+        bool m_swapped;
+};
+
 /**
  * @class DataBuffer
  * @brief A resizable binary buffer with stream-like operators.
@@ -25,16 +165,72 @@
  * The class is non-copyable (to avoid accidental expensive copies) but
  * supports move semantics. Use operator<< to serialize trivially-copyable
  * objects and operator>> to deserialize them in the same order.
+ *
+ * Data stays in the inline area until it outgrows INLINE_CAPACITY, then
+ * spills to the heap. Moving a heap-backed buffer steals its allocation;
+ * moving an inline one copies at most INLINE_CAPACITY bytes. In both cases
+ * the moved-from buffer is left empty and views into it are invalidated.
  */
 class DataBuffer {
 
     public:
+        /** Number of bytes stored inside the object before spilling to the heap. */
+        static constexpr size_t INLINE_CAPACITY = LIBFTPP_DATABUFFER_INLINE_CAPACITY;
+
+        /**
+         * @brief How operator<< / operator>> encode integers wider than one byte.
+         *
+         * - Fixed: raw sizeof(T) bytes (default, unchanged wire format).
+         * - Varint: LEB128 for unsigned types, zigzag + LEB128 for signed
+         *   types, and a varint length prefix for std::string. Values below
+         *   128 (or between -64 and 63) cost a single byte.
+         *
+         * Both sides must use the same encoding. bool, 1-byte integers,
+         * floating-point and other trivially-copyable types are always raw.
+         */
+        enum class IntegerEncoding { Fixed, Varint };
+
+        /**
+         * @brief Byte order of multi-byte values on the wire.
+         *
+         * - Host: whatever the local CPU uses (default, no conversion).
+         * - Little / Big: fixed order, converted on hosts that differ.
+         *
+         * Applies to integers, enums, floats and length prefixes written in
+         * Fixed encoding. Arrays of those types are converted with a SIMD
+         * kernel, so a swapped vector costs about as much as a memcpy.
+         * Other trivially-copyable types (structs) are always copied as-is.
+         */
+        enum class ByteOrder { Host, Little, Big };
+
+        /** Maximum size of an encoded 64-bit varint. */
+        static constexpr size_t MAX_VARINT_SIZE = 10;
+
         /** Default constructor: constructs an empty buffer. */
         DataBuffer();
 
         /** Create an empty buffer with reserved capacity. */
         explicit DataBuffer(size_t initialCapacity);
 
+        /**
+         * @brief Create an empty buffer whose heap block comes from `resource`.
+         *
+         * Use a SizeClassResource or FrameArena (see memory_resource.hpp)
+         * for short-lived buffers. nullptr means ::operator new. The
+         * resource must outlive the buffer; moves carry it along.
+         */
+        explicit DataBuffer(std::pmr::memory_resource* resource, size_t initialCapacity = 0);
+
+        /**
+         * @brief Wrap `size` bytes owned elsewhere, without copying them.
+         *
+         * Reads go straight to `bytes`, which must stay valid and unchanged
+         * while the buffer (or one moved from it) still refers to them. The
+         * first write copies them into owned storage; until then
+         * capacity() is 0 and isBorrowed() is true.
+         */
+        static DataBuffer borrow(const void* bytes, size_t size) noexcept;
+
         /** Destructor. */
         ~DataBuffer();
 
@@ -47,15 +243,24 @@ class DataBuffer {
         DataBuffer& operator=(DataBuffer&& other) noexcept;
 
         // Accessors
-        /** Return pointer to internal raw data (may be nullptr if empty). */
+        /** Return pointer to internal raw data (never nullptr). */
         const uint8_t* data() const noexcept;
 
         /** Current size (number of bytes of serialized data). */
         size_t size() const noexcept;
 
-        /** Current capacity of the underlying vector. */
+        /** Current capacity of the underlying storage. */
         size_t capacity() const noexcept;
 
+        /** Resource the heap block comes from (nullptr: ::operator new). */
+        std::pmr::memory_resource* resource() const noexcept;
+
+        /** True while the data still fits in the inline area (no heap block). */
+        bool isInline() const noexcept;
+
+        /** True while the data is the borrowed range given to borrow(). */
+        bool isBorrowed() const noexcept;
+
         /** True if the buffer contains no data. */
         bool empty() const noexcept;
 
@@ -75,21 +280,197 @@ class DataBuffer {
         /** Reserve capacity in the underlying storage. */
         void reserve(size_t newCapacity);
 
+        /** Select the integer encoding used by operator<< and operator>>. */
+        void setIntegerEncoding(IntegerEncoding encoding) noexcept;
+
+        /** Current integer encoding (Fixed by default). */
+        IntegerEncoding integerEncoding() const noexcept;
+
+        /** Select the byte order used for multi-byte values. */
+        void setByteOrder(ByteOrder order) noexcept;
+
+        /** Current byte order (Host by default). */
+        ByteOrder byteOrder() const noexcept;
+
+        /** Append an unsigned LEB128 varint (1 to 10 bytes). */
+        void writeVarint(uint64_t value);
+
+        /**
+         * @brief Decode an unsigned LEB128 varint and advance the read position.
+         *
+         * When at least 8 bytes remain the length is found with a single
+         * 64-bit load and the payload bits are compacted with a few
+         * word-wide mask/shift steps instead of a per-byte loop.
+         * @throws std::out_of_range on truncated or over-long input.
+         */
+        uint64_t readVarint();
+
+        /** Append a signed value as zigzag + LEB128 (small magnitudes stay small). */
+        void writeZigZag(int64_t value);
+
+        /** Decode a zigzag + LEB128 signed value. */
+        int64_t readZigZag();
+
+        /** Number of bytes writeVarint(value) would produce. */
+        static size_t varintSize(uint64_t value) noexcept;
+
+        /**
+         * @brief Append n raw bytes copied from src.
+         *
+         * Performs a single capacity check followed by one memcpy. Growth
+         * is geometric and new storage is left uninitialized, so repeated
+         * small writes do not realloc or zero-fill on every call.
+         */
+        void write(const void* src, size_t n);
+
+        /**
+         * @brief Append n uninitialized bytes and return them for the caller to fill.
+         *
+         * Lets producers (decompressors, recv(), ...) write straight into
+         * the buffer. The span is invalidated by the next write.
+         */
+        std::span<uint8_t> extend(size_t n);
+
+        /** Drop every byte past newSize (no-op if newSize >= size()). */
+        void truncate(size_t newSize) noexcept;
+
+        /**
+         * @brief Copy the next n bytes into dst and advance the read position.
+         * @throws std::out_of_range if fewer than n bytes remain.
+         */
+        void read(void* dst, size_t n);
+
+        /**
+         * @brief Return a view over the next n bytes and advance the read position.
+         *
+         * Nothing is copied: the span points into the buffer and stays valid
+         * until the next write, clear() or destruction of the buffer.
+         * @throws std::out_of_range if fewer than n bytes remain.
+         */
+        std::span<const uint8_t> readBytes(size_t n);
+
+        /**
+         * @brief Zero-copy counterpart of operator>>(std::string&).
+         *
+         * Reads the length prefix and returns a view over the string
+         * bytes. Same lifetime rules as readBytes().
+         */
+        std::string_view readStringView();
+
+        /**
+         * @brief Zero-copy read of `count` packed T values.
+         *
+         * Performs one bounds check for the whole array and advances the read
+         * position past it. See ArrayView for access and lifetime rules.
+         */
+        template<typename T>
+        ArrayView<T> readArray(size_t count) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "Type must be trivially copyable for binary deserialization");
+
+            if (count > (m_size - m_readPosition) / sizeof(T)) {
+                throw std::out_of_range("Not enough data in buffer to read array");
+            }
+            ArrayView<T> view(m_data + m_readPosition, count, is_byte_swappable<T>() && needsSwap());
+            m_readPosition += count * sizeof(T);
+            return view;
+        }
+
+        /**
+         * @brief Append `count` packed T values (no length prefix).
+         *
+         * Counterpart of readArray(): honors the byte order, so integer and
+         * float arrays are converted in one vectorized pass when needed.
+         */
+        template<typename T>
+        DataBuffer& writeArray(const T* values, size_t count) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "Type must be trivially copyable for binary serialization");
+
+            if constexpr (is_byte_swappable<T>()) {
+                if (needsSwap()) {
+                    writeSwapped(values, count, sizeof(T));
+                    return *this;
+                }
+            }
+            write(values, count * sizeof(T));
+            return *this;
+        }
+
+        /**
+         * @brief Append several trivially-copyable values at once.
+         *
+         * The total size is computed at compile time, so the whole record
+         * costs one capacity check followed by one copy per value (swapped
+         * when the byte order asks for it). Under the Varint encoding the
+         * size is not fixed and integers fall back to the << chain.
+         *
+         * @code{.cpp}
+         * buf.append(id, x, y, flags); // same bytes as buf << id << x << y << flags
+         * @endcode
+         */
+        template<typename... Ts>
+        DataBuffer& append(const Ts&... values) {
+            static_assert((std::is_trivially_copyable<Ts>::value && ...),
+                "Type must be trivially copyable for binary serialization");
+
+            if constexpr ((isCompactInteger<Ts>() || ...)) {
+                if (m_integerEncoding == IntegerEncoding::Varint) {
+                    return (*this << ... << values);
+                }
+            }
+
+            constexpr size_t total = (sizeof(Ts) + ... + 0);
+            ensureCapacity(m_size + total);
+
+            const bool swap = needsSwap();
+            uint8_t* out = m_data + m_size;
+            auto store = [&]<typename T>(const T& value) {
+                if constexpr (is_byte_swappable<T>()) {
+                    if (swap) {
+                        store_swapped(out, value);
+                        out += sizeof(T);
+                        return;
+                    }
+                }
+                std::memcpy(out, &value, sizeof(T));
+                out += sizeof(T);
+            };
+            (store(values), ...);
+            m_size += total;
+
+            return *this;
+        }
+
         // Serialization operator
         template<typename T>
         DataBuffer& operator<<(const T& value) {
             static_assert(std::is_trivially_copyable<T>::value,
                 "Type must be trivially copyable for binary serialization");
 
-            const size_t valueSize = sizeof(T);
-            const size_t currentSize = m_size;
+            if constexpr (isCompactInteger<T>()) {
+                if (m_integerEncoding == IntegerEncoding::Varint) {
+                    if constexpr (std::is_signed<T>::value) {
+                        writeZigZag(static_cast<int64_t>(value));
+                    } else {
+                        writeVarint(static_cast<uint64_t>(value));
+                    }
+                    return *this;
+                }
+            }
 
-            // Redimensionner le buffer pour accueillir les nouvelles données
-            m_buffer.resize(currentSize + valueSize);
+            ensureCapacity(m_size + sizeof(T));
 
             // Copier les bytes de l'objet dans le buffer
-            std::memcpy(m_buffer.data() + currentSize, &value, valueSize);
-            m_size = currentSize + valueSize;
+            if constexpr (is_byte_swappable<T>()) {
+                if (needsSwap()) {
+                    store_swapped(m_data + m_size, value);
+                    m_size += sizeof(T);
+                    return *this;
+                }
+            }
+            std::memcpy(m_data + m_size, &value, sizeof(T));
+            m_size += sizeof(T);
 
             return *this;
         }
@@ -100,6 +481,26 @@ class DataBuffer {
             static_assert(std::is_trivially_copyable<T>::value,
                 "Type must be trivially copyable for binary deserialization");
 
+            if constexpr (isCompactInteger<T>()) {
+                if (m_integerEncoding == IntegerEncoding::Varint) {
+                    if constexpr (std::is_signed<T>::value) {
+                        int64_t decoded = readZigZag();
+                        if (decoded < static_cast<int64_t>(std::numeric_limits<T>::min())
+                            || decoded > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+                            throw std::out_of_range("Varint value does not fit in target type");
+                        }
+                        value = static_cast<T>(decoded);
+                    } else {
+                        uint64_t decoded = readVarint();
+                        if (decoded > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                            throw std::out_of_range("Varint value does not fit in target type");
+                        }
+                        value = static_cast<T>(decoded);
+                    }
+                    return *this;
+                }
+            }
+
             const size_t valueSize = sizeof(T);
 
             if (m_readPosition + valueSize > m_size) {
@@ -107,21 +508,194 @@ class DataBuffer {
             }
 
             // Copier les bytes du buffer dans l'objet
-            std::memcpy(&value, m_buffer.data() + m_readPosition, valueSize);
+            if constexpr (is_byte_swappable<T>()) {
+                if (needsSwap()) {
+                    load_swapped(value, m_data + m_readPosition);
+                    m_readPosition += valueSize;
+                    return *this;
+                }
+            }
+            std::memcpy(&value, m_data + m_readPosition, valueSize);
             m_readPosition += valueSize;
 
             return *this;
         }
 
-    // Special support for std::string: store length (size_t) then bytes
+    // Special support for std::string: store length (size_t, or varint in
+    // Varint mode) then bytes
     DataBuffer& operator<<(const std::string& str);
     DataBuffer& operator>>(std::string& str);
 
+        /**
+         * @name Container and vocabulary type codecs
+         *
+         * - std::vector / std::basic_string-like ranges: length prefix, then
+         *   the elements. Contiguous trivially-copyable elements are written
+         *   and read with a single memcpy.
+         * - std::array: the N elements, no prefix.
+         * - std::map / std::unordered_map: length prefix, then key/value pairs.
+         * - std::pair: first then second.
+         * - std::optional: one presence byte, then the value if engaged.
+         * - std::variant: one index byte, then the active alternative.
+         *
+         * Elements are encoded recursively with the same rules, so nested
+         * containers and strings work. Writing computes serializedSize()
+         * first and grows the buffer once for the whole container.
+         * Reads validate counts against the remaining bytes before
+         * allocating and throw std::out_of_range on malformed input.
+         */
+        ///@{
+        template<typename T, typename A>
+        DataBuffer& operator<<(const std::vector<T, A>& values);
+        template<typename T, typename A>
+        DataBuffer& operator>>(std::vector<T, A>& values);
+
+        template<typename T, size_t N>
+        DataBuffer& operator<<(const std::array<T, N>& values);
+        template<typename T, size_t N>
+        DataBuffer& operator>>(std::array<T, N>& values);
+
+        template<typename K, typename V, typename C, typename A>
+        DataBuffer& operator<<(const std::map<K, V, C, A>& values);
+        template<typename K, typename V, typename C, typename A>
+        DataBuffer& operator>>(std::map<K, V, C, A>& values);
+
+        template<typename K, typename V, typename H, typename E, typename A>
+        DataBuffer& operator<<(const std::unordered_map<K, V, H, E, A>& values);
+        template<typename K, typename V, typename H, typename E, typename A>
+        DataBuffer& operator>>(std::unordered_map<K, V, H, E, A>& values);
+
+        template<typename T1, typename T2>
+        DataBuffer& operator<<(const std::pair<T1, T2>& value);
+        template<typename T1, typename T2>
+        DataBuffer& operator>>(std::pair<T1, T2>& value);
+
+        template<typename T>
+        DataBuffer& operator<<(const std::optional<T>& value);
+        template<typename T>
+        DataBuffer& operator>>(std::optional<T>& value);
+
+        template<typename... Ts>
+        DataBuffer& operator<<(const std::variant<Ts...>& value);
+        template<typename... Ts>
+        DataBuffer& operator>>(std::variant<Ts...>& value);
+        ///@}
+
+        /**
+         * @brief Exact number of bytes operator<< would append for value.
+         *
+         * Honors the current integer encoding. Used by the container codecs
+         * to reserve once before writing; also handy to size a buffer for a
+         * whole message up front.
+         */
+        template<typename T>
+        size_t serializedSize(const T& value) const noexcept;
+        size_t serializedSize(const std::string& value) const noexcept;
+        template<typename T, typename A>
+        size_t serializedSize(const std::vector<T, A>& values) const noexcept;
+        template<typename T, size_t N>
+        size_t serializedSize(const std::array<T, N>& values) const noexcept;
+        template<typename K, typename V, typename C, typename A>
+        size_t serializedSize(const std::map<K, V, C, A>& values) const noexcept;
+        template<typename K, typename V, typename H, typename E, typename A>
+        size_t serializedSize(const std::unordered_map<K, V, H, E, A>& values) const noexcept;
+        template<typename T1, typename T2>
+        size_t serializedSize(const std::pair<T1, T2>& value) const noexcept;
+        template<typename T>
+        size_t serializedSize(const std::optional<T>& value) const noexcept;
+        template<typename... Ts>
+        size_t serializedSize(const std::variant<Ts...>& value) const noexcept;
+
     private:
 
-        std::vector<uint8_t> m_buffer;    // Le buffer de bytes
+        /** Integers that the Varint encoding applies to (wider than a byte, not bool). */
+        template<typename T>
+        static constexpr bool isCompactInteger() {
+            return std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) > 1;
+        }
+
+        /** Element types whose contiguous runs may be copied with one memcpy. */
+        template<typename T>
+        static constexpr bool isBulkCandidate() {
+            return std::is_trivially_copyable<T>::value && !std::is_same<T, bool>::value;
+        }
+
+        /** True if a contiguous run of T can be copied with one memcpy right now. */
+        template<typename T>
+        bool isBulkCopyable() const noexcept {
+            if constexpr (!isBulkCandidate<T>()) {
+                return false;
+            } else if constexpr (isCompactInteger<T>()) {
+                return m_integerEncoding == IntegerEncoding::Fixed;
+            } else {
+                return true;
+            }
+        }
+
+        /** True if multi-byte values must be reversed to match m_byteOrder. */
+        bool needsSwap() const noexcept {
+            if (m_byteOrder == ByteOrder::Host) {
+                return false;
+            }
+            return (m_byteOrder == ByteOrder::Little) != (std::endian::native == std::endian::little);
+        }
+
+        /** Append count elements of `width` bytes, byte-reversed. */
+        void writeSwapped(const void* src, size_t count, size_t width);
+
+        /** Size of the length prefix for `length` under the current encoding. */
+        size_t lengthSize(size_t length) const noexcept {
+            return m_integerEncoding == IntegerEncoding::Varint ? varintSize(length) : sizeof(size_t);
+        }
+
+        /** Read a count prefix and reject it if fewer than count * minBytes remain. */
+        size_t readCount(size_t minBytes);
+
+        /** Shared body of the map codecs. */
+        template<typename Map>
+        void writeMap(const Map& values);
+        template<typename Map>
+        void readMap(Map& values);
+
+        /** Write a length prefix (size_t or varint, depending on the encoding). */
+        void writeLength(size_t length);
+
+        /** Read a length prefix written by writeLength(). */
+        size_t readLength();
+
+        /** Byte-at-a-time varint decoder used near the end of the buffer. */
+        uint64_t readVarintSlow();
+
+        /** Make room for at least `required` bytes (geometric growth). */
+        void ensureCapacity(size_t required) {
+            if (required > m_capacity) {
+                grow(required);
+            }
+        }
+
+        /** Slow path of ensureCapacity(): reallocate and move existing bytes. */
+        void grow(size_t required);
+
+        /** Take over other's storage (steal heap block or copy inline bytes). */
+        void stealFrom(DataBuffer& other) noexcept;
+
+        /** Free the heap block, if any, forget a borrowed range, and point back at the inline area. */
+        void releaseHeap() noexcept;
+
+        /** Allocate / free a heap block from m_resource (or the global heap). */
+        uint8_t* allocateBlock(size_t bytes);
+        void freeBlock(uint8_t* block, size_t bytes) noexcept;
+
+        uint8_t* m_data;                  // Stockage brut (non initialisé au-delà de m_size)
+        size_t m_capacity;                // Capacité allouée en bytes (0 = octets empruntés)
         size_t m_size;                    // Taille actuelle des données
         size_t m_readPosition;            // Position de lecture courante
+        IntegerEncoding m_integerEncoding; // Encodage des entiers (fixe ou varint)
+        ByteOrder m_byteOrder;            // Ordre des octets sur le fil
+        std::pmr::memory_resource* m_resource; // Origine du bloc heap (nullptr = operator new)
+        alignas(std::max_align_t) uint8_t m_inline[INLINE_CAPACITY ? INLINE_CAPACITY : 1]; // Stockage local (SBO)
 };
 
+# include "data_buffer.tpp"
+
 #endif // DATA_BUFFER_HPP
\ No newline at end of file
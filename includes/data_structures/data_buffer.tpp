@@ -0,0 +1,287 @@
+// Container and vocabulary type codecs for DataBuffer (included from data_buffer.hpp)
+
+// ---------------------------------------------------------------------------
+// serializedSize
+// ---------------------------------------------------------------------------
+
+template<typename T>
+size_t DataBuffer::serializedSize(const T& value) const noexcept {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Type must be trivially copyable for binary serialization");
+
+    if constexpr (isCompactInteger<T>()) {
+        if (m_integerEncoding == IntegerEncoding::Varint) {
+            if constexpr (std::is_signed<T>::value) {
+                const int64_t v = static_cast<int64_t>(value);
+                return varintSize((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+            } else {
+                return varintSize(static_cast<uint64_t>(value));
+            }
+        }
+    }
+    (void)value;
+    return sizeof(T);
+}
+
+inline size_t DataBuffer::serializedSize(const std::string& value) const noexcept {
+    return lengthSize(value.size()) + value.size();
+}
+
+template<typename T, typename A>
+size_t DataBuffer::serializedSize(const std::vector<T, A>& values) const noexcept {
+    size_t total = lengthSize(values.size());
+    if (isBulkCopyable<T>()) {
+        return total + values.size() * sizeof(T);
+    }
+    for (const T& value : values) {
+        total += serializedSize(value);
+    }
+    return total;
+}
+
+template<typename T, size_t N>
+size_t DataBuffer::serializedSize(const std::array<T, N>& values) const noexcept {
+    if (isBulkCopyable<T>()) {
+        return N * sizeof(T);
+    }
+    size_t total = 0;
+    for (const T& value : values) {
+        total += serializedSize(value);
+    }
+    return total;
+}
+
+template<typename K, typename V, typename C, typename A>
+size_t DataBuffer::serializedSize(const std::map<K, V, C, A>& values) const noexcept {
+    size_t total = lengthSize(values.size());
+    for (const auto& entry : values) {
+        total += serializedSize(entry.first) + serializedSize(entry.second);
+    }
+    return total;
+}
+
+template<typename K, typename V, typename H, typename E, typename A>
+size_t DataBuffer::serializedSize(const std::unordered_map<K, V, H, E, A>& values) const noexcept {
+    size_t total = lengthSize(values.size());
+    for (const auto& entry : values) {
+        total += serializedSize(entry.first) + serializedSize(entry.second);
+    }
+    return total;
+}
+
+template<typename T1, typename T2>
+size_t DataBuffer::serializedSize(const std::pair<T1, T2>& value) const noexcept {
+    return serializedSize(value.first) + serializedSize(value.second);
+}
+
+template<typename T>
+size_t DataBuffer::serializedSize(const std::optional<T>& value) const noexcept {
+    return 1 + (value ? serializedSize(*value) : 0);
+}
+
+template<typename... Ts>
+size_t DataBuffer::serializedSize(const std::variant<Ts...>& value) const noexcept {
+    return 1 + std::visit([this](const auto& alternative) { return serializedSize(alternative); }, value);
+}
+
+// ---------------------------------------------------------------------------
+// std::vector
+// ---------------------------------------------------------------------------
+
+template<typename T, typename A>
+DataBuffer& DataBuffer::operator<<(const std::vector<T, A>& values) {
+    ensureCapacity(m_size + serializedSize(values));
+    writeLength(values.size());
+    if constexpr (isBulkCandidate<T>()) {
+        if (isBulkCopyable<T>()) {
+            writeArray(values.data(), values.size());
+            return *this;
+        }
+    }
+    for (const T& value : values) {
+        *this << value;
+    }
+    return *this;
+}
+
+template<typename T, typename A>
+DataBuffer& DataBuffer::operator>>(std::vector<T, A>& values) {
+    if constexpr (isBulkCandidate<T>()) {
+        if (isBulkCopyable<T>()) {
+            const size_t count = readCount(sizeof(T));
+            values.resize(count);
+            readArray<T>(count).copyTo(values.data());
+            return *this;
+        }
+    }
+    const size_t count = readCount(1);
+    values.clear();
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        T value{};
+        *this >> value;
+        values.push_back(std::move(value));
+    }
+    return *this;
+}
+
+// ---------------------------------------------------------------------------
+// std::array
+// ---------------------------------------------------------------------------
+
+template<typename T, size_t N>
+DataBuffer& DataBuffer::operator<<(const std::array<T, N>& values) {
+    if (isBulkCopyable<T>()) {
+        writeArray(values.data(), N);
+    } else {
+        ensureCapacity(m_size + serializedSize(values));
+        for (const T& value : values) {
+            *this << value;
+        }
+    }
+    return *this;
+}
+
+template<typename T, size_t N>
+DataBuffer& DataBuffer::operator>>(std::array<T, N>& values) {
+    if (isBulkCopyable<T>()) {
+        readArray<T>(N).copyTo(values.data());
+    } else {
+        for (T& value : values) {
+            *this >> value;
+        }
+    }
+    return *this;
+}
+
+// ---------------------------------------------------------------------------
+// std::map / std::unordered_map
+// ---------------------------------------------------------------------------
+
+template<typename Map>
+void DataBuffer::writeMap(const Map& values) {
+    ensureCapacity(m_size + serializedSize(values));
+    writeLength(values.size());
+    for (const auto& entry : values) {
+        *this << entry.first << entry.second;
+    }
+}
+
+template<typename Map>
+void DataBuffer::readMap(Map& values) {
+    // every entry takes at least one byte for its key and one for its value
+    const size_t count = readCount(2);
+    values.clear();
+    for (size_t i = 0; i < count; ++i) {
+        typename Map::key_type key{};
+        typename Map::mapped_type mapped{};
+        *this >> key >> mapped;
+        values.insert_or_assign(std::move(key), std::move(mapped));
+    }
+}
+
+template<typename K, typename V, typename C, typename A>
+DataBuffer& DataBuffer::operator<<(const std::map<K, V, C, A>& values) {
+    writeMap(values);
+    return *this;
+}
+
+template<typename K, typename V, typename C, typename A>
+DataBuffer& DataBuffer::operator>>(std::map<K, V, C, A>& values) {
+    readMap(values);
+    return *this;
+}
+
+template<typename K, typename V, typename H, typename E, typename A>
+DataBuffer& DataBuffer::operator<<(const std::unordered_map<K, V, H, E, A>& values) {
+    writeMap(values);
+    return *this;
+}
+
+template<typename K, typename V, typename H, typename E, typename A>
+DataBuffer& DataBuffer::operator>>(std::unordered_map<K, V, H, E, A>& values) {
+    readMap(values);
+    return *this;
+}
+
+// ---------------------------------------------------------------------------
+// std::pair / std::optional / std::variant
+// ---------------------------------------------------------------------------
+
+template<typename T1, typename T2>
+DataBuffer& DataBuffer::operator<<(const std::pair<T1, T2>& value) {
+    return *this << value.first << value.second;
+}
+
+template<typename T1, typename T2>
+DataBuffer& DataBuffer::operator>>(std::pair<T1, T2>& value) {
+    return *this >> value.first >> value.second;
+}
+
+template<typename T>
+DataBuffer& DataBuffer::operator<<(const std::optional<T>& value) {
+    ensureCapacity(m_size + serializedSize(value));
+    *this << static_cast<uint8_t>(value.has_value());
+    if (value) {
+        *this << *value;
+    }
+    return *this;
+}
+
+template<typename T>
+DataBuffer& DataBuffer::operator>>(std::optional<T>& value) {
+    uint8_t engaged = 0;
+    *this >> engaged;
+    if (engaged > 1) {
+        throw std::out_of_range("Invalid std::optional presence flag");
+    }
+    if (engaged) {
+        T inner{};
+        *this >> inner;
+        value = std::move(inner);
+    } else {
+        value.reset();
+    }
+    return *this;
+}
+
+namespace data_buffer_detail {
+
+// Default-construct alternative I of V and decode it, chosen at runtime.
+template<typename V, size_t I = 0>
+void readVariantAlternative(DataBuffer& buffer, V& value, size_t index) {
+    if constexpr (I < std::variant_size<V>::value) {
+        if (index == I) {
+            std::variant_alternative_t<I, V> alternative{};
+            buffer >> alternative;
+            value.template emplace<I>(std::move(alternative));
+        } else {
+            readVariantAlternative<V, I + 1>(buffer, value, index);
+        }
+    }
+}
+
+}
+
+template<typename... Ts>
+DataBuffer& DataBuffer::operator<<(const std::variant<Ts...>& value) {
+    static_assert(sizeof...(Ts) < 256, "std::variant index must fit in one byte");
+    if (value.valueless_by_exception()) {
+        throw std::invalid_argument("Cannot serialize a valueless std::variant");
+    }
+    ensureCapacity(m_size + serializedSize(value));
+    *this << static_cast<uint8_t>(value.index());
+    std::visit([this](const auto& alternative) { *this << alternative; }, value);
+    return *this;
+}
+
+template<typename... Ts>
+DataBuffer& DataBuffer::operator>>(std::variant<Ts...>& value) {
+    uint8_t index = 0;
+    *this >> index;
+    if (index >= sizeof...(Ts)) {
+        throw std::out_of_range("Invalid std::variant index");
+    }
+    data_buffer_detail::readVariantAlternative(*this, value, index);
+    return *this;
+}
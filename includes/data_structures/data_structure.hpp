@@ -4,6 +4,12 @@
 
     # include "data_structures/data_buffer.hpp"
     # include "data_structures/pool.hpp"
+    # include "data_structures/concurrent_pool.hpp"
+    # include "data_structures/magazine_pool.hpp"
+    # include "data_structures/persistent_pool.hpp"
+    # include "data_structures/segmented_buffer.hpp"
+    # include "data_structures/ring_buffer.hpp"
+    # include "data_structures/memory_resource.hpp"
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#ifndef MAGAZINE_POOL_HPP
+# define MAGAZINE_POOL_HPP
+
+# include <cstddef>
+# include <memory>
+# include <mutex>
+# include <stdexcept>
+# include <vector>
+# include "pool.hpp"
+
+template <typename TType>
+/**
+ * @brief Per-thread magazine caches in front of a Pool.
+ *
+ * Classic slab-allocator layering: each thread owns a Cache holding two
+ * magazines (small stacks of free slots). acquire() and release() pop and
+ * push on the loaded magazine with no lock and no atomic operation. Only
+ * when the loaded magazine runs dry (or fills up) does the cache trade a
+ * whole magazine with the shared depot, under one mutex, so the shared
+ * state is touched once every magazineSize operations at most.
+ *
+ * Objects may be released by a different thread than the one that
+ * acquired them: the releasing thread's cache collects the slots and
+ * hands full magazines back to the depot, where the acquiring thread
+ * picks them up. This fits producer/consumer message churn.
+ *
+ * @code{.cpp}
+ * MagazinePool<Job> jobs;
+ * jobs.resize(4096);
+ * // in each worker thread:
+ * MagazinePool<Job>::Cache cache(jobs);
+ * auto& job = cache.acquire(args...);
+ * cache.release(job);
+ * @endcode
+ *
+ * Free slots parked in another thread's cache are not visible to the
+ * others, so a fixed-capacity pool may report exhaustion while caches
+ * still hold up to 2 * magazineSize slots each; size it with that slack
+ * or enable growth with setGrowth(). Caches must be destroyed before
+ * their MagazinePool.
+ *
+ * The underlying Pool only sees whole magazines of raw slots going out
+ * and coming back. Objects acquired and released through a Cache never
+ * enter its live list, never bump its slot generations and never reach
+ * its LIBFTPP_POOL_STATS hooks: MagazinePool offers no Ids, no live
+ * iteration, no stats and no leak report. Use a plain Pool where those
+ * matter.
+ *
+ * @tparam TType type stored in the pool. Can be non-trivial.
+ */
+class MagazinePool {
+
+    public:
+        /** Same slot type as the underlying Pool. */
+        using Object = typename Pool<TType>::Object;
+
+        /** Default number of slots per magazine. */
+        static constexpr size_t DEFAULT_MAGAZINE_SIZE = 32;
+
+    private:
+        /** Fixed-capacity stack of free slots. */
+        struct Magazine {
+            explicit Magazine(size_t p_capacity)
+                : rounds(new Object*[p_capacity]), count(0) {}
+
+            std::unique_ptr<Object*[]> rounds;
+            size_t count;
+        };
+
+    public:
+        /**
+         * @brief A thread's private front end to the pool.
+         *
+         * Not thread-safe itself: use one Cache per thread (for instance a
+         * member of the worker, or a thread_local). Flushes its slots back
+         * to the pool when destroyed.
+         */
+        class Cache {
+            public:
+                explicit Cache(MagazinePool<TType>& p_pool);
+                ~Cache();
+
+                Cache(const Cache&) = delete;
+                Cache& operator=(const Cache&) = delete;
+
+                /**
+                 * @brief Construct a TType in a cached slot.
+                 * @throws std::runtime_error if neither the cache, the depot
+                 *         nor the pool has a free slot.
+                 */
+                template<typename ... TArgs>
+                Object& acquire(TArgs&& ... p_args);
+
+                /** Non-throwing acquire(): nullptr when no slot is free or construction throws. */
+                template<typename ... TArgs>
+                Object* try_acquire(TArgs&& ... p_args) noexcept;
+
+                /**
+                 * @brief Destroy the object and keep its slot in this cache.
+                 *
+                 * Ownership by the pool is not re-validated on this path;
+                 * only double release is detected.
+                 * @throws std::runtime_error on double release.
+                 */
+                void release(Object& p_object);
+
+                /** Return every cached slot to the pool. */
+                void flush() noexcept;
+
+                /** Number of free slots currently held by this cache. */
+                size_t cachedCount() const noexcept;
+
+            private:
+                /** Make the loaded magazine non-empty; false if no slot anywhere. */
+                bool refill();
+
+                /** Make room in the loaded magazine. */
+                void spill();
+
+                MagazinePool<TType>* pool;
+                std::unique_ptr<Magazine> loaded;
+                std::unique_ptr<Magazine> previous;
+        };
+
+        /** @param p_magazineSize slots per magazine (at least 1). */
+        explicit MagazinePool(size_t p_magazineSize = DEFAULT_MAGAZINE_SIZE);
+
+        MagazinePool(const MagazinePool&) = delete;
+        MagazinePool& operator=(const MagazinePool&) = delete;
+
+        /** Pool::resize(). Not thread-safe: call it before any Cache exists. */
+        void resize(const size_t& numberOfObjectsStored,
+                    typename Pool<TType>::SlabBacking backing = Pool<TType>::SlabBacking::Heap);
+
+        /** Pool::setGrowth(): let the depot add chunks instead of running dry. */
+        void setGrowth(size_t slotsPerChunk,
+                       typename Pool<TType>::SlabBacking backing = Pool<TType>::SlabBacking::Heap);
+
+        /**
+         * @brief Give the slots of the depot's full magazines back to the pool.
+         *
+         * Lets Pool::shrink()-style reclamation and other threads' refills
+         * see them. Thread-safe.
+         * @return number of slots returned
+         */
+        size_t trim();
+
+        /** Slots held in the depot's full magazines. Thread-safe. */
+        size_t depotCount() const;
+
+        /** Slots free in the pool itself (outside caches and depot). Thread-safe. */
+        size_t availableCount() const;
+
+        /** Total capacity of the underlying pool. Thread-safe. */
+        size_t capacity() const;
+
+        /** Slots per magazine. */
+        size_t magazineSize() const noexcept;
+
+    private:
+        /** Trade an empty magazine for a full one (or fill it from the pool). */
+        std::unique_ptr<Magazine> exchangeEmpty(std::unique_ptr<Magazine> empty);
+
+        /** Trade a full magazine for an empty one. */
+        std::unique_ptr<Magazine> exchangeFull(std::unique_ptr<Magazine> full);
+
+        /** Return the slots of a magazine to the pool. */
+        void drain(Magazine& magazine) noexcept;
+
+        const size_t slotsPerMagazine;
+        mutable std::mutex depotLock;
+        Pool<TType> backing;
+        std::vector<std::unique_ptr<Magazine>> fullMagazines;
+        std::vector<std::unique_ptr<Magazine>> emptyMagazines;
+};
+
+# include "magazine_pool.tpp"
+
+#endif // MAGAZINE_POOL_HPP
@@ -0,0 +1,209 @@
+// MagazinePool implementation (included from magazine_pool.hpp)
+
+template <typename TType>
+MagazinePool<TType>::MagazinePool(size_t p_magazineSize)
+    : slotsPerMagazine(p_magazineSize) {
+    if (p_magazineSize == 0) {
+        throw std::invalid_argument("Magazine size must be greater than 0");
+    }
+}
+
+template <typename TType>
+void MagazinePool<TType>::resize(const size_t& numberOfObjectsStored, typename Pool<TType>::SlabBacking p_backing) {
+    std::lock_guard<std::mutex> lg(depotLock);
+    for (auto& magazine : fullMagazines) {
+        magazine->count = 0;
+        emptyMagazines.push_back(std::move(magazine));
+    }
+    fullMagazines.clear();
+    backing.resize(numberOfObjectsStored, p_backing);
+}
+
+template <typename TType>
+void MagazinePool<TType>::setGrowth(size_t slotsPerChunk, typename Pool<TType>::SlabBacking p_backing) {
+    std::lock_guard<std::mutex> lg(depotLock);
+    backing.setGrowth(slotsPerChunk, p_backing);
+}
+
+template <typename TType>
+std::unique_ptr<typename MagazinePool<TType>::Magazine>
+MagazinePool<TType>::exchangeEmpty(std::unique_ptr<Magazine> empty) {
+    std::lock_guard<std::mutex> lg(depotLock);
+    if (!fullMagazines.empty()) {
+        std::unique_ptr<Magazine> full = std::move(fullMagazines.back());
+        fullMagazines.pop_back();
+        emptyMagazines.push_back(std::move(empty));
+        return full;
+    }
+    // Depot is dry: load the magazine straight from the pool
+    try {
+        while (empty->count < slotsPerMagazine) {
+            Object* slot = backing.checkout();
+            if (!slot) {
+                break;
+            }
+            empty->rounds[empty->count++] = slot;
+        }
+    } catch (...) {
+        // growth failed; keep whatever was loaded
+        if (empty->count == 0) {
+            throw;
+        }
+    }
+    return empty;
+}
+
+template <typename TType>
+std::unique_ptr<typename MagazinePool<TType>::Magazine>
+MagazinePool<TType>::exchangeFull(std::unique_ptr<Magazine> full) {
+    std::lock_guard<std::mutex> lg(depotLock);
+    fullMagazines.push_back(std::move(full));
+    if (!emptyMagazines.empty()) {
+        std::unique_ptr<Magazine> empty = std::move(emptyMagazines.back());
+        emptyMagazines.pop_back();
+        return empty;
+    }
+    return std::make_unique<Magazine>(slotsPerMagazine);
+}
+
+template <typename TType>
+void MagazinePool<TType>::drain(Magazine& magazine) noexcept {
+    std::lock_guard<std::mutex> lg(depotLock);
+    while (magazine.count > 0) {
+        backing.checkin(*magazine.rounds[--magazine.count]);
+    }
+}
+
+template <typename TType>
+size_t MagazinePool<TType>::trim() {
+    std::lock_guard<std::mutex> lg(depotLock);
+    size_t returned = 0;
+    for (auto& magazine : fullMagazines) {
+        while (magazine->count > 0) {
+            backing.checkin(*magazine->rounds[--magazine->count]);
+            ++returned;
+        }
+        emptyMagazines.push_back(std::move(magazine));
+    }
+    fullMagazines.clear();
+    return returned;
+}
+
+template <typename TType>
+size_t MagazinePool<TType>::depotCount() const {
+    std::lock_guard<std::mutex> lg(depotLock);
+    size_t count = 0;
+    for (const auto& magazine : fullMagazines) {
+        count += magazine->count;
+    }
+    return count;
+}
+
+template <typename TType>
+size_t MagazinePool<TType>::availableCount() const {
+    std::lock_guard<std::mutex> lg(depotLock);
+    return backing.availableCount();
+}
+
+template <typename TType>
+size_t MagazinePool<TType>::capacity() const {
+    std::lock_guard<std::mutex> lg(depotLock);
+    return backing.capacity();
+}
+
+template <typename TType>
+size_t MagazinePool<TType>::magazineSize() const noexcept {
+    return slotsPerMagazine;
+}
+
+// Cache implementation
+template <typename TType>
+MagazinePool<TType>::Cache::Cache(MagazinePool<TType>& p_pool)
+    : pool(&p_pool)
+    , loaded(std::make_unique<Magazine>(p_pool.slotsPerMagazine))
+    , previous(std::make_unique<Magazine>(p_pool.slotsPerMagazine)) {}
+
+template <typename TType>
+MagazinePool<TType>::Cache::~Cache() {
+    flush();
+}
+
+template <typename TType>
+bool MagazinePool<TType>::Cache::refill() {
+    if (previous->count > 0) {
+        std::swap(loaded, previous);
+        return true;
+    }
+    loaded = pool->exchangeEmpty(std::move(loaded));
+    return loaded->count > 0;
+}
+
+template <typename TType>
+void MagazinePool<TType>::Cache::spill() {
+    if (previous->count == 0) {
+        std::swap(loaded, previous);
+        return;
+    }
+    // Both full: the depot takes the older one
+    previous = pool->exchangeFull(std::move(previous));
+    std::swap(loaded, previous);
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename MagazinePool<TType>::Object& MagazinePool<TType>::Cache::acquire(TArgs && ... p_args) {
+    if (loaded->count == 0 && !refill()) {
+        throw std::runtime_error("No available objects in the pool");
+    }
+    Object* objPtr = loaded->rounds[loaded->count - 1];
+    new (objPtr->object) TType(std::forward<TArgs>(p_args)...);
+    --loaded->count;
+    objPtr->constructed = true;
+    objPtr->inUse = true;
+    return *objPtr;
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename MagazinePool<TType>::Object* MagazinePool<TType>::Cache::try_acquire(TArgs && ... p_args) noexcept {
+    try {
+        if (loaded->count == 0 && !refill()) {
+            return nullptr;
+        }
+        Object* objPtr = loaded->rounds[loaded->count - 1];
+        new (objPtr->object) TType(std::forward<TArgs>(p_args)...);
+        --loaded->count;
+        objPtr->constructed = true;
+        objPtr->inUse = true;
+        return objPtr;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+template <typename TType>
+void MagazinePool<TType>::Cache::release(Object& p_object) {
+    if (!p_object.inUse) {
+        throw std::runtime_error("Double release detected or object not acquired");
+    }
+    if (loaded->count == pool->slotsPerMagazine) {
+        spill();
+    }
+    if (p_object.constructed) {
+        p_object.object->~TType();
+        p_object.constructed = false;
+    }
+    p_object.inUse = false;
+    loaded->rounds[loaded->count++] = &p_object;
+}
+
+template <typename TType>
+void MagazinePool<TType>::Cache::flush() noexcept {
+    pool->drain(*loaded);
+    pool->drain(*previous);
+}
+
+template <typename TType>
+size_t MagazinePool<TType>::Cache::cachedCount() const noexcept {
+    return loaded->count + previous->count;
+}
@@ -0,0 +1,197 @@
+#ifndef MEMORY_RESOURCE_HPP
+# define MEMORY_RESOURCE_HPP
+
+# include <memory_resource>
+# include <vector>
+# include <cstddef>
+# include <cstdint>
+
+/**
+ * @file memory_resource.hpp
+ * @brief std::pmr::memory_resource implementations for pooled and per-frame memory.
+ *
+ * Both resources plug into std::pmr containers (std::pmr::vector,
+ * std::pmr::string...) and into DataBuffer(std::pmr::memory_resource*).
+ * Neither is thread-safe, like std::pmr::unsynchronized_pool_resource:
+ * give each thread (or each frame loop) its own instance.
+ */
+
+/**
+ * @class SizeClassResource
+ * @brief Pool-style resource with one slab allocator per power-of-two size class.
+ *
+ * Requests are rounded up to a size class (8, 16, 32 ... maxBlockSize
+ * bytes, and at least the requested alignment). Each class carves equal
+ * blocks out of slabs taken from the upstream resource, like Pool carves
+ * slots out of a chunk, and keeps freed blocks on an intrusive free list:
+ * allocate/deallocate are a pointer pop/push once a class is warm.
+ * Larger requests go straight to the upstream resource.
+ *
+ * Slabs are only given back by release() or the destructor.
+ *
+ * @code{.cpp}
+ * SizeClassResource small;
+ * std::pmr::vector<std::pmr::string> names(&small);
+ * @endcode
+ */
+class SizeClassResource : public std::pmr::memory_resource {
+
+    public:
+        /** Smallest block (an intrusive free-list link must fit). */
+        static constexpr size_t MIN_BLOCK_SIZE = 8;
+
+        /** Default largest pooled block. */
+        static constexpr size_t DEFAULT_MAX_BLOCK_SIZE = 4096;
+
+        /** Default bytes requested from upstream per slab. */
+        static constexpr size_t DEFAULT_SLAB_SIZE = 64 * 1024;
+
+        /**
+         * @param maxBlockSize largest pooled request, rounded up to a power of two
+         * @param slabSize bytes per slab (raised to one block for big classes)
+         * @param upstream where slabs and oversized requests come from
+         */
+        explicit SizeClassResource(size_t maxBlockSize = DEFAULT_MAX_BLOCK_SIZE,
+                                   size_t slabSize = DEFAULT_SLAB_SIZE,
+                                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+        /** Destructor: release(). */
+        ~SizeClassResource() override;
+
+        SizeClassResource(const SizeClassResource&) = delete;
+        SizeClassResource& operator=(const SizeClassResource&) = delete;
+
+        /** Return every slab to upstream. Blocks still in use become invalid. */
+        void release() noexcept;
+
+        /** Number of size classes. */
+        size_t classCount() const noexcept;
+
+        /** Block size of the class serving (bytes, alignment), 0 if it goes upstream. */
+        size_t blockSizeFor(size_t bytes, size_t alignment = alignof(std::max_align_t)) const noexcept;
+
+        /** Number of slabs currently held. */
+        size_t slabCount() const noexcept;
+
+        /** Upstream resource. */
+        std::pmr::memory_resource* upstreamResource() const noexcept;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct SizeClass {
+            size_t blockSize;
+            FreeBlock* freeList;
+            // Uncarved tail of the newest slab
+            unsigned char* cursor;
+            unsigned char* end;
+        };
+
+        struct Slab {
+            void* memory;
+            size_t bytes;
+            size_t alignment;
+        };
+
+        /** Index of the class serving the request, classes.size() if none. */
+        size_t classIndex(size_t bytes, size_t alignment) const noexcept;
+
+        /** Take a new slab for `sizeClass` from upstream. */
+        void refill(SizeClass& sizeClass);
+
+        std::pmr::memory_resource* upstream;
+        size_t slabBytes;
+        std::vector<SizeClass> classes;
+        std::vector<Slab> slabs;
+};
+
+/**
+ * @class FrameArena
+ * @brief Monotonic (bump-pointer) resource emptied in one reset().
+ *
+ * Allocation bumps a pointer inside the current block; deallocate() does
+ * nothing. reset() makes every block reusable in O(number of blocks)
+ * without returning memory upstream, so a per-frame or per-message arena
+ * stops allocating once it has reached its working size. When a block is
+ * full the next retained block is used, or a new one (twice as large) is
+ * taken from upstream.
+ *
+ * Everything allocated from the arena must be dead (or never touched
+ * again) at reset().
+ *
+ * @code{.cpp}
+ * FrameArena frame;
+ * while (running) {
+ *     std::pmr::vector<Event> events(&frame);
+ *     DataBuffer scratch(&frame);
+ *     ...
+ *     frame.reset();   // instead of thousands of frees
+ * }
+ * @endcode
+ */
+class FrameArena : public std::pmr::memory_resource {
+
+    public:
+        /** Default size of the first block. */
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        /** Arena whose first block (of initialBlockSize bytes) is taken on first use. */
+        explicit FrameArena(size_t initialBlockSize = DEFAULT_BLOCK_SIZE,
+                            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+        /** Arena starting in a caller-owned buffer (e.g. on the stack); it is never freed. */
+        FrameArena(void* buffer, size_t bufferSize,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+        /** Destructor: release(). */
+        ~FrameArena() override;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /** Forget every allocation and rewind to the first block; keeps the blocks. */
+        void reset() noexcept;
+
+        /** reset() and return the blocks taken from upstream. */
+        void release() noexcept;
+
+        /** Bytes handed out since the last reset (alignment padding included). */
+        size_t bytesAllocated() const noexcept;
+
+        /** Total size of the blocks held. */
+        size_t capacity() const noexcept;
+
+        /** Number of blocks held. */
+        size_t blockCount() const noexcept;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        struct Block {
+            unsigned char* data;
+            size_t size;
+            bool owned;
+        };
+
+        /** Bump inside blocks[current] from `used`; nullptr if it does not fit. */
+        void* tryBump(size_t bytes, size_t alignment) noexcept;
+
+        std::pmr::memory_resource* upstream;
+        std::vector<Block> blocks;
+        size_t current;
+        size_t used;
+        size_t allocated;
+        size_t nextBlockSize;
+};
+
+#endif // MEMORY_RESOURCE_HPP
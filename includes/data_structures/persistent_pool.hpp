@@ -0,0 +1,214 @@
+#ifndef PERSISTENT_POOL_HPP
+# define PERSISTENT_POOL_HPP
+
+# include <cerrno>
+# include <cstddef>
+# include <cstdint>
+# include <cstring>
+# include <new>
+# include <stdexcept>
+# include <string>
+# include <type_traits>
+# include <utility>
+# include <fcntl.h>
+# include <sys/file.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+template <typename TType>
+/**
+ * @brief Pool whose slab and free list live in a memory-mapped file.
+ *
+ * The file holds a header, one 32-bit link per slot (the free list,
+ * stored as slot indices rather than pointers) and the objects
+ * themselves, laid out like a Pool slab. Every acquire()/release()
+ * writes straight into the shared mapping, so a restarted process that
+ * open()s the same file resumes with its live objects intact instead of
+ * rebuilding them.
+ *
+ * open() checks the header (magic, format version, the caller's
+ * userVersion, sizeof/alignof TType and the capacity) and throws on any
+ * mismatch. A file left open by a process that died is detected and its
+ * free list rebuilt from the per-slot states.
+ *
+ * Objects are addressed by slot index across restarts (indexOf()/at()):
+ * the mapping address changes, so pointers to pooled objects, or stored
+ * inside them, do not survive. Not thread-safe; open() takes an
+ * exclusive flock() so only one process at a time uses a given file.
+ *
+ * @code{.cpp}
+ * PersistentPool<Session> sessions;
+ * if (sessions.open("/var/lib/app/sessions.pool", 100000) == PersistentPool<Session>::OpenResult::Created) {
+ *     // first start: nothing to resume
+ * }
+ * Session& s = sessions.acquire(args...);
+ * size_t index = sessions.indexOf(s);   // store this, not &s
+ * @endcode
+ *
+ * @tparam TType trivially copyable type stored in the pool.
+ */
+class PersistentPool {
+
+    static_assert(std::is_trivially_copyable_v<TType>,
+                  "PersistentPool stores raw object bytes in a file: TType must be trivially copyable");
+    static_assert(alignof(TType) <= 4096, "PersistentPool cannot align TType beyond a page");
+
+    public:
+        /** Bumped whenever the file layout changes. */
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        /** What open() found on disk. */
+        enum class OpenResult {
+            Created,    /**< New (or empty) file, every slot free. */
+            Resumed,    /**< Clean file from a previous close(). */
+            Recovered   /**< File of a process that died while it was open; free list rebuilt. */
+        };
+
+        /** Closed pool. */
+        PersistentPool() noexcept;
+
+        /** Destructor: close(). */
+        ~PersistentPool() noexcept;
+
+        PersistentPool(const PersistentPool&) = delete;
+        PersistentPool& operator=(const PersistentPool&) = delete;
+
+        /**
+         * @brief Map `path`, creating it with `capacity` slots if it is empty or missing.
+         *
+         * @param userVersion layout version of TType chosen by the caller;
+         *        bump it when TType changes in a size-preserving way.
+         * @throws std::invalid_argument if capacity is zero
+         * @throws std::length_error if capacity does not fit a 32-bit slot index
+         * @throws std::logic_error if the pool is already open
+         * @throws std::runtime_error if the file cannot be opened, locked or
+         *         mapped, or if its header does not match (the file is left
+         *         untouched)
+         */
+        OpenResult open(const std::string& path, size_t capacity, uint32_t userVersion = 0);
+
+        /** Mark the file clean and unmap it. Live objects stay in the file. */
+        void close() noexcept;
+
+        /** True between open() and close(). */
+        bool isOpen() const noexcept;
+
+        /**
+         * @brief Flush the mapping to disk (msync).
+         *
+         * Not needed to survive a process crash (the page cache keeps the
+         * writes), only to survive a machine crash.
+         * @throws std::runtime_error on failure
+         */
+        void sync();
+
+        /**
+         * @brief Construct a TType in a free slot.
+         * @throws std::runtime_error if the pool is closed or full
+         */
+        template<typename ... TArgs>
+        TType& acquire(TArgs&& ... p_args);
+
+        /** Non-throwing acquire(): nullptr when closed, full, or construction throws. */
+        template<typename ... TArgs>
+        TType* try_acquire(TArgs&& ... p_args) noexcept;
+
+        /**
+         * @brief Return an object's slot to the free list.
+         * @throws std::invalid_argument if the object is not in this pool
+         * @throws std::runtime_error if the slot is not acquired
+         */
+        void release(TType& p_object);
+
+        /** Release by slot index; same errors as release(TType&). */
+        void release(size_t index);
+
+        /**
+         * @brief Slot index of an object, stable across restarts.
+         * @throws std::invalid_argument if the object is not in this pool
+         */
+        size_t indexOf(const TType& p_object) const;
+
+        /** Acquired object at `index`, nullptr if the slot is free or out of range. */
+        TType* at(size_t index) noexcept;
+        const TType* at(size_t index) const noexcept;
+
+        /** True if `index` holds an acquired object. */
+        bool contains(size_t index) const noexcept;
+
+        /**
+         * @brief Call fn(index, object) for every acquired object.
+         *
+         * Scans the dense link array (4 bytes per slot), not the objects.
+         * Releasing the visited object from fn is allowed.
+         */
+        template <typename Fn>
+        void forEach(Fn&& fn);
+
+        /** Number of free slots. */
+        size_t availableCount() const noexcept;
+
+        /** Number of acquired slots. */
+        size_t usedCount() const noexcept;
+
+        /** Number of slots in the file (0 when closed). */
+        size_t capacity() const noexcept;
+
+        /** Path given to open() (empty when closed). */
+        const std::string& path() const noexcept;
+
+    private:
+        /** Link value of an acquired slot. */
+        static constexpr uint32_t IN_USE = 0xFFFFFFFEu;
+
+        /** End of the free list. */
+        static constexpr uint32_t END = 0xFFFFFFFFu;
+
+        static constexpr uint64_t MAGIC = 0x4C4F4F5050544646ull; // "FFTPPOOL"
+
+        /** First bytes of the file. Never reordered within a FORMAT_VERSION. */
+        struct Header {
+            uint64_t magic;
+            uint32_t formatVersion;
+            uint32_t userVersion;
+            uint32_t typeSize;
+            uint32_t typeAlignment;
+            uint64_t capacity;
+            uint64_t objectsOffset;
+            uint64_t used;
+            uint32_t freeHead;
+            /** Non-zero while a process has the file open. */
+            uint32_t dirty;
+        };
+
+        /** Offset of the object array for `capacity` slots. */
+        static size_t objectsOffsetFor(size_t capacity) noexcept;
+
+        /** Check a mapped header against this instantiation; throws runtime_error. */
+        static void validate(const Header& header, const std::string& path,
+                             size_t capacity, uint32_t userVersion, size_t fileSize);
+
+        /** Rebuild freeHead and used from the link states. */
+        void recover() noexcept;
+
+        /** Unlink the head of the free list (END if empty). */
+        uint32_t pop() noexcept;
+
+        /** Slot index of `p_object`; END if it is not inside the slab. */
+        uint32_t slotOf(const TType* p_object) const noexcept;
+
+        TType* objectAt(uint32_t index) const noexcept;
+
+        std::string filePath;
+        int fd;
+        unsigned char* mapping;
+        size_t mappedBytes;
+        Header* header;
+        uint32_t* links;
+        unsigned char* objects;
+};
+
+# include "persistent_pool.tpp"
+
+#endif // PERSISTENT_POOL_HPP
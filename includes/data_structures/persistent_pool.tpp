@@ -0,0 +1,333 @@
+// PersistentPool implementation (included from persistent_pool.hpp)
+
+template <typename TType>
+PersistentPool<TType>::PersistentPool() noexcept
+    : fd(-1), mapping(nullptr), mappedBytes(0), header(nullptr), links(nullptr), objects(nullptr) {}
+
+template <typename TType>
+PersistentPool<TType>::~PersistentPool() noexcept {
+    close();
+}
+
+template <typename TType>
+size_t PersistentPool<TType>::objectsOffsetFor(size_t p_capacity) noexcept {
+    // Same slot alignment as a Pool slab: TType's, and at least a cache line
+    constexpr size_t alignment = alignof(TType) > 64 ? alignof(TType) : 64;
+    const size_t linksEnd = sizeof(Header) + p_capacity * sizeof(uint32_t);
+    return (linksEnd + alignment - 1) / alignment * alignment;
+}
+
+template <typename TType>
+void PersistentPool<TType>::validate(const Header& p_header, const std::string& p_path,
+                                     size_t p_capacity, uint32_t p_userVersion, size_t fileSize) {
+    const std::string prefix = "PersistentPool: " + p_path + ": ";
+    if (p_header.magic != MAGIC) {
+        throw std::runtime_error(prefix + "not a pool file");
+    }
+    if (p_header.formatVersion != FORMAT_VERSION) {
+        throw std::runtime_error(prefix + "unsupported format version " + std::to_string(p_header.formatVersion));
+    }
+    if (p_header.userVersion != p_userVersion) {
+        throw std::runtime_error(prefix + "user version " + std::to_string(p_header.userVersion)
+                                 + " does not match " + std::to_string(p_userVersion));
+    }
+    if (p_header.typeSize != sizeof(TType) || p_header.typeAlignment != alignof(TType)) {
+        throw std::runtime_error(prefix + "stored type layout does not match TType");
+    }
+    if (p_header.capacity != p_capacity) {
+        throw std::runtime_error(prefix + "capacity " + std::to_string(p_header.capacity)
+                                 + " does not match " + std::to_string(p_capacity));
+    }
+    if (p_header.objectsOffset != objectsOffsetFor(p_capacity)
+        || fileSize != p_header.objectsOffset + p_capacity * sizeof(TType)) {
+        throw std::runtime_error(prefix + "file size does not match its header");
+    }
+}
+
+template <typename TType>
+typename PersistentPool<TType>::OpenResult
+PersistentPool<TType>::open(const std::string& p_path, size_t p_capacity, uint32_t p_userVersion) {
+    if (mapping) {
+        throw std::logic_error("PersistentPool is already open");
+    }
+    if (p_capacity == 0) {
+        throw std::invalid_argument("Pool size must be greater than 0");
+    }
+    if (p_capacity >= IN_USE) {
+        throw std::length_error("Pool size exceeds the slot index range");
+    }
+
+    const int file = ::open(p_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (file < 0) {
+        throw std::runtime_error("PersistentPool: cannot open " + p_path + ": " + std::strerror(errno));
+    }
+    // Capture errno before close() can overwrite it
+    auto fail = [&](const char* what) {
+        const std::string message = std::string("PersistentPool: cannot ") + what + " " + p_path + ": " + std::strerror(errno);
+        ::close(file);
+        return std::runtime_error(message);
+    };
+    // Held until close(); the kernel drops it if the process dies
+    if (::flock(file, LOCK_EX | LOCK_NB) != 0) {
+        throw fail("lock");
+    }
+    struct stat info;
+    if (::fstat(file, &info) != 0) {
+        throw fail("stat");
+    }
+
+    const size_t bytes = objectsOffsetFor(p_capacity) + p_capacity * sizeof(TType);
+    // An empty file, or one whose creation never got as far as the magic
+    bool fresh = info.st_size == 0;
+    if (!fresh) {
+        Header existing{};
+        if (static_cast<size_t>(info.st_size) < sizeof(Header)
+            || ::pread(file, &existing, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header))) {
+            ::close(file);
+            throw std::runtime_error("PersistentPool: " + p_path + ": truncated header");
+        }
+        fresh = existing.magic == 0;
+        if (!fresh) {
+            try {
+                validate(existing, p_path, p_capacity, p_userVersion, static_cast<size_t>(info.st_size));
+            } catch (...) {
+                ::close(file);
+                throw;
+            }
+        }
+    }
+    if (fresh && (::ftruncate(file, 0) != 0 || ::ftruncate(file, static_cast<off_t>(bytes)) != 0)) {
+        throw fail("resize");
+    }
+
+    void* raw = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (raw == MAP_FAILED) {
+        throw fail("map");
+    }
+    fd = file;
+    mapping = static_cast<unsigned char*>(raw);
+    mappedBytes = bytes;
+    header = reinterpret_cast<Header*>(mapping);
+    links = reinterpret_cast<uint32_t*>(mapping + sizeof(Header));
+    objects = mapping + objectsOffsetFor(p_capacity);
+    filePath = p_path;
+
+    OpenResult result = OpenResult::Resumed;
+    if (fresh) {
+        for (size_t i = 0; i + 1 < p_capacity; ++i) {
+            links[i] = static_cast<uint32_t>(i + 1);
+        }
+        links[p_capacity - 1] = END;
+        header->formatVersion = FORMAT_VERSION;
+        header->userVersion = p_userVersion;
+        header->typeSize = sizeof(TType);
+        header->typeAlignment = alignof(TType);
+        header->capacity = p_capacity;
+        header->objectsOffset = objectsOffsetFor(p_capacity);
+        header->used = 0;
+        header->freeHead = 0;
+        header->dirty = 0;
+        // Written last: a file without it is initialised again on next open
+        header->magic = MAGIC;
+        result = OpenResult::Created;
+    } else if (header->dirty) {
+        recover();
+        result = OpenResult::Recovered;
+    }
+    header->dirty = 1;
+    return result;
+}
+
+template <typename TType>
+void PersistentPool<TType>::close() noexcept {
+    if (!mapping) {
+        return;
+    }
+    header->dirty = 0;
+    ::munmap(mapping, mappedBytes);
+    ::close(fd);
+    fd = -1;
+    mapping = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+    links = nullptr;
+    objects = nullptr;
+    filePath.clear();
+}
+
+template <typename TType>
+bool PersistentPool<TType>::isOpen() const noexcept {
+    return mapping != nullptr;
+}
+
+template <typename TType>
+void PersistentPool<TType>::sync() {
+    if (mapping && ::msync(mapping, mappedBytes, MS_SYNC) != 0) {
+        throw std::runtime_error("PersistentPool: cannot sync " + filePath + ": " + std::strerror(errno));
+    }
+}
+
+template <typename TType>
+void PersistentPool<TType>::recover() noexcept {
+    // A slot is acquired only once its link says IN_USE (written after
+    // construction), so anything else is free, whatever the old list said
+    const uint32_t count = static_cast<uint32_t>(header->capacity);
+    uint64_t used = 0;
+    uint32_t head = END;
+    for (uint32_t i = count; i-- > 0;) {
+        if (links[i] == IN_USE) {
+            ++used;
+        } else {
+            links[i] = head;
+            head = i;
+        }
+    }
+    header->used = used;
+    header->freeHead = head;
+}
+
+template <typename TType>
+uint32_t PersistentPool<TType>::pop() noexcept {
+    const uint32_t index = header->freeHead;
+    if (index != END) {
+        header->freeHead = links[index];
+    }
+    return index;
+}
+
+template <typename TType>
+TType* PersistentPool<TType>::objectAt(uint32_t index) const noexcept {
+    return std::launder(reinterpret_cast<TType*>(objects + static_cast<size_t>(index) * sizeof(TType)));
+}
+
+template <typename TType>
+uint32_t PersistentPool<TType>::slotOf(const TType* p_object) const noexcept {
+    if (!mapping) {
+        return END;
+    }
+    const unsigned char* raw = reinterpret_cast<const unsigned char*>(p_object);
+    const size_t slabBytes = header->capacity * sizeof(TType);
+    if (raw < objects || raw >= objects + slabBytes
+        || static_cast<size_t>(raw - objects) % sizeof(TType) != 0) {
+        return END;
+    }
+    return static_cast<uint32_t>(static_cast<size_t>(raw - objects) / sizeof(TType));
+}
+
+template <typename TType>
+template <typename ... TArgs>
+TType& PersistentPool<TType>::acquire(TArgs&& ... p_args) {
+    if (!mapping) {
+        throw std::runtime_error("PersistentPool is not open");
+    }
+    const uint32_t index = pop();
+    if (index == END) {
+        throw std::runtime_error("No available objects in the pool");
+    }
+    TType* slot = objectAt(index);
+    try {
+        ::new (static_cast<void*>(slot)) TType(std::forward<TArgs>(p_args)...);
+    } catch (...) {
+        // links[index] still points at the rest of the list
+        header->freeHead = index;
+        throw;
+    }
+    // Marked in use only once constructed, so a crash before this leaves it free
+    links[index] = IN_USE;
+    ++header->used;
+    return *slot;
+}
+
+template <typename TType>
+template <typename ... TArgs>
+TType* PersistentPool<TType>::try_acquire(TArgs&& ... p_args) noexcept {
+    if (!mapping || header->freeHead == END) {
+        return nullptr;
+    }
+    try {
+        return &acquire(std::forward<TArgs>(p_args)...);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+template <typename TType>
+void PersistentPool<TType>::release(TType& p_object) {
+    const uint32_t index = slotOf(&p_object);
+    if (index == END) {
+        throw std::invalid_argument("Attempting to release an object that does not belong to this pool");
+    }
+    release(static_cast<size_t>(index));
+}
+
+template <typename TType>
+void PersistentPool<TType>::release(size_t index) {
+    if (!mapping || index >= header->capacity) {
+        throw std::invalid_argument("Attempting to release an object that does not belong to this pool");
+    }
+    if (links[index] != IN_USE) {
+        throw std::runtime_error("Double release detected or object not acquired");
+    }
+    // Trivially destructible: nothing to run, the bytes just become free
+    links[index] = header->freeHead;
+    header->freeHead = static_cast<uint32_t>(index);
+    --header->used;
+}
+
+template <typename TType>
+size_t PersistentPool<TType>::indexOf(const TType& p_object) const {
+    const uint32_t index = slotOf(&p_object);
+    if (index == END) {
+        throw std::invalid_argument("Object does not belong to this pool");
+    }
+    return index;
+}
+
+template <typename TType>
+TType* PersistentPool<TType>::at(size_t index) noexcept {
+    return contains(index) ? objectAt(static_cast<uint32_t>(index)) : nullptr;
+}
+
+template <typename TType>
+const TType* PersistentPool<TType>::at(size_t index) const noexcept {
+    return contains(index) ? objectAt(static_cast<uint32_t>(index)) : nullptr;
+}
+
+template <typename TType>
+bool PersistentPool<TType>::contains(size_t index) const noexcept {
+    return mapping && index < header->capacity && links[index] == IN_USE;
+}
+
+template <typename TType>
+template <typename Fn>
+void PersistentPool<TType>::forEach(Fn&& fn) {
+    if (!mapping) {
+        return;
+    }
+    const size_t count = header->capacity;
+    for (size_t i = 0; i < count; ++i) {
+        if (links[i] == IN_USE) {
+            fn(i, *objectAt(static_cast<uint32_t>(i)));
+        }
+    }
+}
+
+template <typename TType>
+size_t PersistentPool<TType>::availableCount() const noexcept {
+    return mapping ? header->capacity - header->used : 0;
+}
+
+template <typename TType>
+size_t PersistentPool<TType>::usedCount() const noexcept {
+    return mapping ? header->used : 0;
+}
+
+template <typename TType>
+size_t PersistentPool<TType>::capacity() const noexcept {
+    return mapping ? header->capacity : 0;
+}
+
+template <typename TType>
+const std::string& PersistentPool<TType>::path() const noexcept {
+    return filePath;
+}
@@ -3,17 +3,36 @@
 
 
 # include <iostream>
+# include <sstream>
 # include <string>
 # include <vector>
+# include <memory>
+# include <algorithm>
 # include <stdexcept>
 # include <cstddef>
+# include <cstdint>
+# include <span>
+# include <concepts>
+# include <ranges>
+# include <new>
+# include <utility>
+# include <sys/mman.h>
+# include "pool_stats.hpp"
 
 template <typename TType>
 /**
  * @brief Object pool template.
  *
- * Pool implements a fixed-capacity object pool. Memory for TType
- * objects is preallocated with proper alignment. Users acquire
+ * Pool implements an object pool. Memory for TType objects is
+ * preallocated with proper alignment in contiguous slabs (chunks): slot i
+ * of a chunk lives at slab + i * sizeof(TType), and the Pool::Object
+ * bookkeeping of each chunk is kept in a separate dense array, so
+ * scanning slot states never touches the objects themselves.
+ *
+ * By default the capacity is fixed by resize() and acquire() throws once
+ * it is exhausted. setGrowth() enables a growth mode in which an exhausted
+ * pool appends a new chunk instead; existing chunks never move, so
+ * acquired objects stay pointer-stable. Users acquire
  * objects via Pool::acquire(...) which constructs a TType in-place
  * in the preallocated memory. Objects must be returned to the pool
  * with Pool::release(...). The pool does not deallocate the raw
@@ -39,9 +58,10 @@ class Pool {
 
                 /** Construct an Object wrapper for a raw memory block.
                  * @param p_object pointer to preallocated memory for TType
-                 * @param p_index index inside the pool storage
+                 * @param p_index index inside the owning chunk
+                 * @param p_chunk index of the owning chunk
                  */
-                Object(TType * p_object, size_t p_index);
+                Object(TType * p_object, size_t p_index, size_t p_chunk = 0);
 
                 /** Destructor. If the contained object was constructed it is
                  * the Pool responsibility to destroy it; normally release()
@@ -63,9 +83,27 @@ class Pool {
                 /** True when the slot is checked out via acquire(). */
                 bool inUse;
 
-                /** Index of this slot inside the owning Pool::storage. */
+                /** Index of this slot inside its chunk. */
                 size_t index;
 
+                /** Index of the chunk holding this slot. */
+                size_t chunk;
+
+                /** Pool-wide slot number, the first half of an Id. */
+                uint32_t slot;
+
+                /** Position in the dense list of live objects (valid while acquired). */
+                uint32_t livePosition;
+
+# ifdef LIBFTPP_POOL_STATS
+                /** pool_stats_now() when the slot was acquired. */
+                uint64_t acquiredAt = 0;
+# endif
+# ifdef LIBFTPP_POOL_CALL_SITES
+                /** Return address of the call that acquired the slot. */
+                const void* acquiredFrom = nullptr;
+# endif
+
                 /** Returns true if an object has been constructed in this slot. */
                 bool isConstructed() const;
 
@@ -105,6 +143,9 @@ class Pool {
 
             bool valid() const noexcept;
 
+            /** Compact Id of the held object (null Id when empty). */
+            typename Pool<TType>::Id id() const noexcept;
+
         private:
             friend class Pool<TType>;
             Pool<TType>* pool;
@@ -112,8 +153,52 @@ class Pool {
             explicit Handle(Pool<TType>* p_pool, Object* p_obj) noexcept;
         };
 
+        /**
+         * @brief Compact, copyable reference to an acquired object.
+         *
+         * 64 bits: a pool-wide slot number and the generation of that
+         * slot. release() bumps the generation, so an Id kept after the
+         * object was released (even if the slot was acquired again)
+         * resolves to nullptr in O(1) instead of dangling. Ids are
+         * trivially copyable and can be written into a Message or stored
+         * in large tables. A default-constructed Id is null.
+         */
+        struct Id {
+            uint32_t slot = 0;
+            uint32_t generation = 0;
+
+            /** False for the null Id (generation 0 is never issued). */
+            explicit operator bool() const noexcept { return generation != 0; }
+            bool operator==(const Id&) const noexcept = default;
+        };
+
     public:
 
+        /**
+         * @brief Where resize() takes the slab from.
+         *
+         * - Heap: one aligned ::operator new block (default).
+         * - HugePages: an anonymous mmap() advised with MADV_HUGEPAGE, so
+         *   large pools are backed by transparent huge pages when the
+         *   kernel allows it (fewer TLB misses). Falls back to Heap if
+         *   the mapping fails.
+         */
+        enum class SlabBacking { Heap, HugePages };
+
+        /**
+         * @brief What release() does with the object.
+         *
+         * - Destroy (default): run ~TType(); the next acquire() constructs
+         *   a fresh object.
+         * - Reset: keep the object constructed and call its reset() member
+         *   instead, so buffers it owns keep their capacity across cycles.
+         *   acquire() without arguments hands the warm object back as is;
+         *   with arguments it calls reset(args...) when TType has such an
+         *   overload, and rebuilds the object otherwise. If reset() throws
+         *   the object is destroyed and the slot rebuilt on next use.
+         */
+        enum class ReleasePolicy { Destroy, Reset };
+
         /** Default constructor. */
         Pool() noexcept;
 
@@ -129,30 +214,36 @@ class Pool {
         /**
          * @brief Resize the pool to hold exactly numberOfObjectsStored slots.
          *
-         * Existing storage is cleared. Each slot reserves aligned raw
-         * memory sufficient for a TType. Throws std::invalid_argument if
-         * numberOfObjectsStored is zero.
+         * Existing storage is cleared. All slots are carved out of one
+         * chunk aligned for TType (and at least to a cache line).
+         * Throws std::invalid_argument if numberOfObjectsStored is zero.
+         * If allocation fails the pool is left unchanged.
          */
         void resize(const size_t& numberOfObjectsStored);
 
+        /** Same as resize(numberOfObjectsStored), choosing the slab backing. */
+        void resize(const size_t& numberOfObjectsStored, SlabBacking backing);
+
         /**
          * @brief Acquire an object from the pool and construct it in-place.
          *
          * The function returns a reference to a Pool::Object wrapper.
-         * If no slots are available a std::runtime_error is thrown.
+         * If no slots are available, a growth pool appends a chunk;
+         * otherwise a std::runtime_error is thrown.
          *
          * @tparam TArgs Constructor argument types forwarded to TType.
          * @param p_args forwarded constructor arguments.
          * @return reference to the acquired Pool::Object.
          */
         template<typename ... TArgs>
-        typename Pool<TType>::Object& acquire(TArgs&& ... p_args);
+        LIBFTPP_POOL_ENTRY typename Pool<TType>::Object& acquire(TArgs&& ... p_args);
 
         /**
-         * @brief Non-throwing attempt to acquire a slot. Returns nullptr if none available.
+         * @brief Non-throwing attempt to acquire a slot. Returns nullptr if none available
+         * (or if a growth pool cannot allocate a new chunk).
          */
         template<typename ... TArgs>
-        typename Pool<TType>::Object* try_acquire(TArgs&& ... p_args) noexcept;
+        LIBFTPP_POOL_ENTRY typename Pool<TType>::Object* try_acquire(TArgs&& ... p_args) noexcept;
 
         /**
          * @brief Acquire and return an RAII Handle that will release on destruction.
@@ -160,7 +251,7 @@ class Pool {
          * Behaves like acquire(...) but returns a move-only Handle.
          */
         template<typename ... TArgs>
-        Handle acquireHandle(TArgs&& ... p_args);
+        LIBFTPP_POOL_ENTRY Handle acquireHandle(TArgs&& ... p_args);
 
         /**
          * @brief Release a previously acquired object back to the pool.
@@ -171,6 +262,76 @@ class Pool {
          */
         void release(typename Pool<TType>::Object& p_object);
 
+        /**
+         * @brief Acquire out.size() objects in one pass.
+         *
+         * Object i is constructed from p_generator(i). Slots are reserved
+         * up front (growing as needed) and taken from the free list in one
+         * step, in the order n acquire() calls would return them.
+         * Strong guarantee: if the pool is too small (fixed capacity) or a
+         * constructor throws, objects built so far are destroyed and no
+         * slot is taken; chunks added by growth are kept.
+         */
+        template<typename Generator>
+            requires std::invocable<Generator&, size_t>
+        LIBFTPP_POOL_ENTRY void acquireN(std::span<Object*> out, Generator&& p_generator);
+
+        /**
+         * @brief Acquire out.size() objects constructed from the elements of a range.
+         * Throws std::invalid_argument (acquiring nothing) if the range is shorter.
+         */
+        template<std::ranges::input_range Range>
+        LIBFTPP_POOL_ENTRY void acquireN(std::span<Object*> out, Range&& p_values);
+
+        /** Acquire out.size() default-constructed objects. */
+        LIBFTPP_POOL_ENTRY void acquireN(std::span<Object*> out);
+
+        /**
+         * @brief Release a batch of objects.
+         *
+         * The whole batch is validated first: a foreign object, one that
+         * is not acquired or one listed twice throws (like release()) and
+         * nothing is released.
+         */
+        void releaseN(std::span<Object* const> p_objects);
+
+        /**
+         * @brief Acquire an object and return its compact Id.
+         * Throws like acquire().
+         */
+        template<typename ... TArgs>
+        LIBFTPP_POOL_ENTRY Id acquireId(TArgs&& ... p_args);
+
+        /** Id of an acquired object (null Id if the slot is not acquired). */
+        Id idOf(const Object& p_object) const noexcept;
+
+        /** The object an Id refers to, or nullptr if the Id is null or stale. O(1). */
+        Object* lookup(Id p_id) noexcept;
+        const Object* lookup(Id p_id) const noexcept;
+
+        /** True while the object behind p_id has not been released. */
+        bool contains(Id p_id) const noexcept;
+
+        /**
+         * @brief Release the object behind an Id.
+         * Throws std::runtime_error if the Id is null or stale.
+         */
+        void release(Id p_id);
+
+        /**
+         * @brief Call fn(TType&) on every object acquired from this pool.
+         *
+         * Walks a dense array of the live slots (slot-map style), so the
+         * cost is proportional to usedCount(), not capacity(). The order
+         * is unspecified. fn must not acquire or release.
+         * Slots held by MagazinePool caches are not part of this list.
+         */
+        template<typename Fn>
+        void forEach(Fn&& fn);
+
+        /** Dense view of the live slots, in forEach() order. */
+        std::span<Object* const> liveObjects() const noexcept;
+
         /** Number of free slots available for acquire(). */
         size_t availableCount() const noexcept;
 
@@ -183,14 +344,187 @@ class Pool {
         /** Destroy constructed objects and free raw memory. */
         void clear() noexcept;
 
+        /** Backing actually used by the first chunk (Heap when empty). */
+        SlabBacking slabBacking() const noexcept;
+
+        /**
+         * @brief Enable growth mode: when exhausted, add chunks of slotsPerChunk slots.
+         *
+         * 0 (the default) keeps the capacity fixed. The setting survives
+         * resize() and clear(). New chunks use `p_backing`.
+         */
+        void setGrowth(size_t slotsPerChunk, SlabBacking p_backing = SlabBacking::Heap) noexcept;
+
+        /** Slots added per growth step (0 when the capacity is fixed). */
+        size_t growthChunk() const noexcept;
+
+        /**
+         * @brief Free every chunk whose slots are all available.
+         *
+         * Chunks are released while the capacity stays at or above
+         * minCapacity. Acquired objects are never touched.
+         * @return number of slots released
+         */
+        size_t shrink(size_t minCapacity = 0) noexcept;
+
+        /** Number of chunks currently allocated. */
+        size_t chunkCount() const noexcept;
+
+        /** Largest usedCount() observed since construction or the last reset. */
+        size_t highWaterMark() const noexcept;
+
+        /** Restart the high-water mark from the current usedCount(). */
+        void resetHighWaterMark() noexcept;
+
+        /**
+         * @brief Select the release policy (Destroy by default).
+         *
+         * Throws std::invalid_argument for Reset if TType has no reset()
+         * member. Switching back to Destroy destroys the warm free objects.
+         */
+        void setReleasePolicy(ReleasePolicy p_policy);
+
+        /** Current release policy. */
+        ReleasePolicy releasePolicy() const noexcept;
+
+# ifdef LIBFTPP_POOL_STATS
+        /**
+         * @brief Occupancy, counters and latency histograms (instrumented builds).
+         * @see PoolStats
+         */
+        PoolStats stats() const;
+
+        /** Zero the counters and histograms; the high-water mark is kept. */
+        void resetStats() noexcept;
+
+        /**
+         * @brief Describe the objects still acquired, one line each (empty if none).
+         *
+         * Printed to std::cerr when the pool is destroyed with objects
+         * still acquired. Debug builds include the acquiring call site.
+         */
+        std::string leakReport() const;
+# endif
+
     private:
 
-        // Storage for the pre-allocated objects
-        std::vector<Object> storage;
+        /** One slab and the bookkeeping of its slots. */
+        struct Chunk {
+            Chunk(unsigned char* p_slab, size_t p_bytes, SlabBacking p_backing) noexcept
+                : slab(p_slab), bytes(p_bytes), backing(p_backing), used(0) {}
+            ~Chunk() { freeSlab(slab, bytes, backing); }
+            Chunk(const Chunk&) = delete;
+            Chunk& operator=(const Chunk&) = delete;
+
+            unsigned char* slab;
+            size_t bytes;
+            SlabBacking backing;
+            std::vector<Object> objects;
+            size_t used;
+        };
+
+        /** Allocate a chunk of `slots` slots registered under `chunkId`, numbered from firstSlot. */
+        static std::unique_ptr<Chunk> makeChunk(size_t slots, SlabBacking p_backing, size_t chunkId, uint32_t firstSlot);
+
+        /** True if TType can be recycled by the Reset policy. */
+        static constexpr bool hasReset = requires (TType& value) { value.reset(); };
+
+        /** Build the object of a checked-out slot, reusing it if it is warm. */
+        template<typename ... TArgs>
+        void construct(Object& p_object, TArgs&& ... p_args);
+
+        /** End the life of a released object: reset() it or destroy it, per the policy. */
+        void retire(Object& p_object) noexcept;
+
+        /** True if p_object is one of this pool's slots. */
+        bool owns(const Object& p_object) const noexcept;
+
+        /**
+         * @brief Shared body of the acquireN() overloads.
+         * p_construct(Object& slot, i) builds object i in the slot.
+         */
+        template<typename Construct>
+        void acquireBatch(std::span<Object*> out, Construct&& p_construct, const void* caller);
+
+        /** Instrumentation hooks; empty unless LIBFTPP_POOL_STATS is defined. */
+        uint64_t statsClock() const noexcept;
+        void statsOnAcquire(std::span<Object* const> p_objects, uint64_t started, const void* caller) noexcept;
+        void statsOnRelease(std::span<Object* const> p_objects, uint64_t started) noexcept;
+        void statsOnFailure() noexcept;
+
+        /** Record a freshly acquired slot in the live list (capacity is reserved). */
+        void markLive(Object& p_object) noexcept;
+
+        /** Remove a slot from the live list and make its Ids stale. */
+        void markDead(Object& p_object) noexcept;
+
+        /** Append a chunk of growthSlots slots and make its slots available. */
+        void grow();
+
+        /** Destroy the objects still constructed in a chunk. */
+        static void destroyObjects(Chunk& p_chunk) noexcept;
+
+        /**
+         * @brief Take a free slot out of the pool (growing if allowed), no construction.
+         * @return nullptr when a fixed-capacity pool is exhausted.
+         */
+        Object* checkout();
+
+        /** Give a slot obtained with checkout() back, no destruction. */
+        void checkin(Object& p_object) noexcept;
+
+        // Magazine caches move raw slots in and out through checkout()/checkin(),
+        // outside the live list, the generations and the stats hooks
+        template <typename> friend class MagazinePool;
+
+        /** Alignment of the slab: TType's, raised to a cache line. */
+        static constexpr size_t slabAlignment() noexcept {
+            return alignof(TType) > 64 ? alignof(TType) : 64;
+        }
+
+        /** Allocate `bytes` for the slab; may downgrade `backing` to Heap. */
+        static unsigned char* allocateSlab(size_t bytes, SlabBacking& backing);
+
+        /** Free a slab returned by allocateSlab(). */
+        static void freeSlab(unsigned char* slab, size_t bytes, SlabBacking backing) noexcept;
+
+        // Chunks never move once allocated; null entries are holes left by shrink()
+        std::vector<std::unique_ptr<Chunk>> chunks;
 
         // List of free objects available for reuse
         std::vector<Object*> available;
 
+        // Total number of slots across chunks
+        size_t totalSlots = 0;
+
+        // Growth mode: slots per new chunk (0 = fixed capacity) and their backing
+        size_t growthSlots = 0;
+        SlabBacking growthBacking = SlabBacking::Heap;
+
+        // Peak usedCount()
+        size_t peakUsed = 0;
+
+        // What release() does with objects
+        ReleasePolicy policy = ReleasePolicy::Destroy;
+
+# ifdef LIBFTPP_POOL_STATS
+        // Counters and histograms; occupancy fields are filled by stats()
+        PoolStats statsCounters;
+# endif
+
+        // Slot number -> metadata; null for slots whose chunk was freed
+        std::vector<Object*> slotTable;
+
+        // Current generation of each slot number; kept across clear() and
+        // shrink() so Ids issued before stay stale when the number is reused
+        std::vector<uint32_t> generations;
+
+        // Slot-number ranges {first, count} freed by shrink(), reused by grow()
+        std::vector<std::pair<uint32_t, uint32_t>> freeSlotRanges;
+
+        // Dense list of acquired slots (Object::livePosition indexes it)
+        std::vector<Object*> live;
+
 };
 
 # include "pool.tpp"
@@ -2,11 +2,13 @@
 
 template <typename TType>
 Pool<TType>::Object::Object()
-    : object(nullptr), constructed(false), inUse(false), index(static_cast<size_t>(-1)) {}
+    : object(nullptr), constructed(false), inUse(false), index(static_cast<size_t>(-1)), chunk(static_cast<size_t>(-1))
+    , slot(0), livePosition(0) {}
 
 template <typename TType>
-Pool<TType>::Object::Object(TType * p_object, size_t p_index)
-    : object(p_object), constructed(false), inUse(false), index(p_index) {}
+Pool<TType>::Object::Object(TType * p_object, size_t p_index, size_t p_chunk)
+    : object(p_object), constructed(false), inUse(false), index(p_index), chunk(p_chunk)
+    , slot(0), livePosition(0) {}
 
 template <typename TType>
 Pool<TType>::Object::~Object() {}
@@ -34,91 +36,274 @@ Pool<TType>::Pool() noexcept {}
 
 template <typename TType>
 Pool<TType>::~Pool() noexcept {
+# ifdef LIBFTPP_POOL_STATS
+    if (!live.empty()) {
+        try {
+            std::cerr << leakReport();
+        } catch (...) {
+            // Reporting must not turn a leak into a crash
+        }
+    }
+# endif
     clear();
 }
 
 template <typename TType>
 Pool<TType>::Pool(Pool&& other) noexcept
-    : storage(std::move(other.storage))
-    , available(std::move(other.available)) {
-    // Recompute pointers in available to point into our storage
-    for (auto& ptr : available) {
-        size_t index = ptr->index;
-        ptr = &storage[index];
-    }
+    : chunks(std::move(other.chunks))
+    , available(std::move(other.available))
+    , totalSlots(other.totalSlots)
+    , growthSlots(other.growthSlots)
+    , growthBacking(other.growthBacking)
+    , peakUsed(other.peakUsed)
+    , policy(other.policy)
+# ifdef LIBFTPP_POOL_STATS
+    , statsCounters(std::exchange(other.statsCounters, PoolStats()))
+# endif
+    , slotTable(std::move(other.slotTable))
+    , generations(std::move(other.generations))
+    , freeSlotRanges(std::move(other.freeSlotRanges))
+    , live(std::move(other.live)) {
+    // Chunks live on the heap, so the pointers in available stay valid
+    other.chunks.clear();
     other.available.clear();
+    other.totalSlots = 0;
+    other.peakUsed = 0;
+    other.slotTable.clear();
+    other.generations.clear();
+    other.freeSlotRanges.clear();
+    other.live.clear();
+}
+
+template <typename TType>
+unsigned char* Pool<TType>::allocateSlab(size_t bytes, SlabBacking& p_backing) {
+    if (p_backing == SlabBacking::HugePages && slabAlignment() <= 4096) {
+        constexpr size_t hugePage = 2 * 1024 * 1024;
+        const size_t mapped = (bytes + hugePage - 1) / hugePage * hugePage;
+        void* raw = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+# ifdef MADV_HUGEPAGE
+            // Advisory only: a kernel without THP keeps regular pages
+            ::madvise(raw, mapped, MADV_HUGEPAGE);
+# endif
+            return static_cast<unsigned char*>(raw);
+        }
+    }
+    p_backing = SlabBacking::Heap;
+    return static_cast<unsigned char*>(::operator new(bytes, std::align_val_t(slabAlignment())));
+}
+
+template <typename TType>
+void Pool<TType>::freeSlab(unsigned char* p_slab, size_t bytes, SlabBacking p_backing) noexcept {
+    if (!p_slab) {
+        return;
+    }
+    if (p_backing == SlabBacking::HugePages) {
+        constexpr size_t hugePage = 2 * 1024 * 1024;
+        ::munmap(p_slab, (bytes + hugePage - 1) / hugePage * hugePage);
+    } else {
+        ::operator delete(static_cast<void*>(p_slab), std::align_val_t(slabAlignment()));
+    }
 }
 
 template <typename TType>
 void Pool<TType>::resize(const size_t& numberOfObjectsStored) {
+    resize(numberOfObjectsStored, SlabBacking::Heap);
+}
+
+template <typename TType>
+std::unique_ptr<typename Pool<TType>::Chunk> Pool<TType>::makeChunk(size_t slots, SlabBacking p_backing, size_t chunkId, uint32_t firstSlot) {
+    const size_t bytes = slots * sizeof(TType);
+    unsigned char* slab = allocateSlab(bytes, p_backing);
+    std::unique_ptr<Chunk> fresh;
+    try {
+        fresh.reset(new Chunk(slab, bytes, p_backing));
+    } catch (...) {
+        freeSlab(slab, bytes, p_backing);
+        throw;
+    }
+    // Slot addresses are computed from the index
+    fresh->objects.reserve(slots);
+    for (size_t i = 0; i < slots; ++i) {
+        fresh->objects.emplace_back(reinterpret_cast<TType*>(slab + i * sizeof(TType)), i, chunkId);
+        fresh->objects.back().slot = static_cast<uint32_t>(firstSlot + i);
+    }
+    return fresh;
+}
+
+template <typename TType>
+void Pool<TType>::resize(const size_t& numberOfObjectsStored, SlabBacking p_backing) {
     if (numberOfObjectsStored == 0) {
         throw std::invalid_argument("Pool size must be greater than 0");
     }
+    if (numberOfObjectsStored >= UINT32_MAX) {
+        throw std::length_error("Pool size exceeds the Id slot range");
+    }
+
+    // Build the new state on the side first to ensure strong exception safety
+    std::vector<std::unique_ptr<Chunk>> newChunks;
+    newChunks.push_back(makeChunk(numberOfObjectsStored, p_backing, 0, 0));
+    std::vector<Object*> newAvailable;
+    newAvailable.reserve(numberOfObjectsStored);
+    std::vector<Object*> newSlotTable;
+    newSlotTable.reserve(numberOfObjectsStored);
+    std::vector<Object*> newLive;
+    newLive.reserve(numberOfObjectsStored);
+    // Extra generations are harmless if a later step throws
+    if (generations.size() < numberOfObjectsStored) {
+        generations.resize(numberOfObjectsStored, 1);
+    }
+
+    // Push the free list in reverse so acquire() hands out slots in address order
+    std::vector<Object>& objects = newChunks.front()->objects;
+    for (size_t i = numberOfObjectsStored; i > 0; --i) {
+        newAvailable.push_back(&objects[i - 1]);
+    }
+    for (auto &obj : objects) {
+        newSlotTable.push_back(&obj);
+    }
 
     clear();
-    storage.reserve(numberOfObjectsStored);
-    available.reserve(numberOfObjectsStored);
+    chunks = std::move(newChunks);
+    available = std::move(newAvailable);
+    slotTable = std::move(newSlotTable);
+    live = std::move(newLive);
+    totalSlots = numberOfObjectsStored;
+}
 
-    // Allocate raw memory blocks first to ensure strong exception safety
-    std::vector<TType*> raws;
-    raws.reserve(numberOfObjectsStored);
-    for (size_t i = 0; i < numberOfObjectsStored; ++i) {
-        void* raw = ::operator new(sizeof(TType), std::align_val_t(alignof(TType)));
-        raws.push_back(reinterpret_cast<TType*>(raw));
+template <typename TType>
+void Pool<TType>::grow() {
+    // Reuse a hole left by shrink() so chunk ids stay small
+    size_t chunkId = 0;
+    while (chunkId < chunks.size() && chunks[chunkId]) {
+        ++chunkId;
+    }
+    // Same for slot numbers: take a range freed by shrink() if one fits
+    size_t range = 0;
+    while (range < freeSlotRanges.size() && freeSlotRanges[range].second < growthSlots) {
+        ++range;
+    }
+    const bool appendSlots = range == freeSlotRanges.size();
+    if (appendSlots && growthSlots >= UINT32_MAX - slotTable.size()) {
+        throw std::length_error("Pool size exceeds the Id slot range");
+    }
+    const uint32_t firstSlot = appendSlots ? static_cast<uint32_t>(slotTable.size())
+                                           : freeSlotRanges[range].first;
+
+    std::unique_ptr<Chunk> fresh = makeChunk(growthSlots, growthBacking, chunkId, firstSlot);
+    // Room for every slot, so checkin() never reallocates
+    available.reserve(totalSlots + growthSlots);
+    live.reserve(totalSlots + growthSlots);
+    if (appendSlots) {
+        slotTable.reserve(slotTable.size() + growthSlots);
+        if (generations.size() < slotTable.size() + growthSlots) {
+            generations.resize(slotTable.size() + growthSlots, 1);
+        }
+    }
+    if (chunkId == chunks.size()) {
+        chunks.emplace_back();
     }
 
-    // Emplace Objects that wrap the raw memory and mark them available
-    for (size_t i = 0; i < raws.size(); ++i) {
-        storage.emplace_back(raws[i], i);
-        available.push_back(&storage.back());
+    // Nothing below can throw
+    if (appendSlots) {
+        slotTable.resize(slotTable.size() + growthSlots, nullptr);
+    } else if ((freeSlotRanges[range].second -= static_cast<uint32_t>(growthSlots)) == 0) {
+        freeSlotRanges.erase(freeSlotRanges.begin() + range);
+    } else {
+        freeSlotRanges[range].first += static_cast<uint32_t>(growthSlots);
+    }
+    for (auto &obj : fresh->objects) {
+        slotTable[obj.slot] = &obj;
+    }
+    for (size_t i = growthSlots; i > 0; --i) {
+        available.push_back(&fresh->objects[i - 1]);
     }
+    chunks[chunkId] = std::move(fresh);
+    totalSlots += growthSlots;
 }
 
 template <typename TType>
-template<typename ... TArgs>
-typename Pool<TType>::Object& Pool<TType>::acquire(TArgs && ... p_args) {
+typename Pool<TType>::Object* Pool<TType>::checkout() {
     if (available.empty()) {
-        throw std::runtime_error("No available objects in the pool");
+        if (growthSlots == 0) {
+            return nullptr;
+        }
+        grow();
     }
     Object* objPtr = available.back();
     available.pop_back();
+    ++chunks[objPtr->chunk]->used;
+    const size_t used = totalSlots - available.size();
+    if (used > peakUsed) {
+        peakUsed = used;
+    }
+    return objPtr;
+}
+
+template <typename TType>
+void Pool<TType>::checkin(Object& p_object) noexcept {
+    --chunks[p_object.chunk]->used;
+    available.push_back(&p_object);
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename Pool<TType>::Object& Pool<TType>::acquire(TArgs && ... p_args) {
+    const uint64_t started = statsClock();
+    Object* objPtr = checkout();
+    if (!objPtr) {
+        statsOnFailure();
+        throw std::runtime_error("No available objects in the pool");
+    }
     if (objPtr->inUse) {
         // Should not happen, but guard anyway
-        available.push_back(objPtr);
+        checkin(*objPtr);
         throw std::runtime_error("Pool internal error: acquiring an already in-use object");
     }
     try {
-        // Placement-new into the pre-allocated memory
-        new (objPtr->object) TType(std::forward<TArgs>(p_args)...);
-        objPtr->constructed = true;
-        objPtr->inUse = true;
+        // Placement-new into the pre-allocated memory (or reuse a warm object)
+        construct(*objPtr, std::forward<TArgs>(p_args)...);
     } catch (...) {
         // restore availability
-        available.push_back(objPtr);
+        checkin(*objPtr);
+        statsOnFailure();
         throw;
     }
+    objPtr->inUse = true;
+    markLive(*objPtr);
+    statsOnAcquire(std::span<Object* const>(&objPtr, 1), started, LIBFTPP_POOL_CALLER());
     return *objPtr;
 }
 
 template <typename TType>
 template<typename ... TArgs>
 typename Pool<TType>::Object* Pool<TType>::try_acquire(TArgs && ... p_args) noexcept {
-    if (available.empty())
+    const uint64_t started = statsClock();
+    Object* objPtr = nullptr;
+    try {
+        objPtr = checkout();
+    } catch (...) {
+        statsOnFailure();
         return nullptr;
-    Object* objPtr = available.back();
-    available.pop_back();
+    }
+    if (!objPtr) {
+        statsOnFailure();
+        return nullptr;
+    }
     if (objPtr->inUse) {
-        available.push_back(objPtr);
+        checkin(*objPtr);
         return nullptr;
     }
     try {
-        new (objPtr->object) TType(std::forward<TArgs>(p_args)...);
-        objPtr->constructed = true;
-        objPtr->inUse = true;
+        construct(*objPtr, std::forward<TArgs>(p_args)...);
     } catch (...) {
-        available.push_back(objPtr);
+        checkin(*objPtr);
+        statsOnFailure();
         return nullptr;
     }
+    objPtr->inUse = true;
+    markLive(*objPtr);
+    statsOnAcquire(std::span<Object* const>(&objPtr, 1), started, LIBFTPP_POOL_CALLER());
     return objPtr;
 }
 
@@ -126,6 +311,9 @@ template <typename TType>
 template<typename ... TArgs>
 typename Pool<TType>::Handle Pool<TType>::acquireHandle(TArgs && ... p_args) {
     Object &obj = acquire(std::forward<TArgs>(p_args)...);
+# ifdef LIBFTPP_POOL_CALL_SITES
+    obj.acquiredFrom = LIBFTPP_POOL_CALLER();
+# endif
     return Handle(this, &obj);
 }
 
@@ -195,10 +383,175 @@ bool Pool<TType>::Handle::valid() const noexcept {
     return pool != nullptr && obj != nullptr && obj->inUse;
 }
 
+template <typename TType>
+typename Pool<TType>::Id Pool<TType>::Handle::id() const noexcept {
+    return (pool && obj) ? pool->idOf(*obj) : Id{};
+}
+
+template <typename TType>
+template<typename ... TArgs>
+void Pool<TType>::construct(Object& p_object, TArgs&& ... p_args) {
+    if (p_object.constructed) {
+        // Warm object kept by the Reset policy
+        if constexpr (sizeof...(TArgs) == 0) {
+            return;
+        } else if constexpr (requires (TType& value, TArgs&& ... args) { value.reset(std::forward<TArgs>(args)...); }) {
+            try {
+                p_object.object->reset(std::forward<TArgs>(p_args)...);
+                return;
+            } catch (...) {
+                p_object.object->~TType();
+                p_object.constructed = false;
+                throw;
+            }
+        } else {
+            p_object.object->~TType();
+            p_object.constructed = false;
+        }
+    }
+    new (p_object.object) TType(std::forward<TArgs>(p_args)...);
+    p_object.constructed = true;
+}
+
+template <typename TType>
+void Pool<TType>::retire(Object& p_object) noexcept {
+    if (!p_object.constructed) {
+        return;
+    }
+    if constexpr (hasReset) {
+        if (policy == ReleasePolicy::Reset) {
+            try {
+                p_object.object->reset();
+                return;
+            } catch (...) {
+                // Destroyed below; the slot is rebuilt on its next acquire()
+            }
+        }
+    }
+    p_object.object->~TType();
+    p_object.constructed = false;
+}
+
+template <typename TType>
+bool Pool<TType>::owns(const Object& p_object) const noexcept {
+    return p_object.chunk < chunks.size() && chunks[p_object.chunk]
+        && p_object.index < chunks[p_object.chunk]->objects.size()
+        && &chunks[p_object.chunk]->objects[p_object.index] == &p_object;
+}
+
+template <typename TType>
+template<typename Construct>
+void Pool<TType>::acquireBatch(std::span<Object*> out, Construct&& p_construct, const void* caller) {
+    const size_t count = out.size();
+    if (count == 0) {
+        return;
+    }
+    const uint64_t started = statsClock();
+    try {
+        while (available.size() < count) {
+            if (growthSlots == 0) {
+                throw std::runtime_error("Not enough available objects in the pool");
+            }
+            grow();
+        }
+    } catch (...) {
+        statsOnFailure();
+        throw;
+    }
+
+    // The batch is the top of the free list; it stays there until every
+    // object is built, so a throwing constructor leaves the list untouched
+    const size_t top = available.size();
+    size_t built = 0;
+    try {
+        for (; built < count; ++built) {
+            p_construct(*available[top - 1 - built], built);
+        }
+    } catch (...) {
+        while (built > 0) {
+            --built;
+            retire(*available[top - 1 - built]);
+        }
+        statsOnFailure();
+        throw;
+    }
+
+    // Nothing below can throw
+    for (size_t i = 0; i < count; ++i) {
+        Object* objPtr = available[top - 1 - i];
+        objPtr->inUse = true;
+        ++chunks[objPtr->chunk]->used;
+        markLive(*objPtr);
+        out[i] = objPtr;
+    }
+    available.resize(top - count);
+    const size_t used = totalSlots - available.size();
+    if (used > peakUsed) {
+        peakUsed = used;
+    }
+    statsOnAcquire(out, started, caller);
+}
+
+template <typename TType>
+template<typename Generator>
+    requires std::invocable<Generator&, size_t>
+void Pool<TType>::acquireN(std::span<Object*> out, Generator&& p_generator) {
+    acquireBatch(out, [&](Object& slot, size_t i) {
+        construct(slot, p_generator(i));
+    }, LIBFTPP_POOL_CALLER());
+}
+
+template <typename TType>
+template<std::ranges::input_range Range>
+void Pool<TType>::acquireN(std::span<Object*> out, Range&& p_values) {
+    auto it = std::ranges::begin(p_values);
+    auto end = std::ranges::end(p_values);
+    acquireBatch(out, [&](Object& slot, size_t) {
+        if (it == end) {
+            throw std::invalid_argument("Range is shorter than the batch");
+        }
+        construct(slot, *it);
+        ++it;
+    }, LIBFTPP_POOL_CALLER());
+}
+
+template <typename TType>
+void Pool<TType>::acquireN(std::span<Object*> out) {
+    acquireBatch(out, [this](Object& slot, size_t) {
+        construct(slot);
+    }, LIBFTPP_POOL_CALLER());
+}
+
+template <typename TType>
+void Pool<TType>::releaseN(std::span<Object* const> p_objects) {
+    // Clearing inUse while validating also catches an object listed twice
+    for (size_t i = 0; i < p_objects.size(); ++i) {
+        Object* objPtr = p_objects[i];
+        const bool foreign = !objPtr || !owns(*objPtr);
+        if (foreign || !objPtr->inUse) {
+            for (size_t k = 0; k < i; ++k) {
+                p_objects[k]->inUse = true;
+            }
+            if (foreign) {
+                throw std::invalid_argument("Attempting to release an object that does not belong to this pool");
+            }
+            throw std::runtime_error("Double release detected or object not acquired");
+        }
+        objPtr->inUse = false;
+    }
+    const uint64_t started = statsClock();
+    for (Object* objPtr : p_objects) {
+        retire(*objPtr);
+        markDead(*objPtr);
+        checkin(*objPtr);
+    }
+    statsOnRelease(p_objects, started);
+}
+
 template <typename TType>
 void Pool<TType>::release(typename Pool<TType>::Object & p_object) {
     // Validate that p_object belongs to this pool
-    if (p_object.index >= storage.size() || &storage[p_object.index] != &p_object) {
+    if (!owns(p_object)) {
         throw std::invalid_argument("Attempting to release an object that does not belong to this pool");
     }
 
@@ -206,12 +559,95 @@ void Pool<TType>::release(typename Pool<TType>::Object & p_object) {
         throw std::runtime_error("Double release detected or object not acquired");
     }
 
-    if (p_object.constructed) {
-        p_object.object->~TType();
-        p_object.constructed = false;
-    }
+    const uint64_t started = statsClock();
+    retire(p_object);
     p_object.inUse = false;
-    available.push_back(&p_object);
+    markDead(p_object);
+    checkin(p_object);
+    Object* released = &p_object;
+    statsOnRelease(std::span<Object* const>(&released, 1), started);
+}
+
+template <typename TType>
+void Pool<TType>::markLive(Object& p_object) noexcept {
+    p_object.livePosition = static_cast<uint32_t>(live.size());
+    live.push_back(&p_object);
+}
+
+template <typename TType>
+void Pool<TType>::markDead(Object& p_object) noexcept {
+    // Swap-remove keeps the live list dense
+    Object* last = live.back();
+    live[p_object.livePosition] = last;
+    last->livePosition = p_object.livePosition;
+    live.pop_back();
+    // Generation 0 is reserved for the null Id
+    uint32_t& generation = generations[p_object.slot];
+    if (++generation == 0) {
+        generation = 1;
+    }
+}
+
+template <typename TType>
+template<typename ... TArgs>
+typename Pool<TType>::Id Pool<TType>::acquireId(TArgs && ... p_args) {
+    Object &obj = acquire(std::forward<TArgs>(p_args)...);
+# ifdef LIBFTPP_POOL_CALL_SITES
+    obj.acquiredFrom = LIBFTPP_POOL_CALLER();
+# endif
+    return idOf(obj);
+}
+
+template <typename TType>
+typename Pool<TType>::Id Pool<TType>::idOf(const Object& p_object) const noexcept {
+    if (!p_object.inUse || p_object.slot >= slotTable.size() || slotTable[p_object.slot] != &p_object) {
+        return Id{};
+    }
+    return Id{p_object.slot, generations[p_object.slot]};
+}
+
+template <typename TType>
+typename Pool<TType>::Object* Pool<TType>::lookup(Id p_id) noexcept {
+    if (p_id.slot >= slotTable.size()) {
+        return nullptr;
+    }
+    Object* obj = slotTable[p_id.slot];
+    if (!obj || !obj->inUse || generations[p_id.slot] != p_id.generation) {
+        return nullptr;
+    }
+    return obj;
+}
+
+template <typename TType>
+const typename Pool<TType>::Object* Pool<TType>::lookup(Id p_id) const noexcept {
+    return const_cast<Pool*>(this)->lookup(p_id);
+}
+
+template <typename TType>
+bool Pool<TType>::contains(Id p_id) const noexcept {
+    return lookup(p_id) != nullptr;
+}
+
+template <typename TType>
+void Pool<TType>::release(Id p_id) {
+    Object* obj = lookup(p_id);
+    if (!obj) {
+        throw std::runtime_error("Releasing a null or stale pool Id");
+    }
+    release(*obj);
+}
+
+template <typename TType>
+template<typename Fn>
+void Pool<TType>::forEach(Fn&& fn) {
+    for (Object* obj : live) {
+        fn(*obj->object);
+    }
+}
+
+template <typename TType>
+std::span<typename Pool<TType>::Object* const> Pool<TType>::liveObjects() const noexcept {
+    return std::span<Object* const>(live.data(), live.size());
 }
 
 template <typename TType>
@@ -221,42 +657,257 @@ size_t Pool<TType>::availableCount() const noexcept {
 
 template <typename TType>
 size_t Pool<TType>::usedCount() const noexcept {
-    return storage.size() - available.size();
+    return totalSlots - available.size();
 }
 
 template <typename TType>
 size_t Pool<TType>::capacity() const noexcept {
-    return storage.size();
+    return totalSlots;
 }
 
 template <typename TType>
 Pool<TType>& Pool<TType>::operator=(Pool&& other) noexcept {
     if (this != &other) {
         clear();
-        storage = std::move(other.storage);
+        chunks = std::move(other.chunks);
         available = std::move(other.available);
-        for (auto& ptr : available) {
-            size_t index = ptr->index;
-            ptr = &storage[index];
-        }
+        totalSlots = other.totalSlots;
+        growthSlots = other.growthSlots;
+        growthBacking = other.growthBacking;
+        peakUsed = other.peakUsed;
+        policy = other.policy;
+# ifdef LIBFTPP_POOL_STATS
+        // The counters describe the slabs: they follow them
+        statsCounters = std::exchange(other.statsCounters, PoolStats());
+# endif
+        slotTable = std::move(other.slotTable);
+        generations = std::move(other.generations);
+        freeSlotRanges = std::move(other.freeSlotRanges);
+        live = std::move(other.live);
+        other.chunks.clear();
         other.available.clear();
+        other.totalSlots = 0;
+        other.peakUsed = 0;
+        other.slotTable.clear();
+        other.generations.clear();
+        other.freeSlotRanges.clear();
+        other.live.clear();
     }
     return *this;
 }
 
+template <typename TType>
+void Pool<TType>::destroyObjects(Chunk& p_chunk) noexcept {
+    for (auto &obj : p_chunk.objects) {
+        if (obj.constructed) {
+            obj.object->~TType();
+            obj.constructed = false;
+        }
+        obj.object = nullptr;
+        obj.inUse = false;
+    }
+    p_chunk.used = 0;
+}
+
 template <typename TType>
 void Pool<TType>::clear() noexcept {
-    for (auto &obj : storage) {
-        if (obj.object) {
-            if (obj.constructed) {
-                obj.object->~TType();
-                obj.constructed = false;
-            }
-            ::operator delete(static_cast<void*>(obj.object), std::align_val_t(alignof(TType)));
-            obj.object = nullptr;
-            obj.inUse = false;
+    // Ids of the objects destroyed here must not match the slot's next user
+    for (Object* obj : live) {
+        uint32_t& generation = generations[obj->slot];
+        if (++generation == 0) {
+            generation = 1;
         }
     }
-    storage.clear();
+    for (auto &chunk : chunks) {
+        if (chunk) {
+            destroyObjects(*chunk);
+        }
+    }
+    chunks.clear();
     available.clear();
+    slotTable.clear();
+    freeSlotRanges.clear();
+    live.clear();
+    totalSlots = 0;
+}
+
+template <typename TType>
+typename Pool<TType>::SlabBacking Pool<TType>::slabBacking() const noexcept {
+    for (const auto &chunk : chunks) {
+        if (chunk) {
+            return chunk->backing;
+        }
+    }
+    return SlabBacking::Heap;
+}
+
+template <typename TType>
+void Pool<TType>::setGrowth(size_t slotsPerChunk, SlabBacking p_backing) noexcept {
+    growthSlots = slotsPerChunk;
+    growthBacking = p_backing;
+}
+
+template <typename TType>
+size_t Pool<TType>::growthChunk() const noexcept {
+    return growthSlots;
+}
+
+template <typename TType>
+size_t Pool<TType>::shrink(size_t minCapacity) noexcept {
+    size_t released = 0;
+    for (size_t id = 0; id < chunks.size(); ++id) {
+        std::unique_ptr<Chunk>& chunk = chunks[id];
+        if (!chunk || chunk->used != 0) {
+            continue;
+        }
+        const size_t slots = chunk->objects.size();
+        if (totalSlots - slots < minCapacity) {
+            continue;
+        }
+        // Forget the chunk's free slots, then give its memory back
+        available.erase(std::remove_if(available.begin(), available.end(),
+            [id](Object* obj) { return obj->chunk == id; }),
+            available.end());
+        for (auto &obj : chunk->objects) {
+            slotTable[obj.slot] = nullptr;
+        }
+        try {
+            freeSlotRanges.emplace_back(chunk->objects.front().slot, static_cast<uint32_t>(slots));
+        } catch (...) {
+            // Out of memory: these slot numbers are simply never reused
+        }
+        destroyObjects(*chunk);
+        chunk.reset();
+        totalSlots -= slots;
+        released += slots;
+    }
+    while (!chunks.empty() && !chunks.back()) {
+        chunks.pop_back();
+    }
+    return released;
+}
+
+template <typename TType>
+size_t Pool<TType>::chunkCount() const noexcept {
+    size_t count = 0;
+    for (const auto &chunk : chunks) {
+        if (chunk) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+template <typename TType>
+size_t Pool<TType>::highWaterMark() const noexcept {
+    return peakUsed;
+}
+
+template <typename TType>
+void Pool<TType>::resetHighWaterMark() noexcept {
+    peakUsed = usedCount();
+}
+
+template <typename TType>
+void Pool<TType>::setReleasePolicy(ReleasePolicy p_policy) {
+    if (p_policy == ReleasePolicy::Reset && !hasReset) {
+        throw std::invalid_argument("Reset policy requires a TType::reset() member");
+    }
+    policy = p_policy;
+    if (policy == ReleasePolicy::Destroy) {
+        for (Object* obj : available) {
+            if (obj->constructed) {
+                obj->object->~TType();
+                obj->constructed = false;
+            }
+        }
+    }
+}
+
+template <typename TType>
+typename Pool<TType>::ReleasePolicy Pool<TType>::releasePolicy() const noexcept {
+    return policy;
+}
+
+template <typename TType>
+uint64_t Pool<TType>::statsClock() const noexcept {
+# ifdef LIBFTPP_POOL_STATS
+    return pool_stats_now();
+# else
+    return 0;
+# endif
+}
+
+template <typename TType>
+void Pool<TType>::statsOnAcquire(std::span<Object* const> p_objects, uint64_t started, const void* caller) noexcept {
+# ifdef LIBFTPP_POOL_STATS
+    const uint64_t now = pool_stats_now();
+    statsCounters.acquires += p_objects.size();
+    statsCounters.acquireLatency.record(now - started);
+    for (Object* obj : p_objects) {
+        obj->acquiredAt = now;
+#  ifdef LIBFTPP_POOL_CALL_SITES
+        obj->acquiredFrom = caller;
+#  endif
+    }
+# endif
+    (void)p_objects;
+    (void)started;
+    (void)caller;
+}
+
+template <typename TType>
+void Pool<TType>::statsOnRelease(std::span<Object* const> p_objects, uint64_t started) noexcept {
+# ifdef LIBFTPP_POOL_STATS
+    const uint64_t now = pool_stats_now();
+    statsCounters.releases += p_objects.size();
+    statsCounters.releaseLatency.record(now - started);
+    for (Object* obj : p_objects) {
+        statsCounters.totalLifetimeNs += now - obj->acquiredAt;
+    }
+# endif
+    (void)p_objects;
+    (void)started;
+}
+
+template <typename TType>
+void Pool<TType>::statsOnFailure() noexcept {
+# ifdef LIBFTPP_POOL_STATS
+    ++statsCounters.failedAcquires;
+# endif
+}
+
+# ifdef LIBFTPP_POOL_STATS
+template <typename TType>
+PoolStats Pool<TType>::stats() const {
+    PoolStats snapshot = statsCounters;
+    snapshot.used = usedCount();
+    snapshot.peak = peakUsed;
+    snapshot.capacity = totalSlots;
+    return snapshot;
+}
+
+template <typename TType>
+void Pool<TType>::resetStats() noexcept {
+    statsCounters = PoolStats();
+}
+
+template <typename TType>
+std::string Pool<TType>::leakReport() const {
+    if (live.empty()) {
+        return std::string();
+    }
+    std::ostringstream out;
+    const uint64_t now = pool_stats_now();
+    out << "Pool: " << live.size() << " object(s) still acquired (capacity "
+        << totalSlots << ", peak " << peakUsed << ")\n";
+    for (const Object* obj : live) {
+        out << "  slot " << obj->slot << ", held for " << (now - obj->acquiredAt) << " ns";
+#  ifdef LIBFTPP_POOL_CALL_SITES
+        out << ", acquired from " << obj->acquiredFrom;
+#  endif
+        out << "\n";
+    }
+    return out.str();
 }
+# endif
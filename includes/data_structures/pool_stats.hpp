@@ -0,0 +1,107 @@
+#ifndef POOL_STATS_HPP
+# define POOL_STATS_HPP
+
+# include <bit>
+# include <cstddef>
+# include <cstdint>
+# include <string>
+
+// Pool instrumentation. Define LIBFTPP_POOL_STATS at compile time (for the
+// whole program: it changes the layout of Pool) to enable Pool::stats() and
+// the leak report printed when a Pool is destroyed with objects still
+// acquired; 'make POOL_STATS=1' does so for libftpp.a and the tests. Without
+// it none of this is compiled into Pool.
+//
+// In debug builds (NDEBUG not defined) each acquired slot also records the
+// address of its acquiring call site; resolve it with addr2line.
+# if defined(LIBFTPP_POOL_STATS) && !defined(NDEBUG)
+#  define LIBFTPP_POOL_CALL_SITES
+#  define LIBFTPP_POOL_CALLER() __builtin_return_address(0)
+// Keep the entry points out of line so the return address is the caller's
+#  define LIBFTPP_POOL_ENTRY __attribute__((noinline))
+# else
+#  define LIBFTPP_POOL_CALLER() nullptr
+#  define LIBFTPP_POOL_ENTRY
+# endif
+
+/**
+ * @brief Log2-bucketed latency histogram, in nanoseconds.
+ *
+ * Bucket i counts samples in [2^i, 2^(i+1)) ns (bucket 0 also holds 0 ns);
+ * the last bucket absorbs everything above. Recording is a bit_width and
+ * an increment.
+ */
+class PoolLatencyHistogram {
+
+    public:
+        static constexpr size_t BUCKETS = 32;
+
+        void record(uint64_t nanoseconds) noexcept {
+            size_t bucket = static_cast<size_t>(std::bit_width(nanoseconds));
+            bucket = bucket == 0 ? 0 : bucket - 1;
+            ++counts[bucket < BUCKETS ? bucket : BUCKETS - 1];
+            ++total;
+        }
+
+        /** Number of recorded samples. */
+        uint64_t count() const noexcept { return total; }
+
+        /** Samples in bucket i. */
+        uint64_t bucket(size_t i) const noexcept { return i < BUCKETS ? counts[i] : 0; }
+
+        /**
+         * @brief Upper bound (exclusive) of the bucket holding the p-quantile.
+         * @param p quantile in [0, 1], e.g. 0.99
+         * @return 0 when empty
+         */
+        uint64_t percentile(double p) const noexcept;
+
+        void clear() noexcept;
+
+    private:
+        uint64_t counts[BUCKETS] = {};
+        uint64_t total = 0;
+};
+
+/**
+ * @brief Snapshot returned by Pool::stats().
+ *
+ * Counters cover the Pool's own acquire/release paths (single, batch,
+ * Handle and Id variants); a batch counts one latency sample per call.
+ */
+struct PoolStats {
+    /** usedCount() when the snapshot was taken. */
+    size_t used = 0;
+
+    /** highWaterMark() when the snapshot was taken. */
+    size_t peak = 0;
+
+    /** capacity() when the snapshot was taken. */
+    size_t capacity = 0;
+
+    /** Objects handed out. */
+    uint64_t acquires = 0;
+
+    /** Objects given back. */
+    uint64_t releases = 0;
+
+    /** Acquire calls that failed: pool exhausted or constructor threw. */
+    uint64_t failedAcquires = 0;
+
+    PoolLatencyHistogram acquireLatency;
+    PoolLatencyHistogram releaseLatency;
+
+    /** Summed acquire-to-release time of the released objects. */
+    uint64_t totalLifetimeNs = 0;
+
+    /** Mean object lifetime in nanoseconds (0 before the first release). */
+    double averageLifetimeNs() const noexcept;
+
+    /** One-paragraph human-readable summary. */
+    std::string toString() const;
+};
+
+/** Monotonic clock reading used by the Pool instrumentation. */
+uint64_t pool_stats_now() noexcept;
+
+#endif // POOL_STATS_HPP
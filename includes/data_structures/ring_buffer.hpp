@@ -0,0 +1,144 @@
+#ifndef RING_BUFFER_HPP
+# define RING_BUFFER_HPP
+
+# include <cstddef>
+# include <cstdint>
+# include <sys/uio.h>
+
+/**
+ * @file ring_buffer.hpp
+ * @brief Growable circular byte queue with iovec access to both ends.
+ *
+ * Bytes are appended at the tail and consumed from the head without ever
+ * shifting what is queued, so a queue that is drained a little at a time
+ * (a socket accepting part of a write) costs O(bytes consumed), not
+ * O(bytes queued). The queued bytes are exposed as at most two iovecs,
+ * ready for writev()/sendmsg(); the free space is exposed the same way
+ * for readv().
+ */
+
+/**
+ * @class RingBuffer
+ * @brief FIFO of bytes over a power-of-two circular array.
+ *
+ * The capacity doubles when a write does not fit; growing linearizes the
+ * queued bytes at the start of the new array. Not thread-safe.
+ *
+ * @code{.cpp}
+ * RingBuffer out;
+ * out.write(frame, frameSize);
+ * iovec iov[2];
+ * ssize_t w = ::writev(fd, iov, static_cast<int>(out.readable(iov)));
+ * if (w > 0) out.consume(static_cast<size_t>(w));
+ * @endcode
+ */
+class RingBuffer {
+
+    public:
+        /** Construct an empty buffer; storage is allocated on first write. */
+        RingBuffer() noexcept;
+
+        /** Construct an empty buffer holding at least `capacity` bytes. */
+        explicit RingBuffer(size_t capacity);
+
+        ~RingBuffer();
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        RingBuffer(RingBuffer&& other) noexcept;
+        RingBuffer& operator=(RingBuffer&& other) noexcept;
+
+        /** Number of queued bytes. */
+        size_t size() const noexcept;
+
+        /** True if nothing is queued. */
+        bool empty() const noexcept;
+
+        /** Bytes the buffer holds without growing. */
+        size_t capacity() const noexcept;
+
+        /** Grow so that at least `n` more bytes fit without reallocating. */
+        void reserve(size_t n);
+
+        /**
+         * @brief Make the n bytes from the head contiguous, counting both
+         *        the queued bytes and those still to be written after them.
+         *
+         * Grows if n exceeds the capacity; otherwise moves the queued bytes
+         * to the start of the array when the range would wrap. Used to
+         * receive a record in one piece, e.g. a frame whose start is queued.
+         */
+        void makeContiguous(size_t n);
+
+        /** Append n bytes at the tail, growing if needed. */
+        void write(const void* src, size_t n);
+
+        /**
+         * @brief Copy n queued bytes starting `offset` bytes after the head.
+         * @throws std::out_of_range if fewer than offset + n bytes are queued.
+         */
+        void peek(void* dst, size_t n, size_t offset = 0) const;
+
+        /**
+         * @brief Pointer to n queued bytes starting `offset` bytes after the
+         *        head, or nullptr if they wrap around the end of the array
+         *        (or are not all queued).
+         *
+         * Valid until the next write, reserve() or writable() call.
+         */
+        const uint8_t* contiguous(size_t offset, size_t n) const noexcept;
+
+        /**
+         * @brief Copy then consume the n bytes at the head.
+         * @throws std::out_of_range if fewer than n bytes are queued.
+         */
+        void read(void* dst, size_t n);
+
+        /**
+         * @brief Drop n bytes from the head.
+         * @throws std::out_of_range if fewer than n bytes are queued.
+         */
+        void consume(size_t n);
+
+        /**
+         * @brief Describe the queued bytes, head first.
+         * @param out receives up to two entries
+         * @return number of entries filled (0 when empty)
+         */
+        size_t readable(iovec out[2]) const noexcept;
+
+        /**
+         * @brief Describe the free space after the tail, growing first so
+         *        that at least `atLeast` bytes are free.
+         *
+         * Data written there becomes queued with commit().
+         * @param out receives up to two entries
+         * @return number of entries filled
+         */
+        size_t writable(iovec out[2], size_t atLeast = 1);
+
+        /** Queue n bytes written into the space returned by writable(). */
+        void commit(size_t n);
+
+        /** Drop every queued byte (storage is kept). */
+        void clear() noexcept;
+
+        /** Free the storage if nothing is queued. */
+        void shrink() noexcept;
+
+    private:
+
+        /** Reallocate to a power of two of at least `minimum` bytes. */
+        void grow(size_t minimum);
+
+        /** Move the queued bytes to the start of a new array of `capacity` bytes. */
+        void relocate(size_t capacity);
+
+        uint8_t* m_data;            // Tableau circulaire (nullptr tant que rien n'est écrit)
+        size_t m_capacity;          // Taille du tableau, toujours une puissance de deux
+        size_t m_head;              // Index du premier octet en file
+        size_t m_size;              // Nombre d'octets en file
+};
+
+#endif // RING_BUFFER_HPP
@@ -0,0 +1,159 @@
+#ifndef SEGMENTED_BUFFER_HPP
+# define SEGMENTED_BUFFER_HPP
+
+# include <vector>
+# include <cstring>
+# include <stdexcept>
+# include <type_traits>
+# include <string>
+# include <cstdint>
+# include <cstddef>
+# include <sys/uio.h>
+# include "data_structures/data_buffer.hpp"
+# include "data_structures/pool.hpp"
+
+/**
+ * @file segmented_buffer.hpp
+ * @brief Chunked binary buffer that never moves bytes once written.
+ *
+ * SegmentedBuffer is the scatter-gather counterpart of DataBuffer: data is
+ * appended into a chain of fixed-size segments, so growing the buffer only
+ * adds a segment and never copies what was already written. The segments
+ * can be exported as an iovec array and handed to writev()/sendmsg().
+ *
+ * The wire format of operator<< / operator>> is identical to DataBuffer,
+ * including the size_t length prefix used for std::string.
+ */
+
+/**
+ * @class SegmentedBuffer
+ * @brief Append-only chain of fixed-size segments with iovec export.
+ *
+ * Segments come from the heap by default, or from a Pool<Segment> given at
+ * construction. When the pool is exhausted the buffer falls back to the heap
+ * transparently. The pool must outlive every buffer drawing from it.
+ *
+ * @code{.cpp}
+ * SegmentedBuffer::SegmentPool segments;
+ * segments.resize(64);
+ * SegmentedBuffer big(segments);
+ * big.write(blob.data(), blob.size());
+ * client.send(MSG_SNAPSHOT, big);   // header + segments in one sendmsg()
+ * @endcode
+ */
+class SegmentedBuffer {
+
+    public:
+        /** Size in bytes of every segment. */
+        static constexpr size_t SEGMENT_SIZE = 4096;
+
+        /** Storage unit handed out by a SegmentPool. */
+        struct Segment {
+            // User-provided so Pool::acquire() does not zero-fill the bytes
+            Segment() {}
+            alignas(std::max_align_t) uint8_t bytes[SEGMENT_SIZE];
+        };
+
+        using SegmentPool = Pool<Segment>;
+
+        /** Construct an empty buffer drawing segments from the heap. */
+        SegmentedBuffer() noexcept;
+
+        /** Construct an empty buffer drawing segments from `pool` first. */
+        explicit SegmentedBuffer(SegmentPool& pool) noexcept;
+
+        /** Destructor: returns every segment to its origin. */
+        ~SegmentedBuffer();
+
+        SegmentedBuffer(const SegmentedBuffer&) = delete;
+        SegmentedBuffer& operator=(const SegmentedBuffer&) = delete;
+
+        SegmentedBuffer(SegmentedBuffer&& other) noexcept;
+        SegmentedBuffer& operator=(SegmentedBuffer&& other) noexcept;
+
+        /** Number of bytes written. */
+        size_t size() const noexcept;
+
+        /** True if nothing has been written. */
+        bool empty() const noexcept;
+
+        /** Number of segments currently held. */
+        size_t segmentCount() const noexcept;
+
+        /** Current read position (offset in bytes from the start). */
+        size_t readPosition() const noexcept;
+
+        /** Reset read position to zero (allow rereading). */
+        void rewind() noexcept;
+
+        /** Drop all data and give every segment back. */
+        void clear() noexcept;
+
+        /** Append n raw bytes, spilling over as many segments as needed. */
+        void write(const void* src, size_t n);
+
+        /**
+         * @brief Copy the next n bytes into dst, crossing segment boundaries.
+         * @throws std::out_of_range if fewer than n bytes remain.
+         */
+        void read(void* dst, size_t n);
+
+        /**
+         * @brief Describe the written bytes as one iovec per segment.
+         *
+         * Entries are appended to `out`; the returned pointers stay valid
+         * as long as the buffer is neither cleared nor destroyed (further
+         * writes never move existing bytes).
+         * @return number of entries appended.
+         */
+        size_t exportIovecs(std::vector<iovec>& out) const;
+
+        /** Convenience wrapper returning a fresh iovec array. */
+        std::vector<iovec> iovecs() const;
+
+        /** Append every written byte to a contiguous DataBuffer. */
+        void copyTo(DataBuffer& out) const;
+
+        template<typename T>
+        SegmentedBuffer& operator<<(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "Type must be trivially copyable for binary serialization");
+            write(&value, sizeof(T));
+            return *this;
+        }
+
+        template<typename T>
+        SegmentedBuffer& operator>>(T& value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "Type must be trivially copyable for binary deserialization");
+            read(&value, sizeof(T));
+            return *this;
+        }
+
+        // Same encoding as DataBuffer: size_t length then bytes
+        SegmentedBuffer& operator<<(const std::string& str);
+        SegmentedBuffer& operator>>(std::string& str);
+
+    private:
+
+        struct Chunk {
+            uint8_t* data;                  // Start of the segment bytes
+            size_t used;                    // Bytes written in this segment
+            SegmentPool::Object* pooled;    // Owning pool slot, nullptr for heap segments
+        };
+
+        /** Append a fresh segment from the pool or the heap. */
+        void addSegment();
+
+        /** Return one segment to wherever it came from. */
+        void releaseSegment(Chunk& chunk) noexcept;
+
+        std::vector<Chunk> m_chunks;      // Descripteurs des segments (les bytes ne bougent jamais)
+        SegmentPool* m_pool;              // Pool optionnel pour les segments
+        size_t m_size;                    // Taille totale écrite
+        size_t m_readPosition;            // Position de lecture globale
+        size_t m_readChunk;               // Segment contenant la position de lecture
+        size_t m_readOffset;              // Offset dans ce segment
+};
+
+#endif // SEGMENTED_BUFFER_HPP
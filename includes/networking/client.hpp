@@ -11,6 +11,7 @@
 #include <map>
 #include <atomic>
 #include "networking/message.hpp"
+#include "data_structures/segmented_buffer.hpp"
 
 /**
  * @file includes/networking/client.hpp
@@ -24,7 +25,8 @@
  *
  * Design notes:
  * - Messages are framed on the wire as: [uint32_t len][int32_t type][payload]
- *   where len and type are in network byte order.
+ *   where len and type are in network byte order. The high bit of len marks
+ *   an LZ-compressed payload (see networking/compression.hpp).
  * - Handlers are invoked from update(), not the reader thread. This keeps
  *   handler code single-threaded and avoids locking issues inside user code.
  * - The class is intentionally small and not feature-complete (no reconnect,
@@ -64,9 +66,53 @@ public:
      * @brief Send a message to the connected server.
      *
      * If the socket is closed this is a no-op.
+     * @throws std::length_error if the payload exceeds MAX_FRAME_SIZE.
      */
     void send(const Message& message);
 
+    /**
+     * @brief Send a frame whose payload lives in a SegmentedBuffer.
+     *
+     * The frame header and every segment are handed to sendmsg() as one
+     * iovec array, so the payload is never copied into a framing buffer.
+     * The receiver gets an ordinary Message of type messageType.
+     */
+    void send(const Message::Type& messageType, const SegmentedBuffer& payload);
+
+    /**
+     * @brief Send several messages with one gather write.
+     *
+     * Headers and payloads of every frame go into a single iovec array, so
+     * a burst of small messages costs one sendmsg() instead of one each.
+     */
+    void sendBatch(const std::vector<Message>& messages);
+
+    /**
+     * @brief TCP_NODELAY on the connection (off by default).
+     *
+     * Applied at once when connected, and by every later connect().
+     */
+    void setNoDelay(bool enabled);
+
+    /**
+     * @brief TCP_CORK on the connection (off by default).
+     *
+     * While corked the kernel only sends full segments; uncork to push out
+     * the remainder of a burst. Applied like setNoDelay().
+     */
+    void setCork(bool enabled);
+
+    /**
+     * @brief Compress outgoing payloads of at least `bytes` bytes.
+     *
+     * 0 (the default) disables compression. Compressed frames are decoded
+     * transparently by Client and Server, whatever their own threshold.
+     */
+    void setCompressionThreshold(size_t bytes);
+
+    /** Current compression threshold (0 when disabled). */
+    size_t compressionThreshold() const;
+
     /**
      * @brief Process all queued messages and invoke their handlers.
      *
@@ -82,6 +128,9 @@ private:
     std::queue<Message> _inbox;
     std::map<Message::Type, MessageHandler> _handlers;
     std::atomic<bool> _running{false};
+    std::atomic<size_t> _compression_threshold{0};
+    std::atomic<bool> _no_delay{false};
+    std::atomic<bool> _cork{false};
 };
 
 #endif // LIBFTPP_NETWORKING_CLIENT_HPP
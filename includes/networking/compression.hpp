@@ -0,0 +1,53 @@
+#ifndef LIBFTPP_NETWORKING_COMPRESSION_HPP
+#define LIBFTPP_NETWORKING_COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "data_structures/data_buffer.hpp"
+
+/**
+ * @file includes/networking/compression.hpp
+ * @brief Self-contained LZ77 block compressor used for Message frames.
+ *
+ * The block format follows the LZ4 sequence layout: a token byte holding
+ * the literal length (high nibble) and match length - 4 (low nibble), 255
+ * extension bytes for longer lengths, the literals, then a 2-byte
+ * little-endian match offset (at most 65535 back). The last sequence has
+ * literals only. Matches are found with a single 4096-entry hash table, so
+ * compression is one pass and decompression is a sequence of memcpys.
+ *
+ * On the wire, a compressed frame sets FRAME_COMPRESSED_FLAG in the length
+ * field and its payload is [uint32_t raw size (network order)][block].
+ */
+
+/** High bit of the frame length field: the payload is compressed. */
+constexpr uint32_t FRAME_COMPRESSED_FLAG = 0x80000000u;
+
+/** Worst-case block size for srcSize input bytes. */
+size_t lz_compress_bound(size_t srcSize) noexcept;
+
+/**
+ * @brief Compress src into dst.
+ * @return the block size, or 0 if it would not fit in dstCapacity
+ *         (use lz_compress_bound() to always succeed).
+ */
+size_t lz_compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) noexcept;
+
+/**
+ * @brief Decompress a block that expands to exactly dstSize bytes.
+ * @throws std::runtime_error if the block is malformed or does not produce
+ *         exactly dstSize bytes. Never reads or writes out of bounds.
+ */
+void lz_decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+/**
+ * @brief Decode a compressed frame payload, appending the raw bytes to out.
+ *
+ * The bytes are decompressed straight into out's storage; nothing is
+ * staged in between.
+ * @param maxRawSize reject frames announcing a larger raw size
+ * @throws std::runtime_error on malformed input or an oversized frame.
+ */
+void decompress_frame_payload(const uint8_t* body, size_t size, size_t maxRawSize, DataBuffer& out);
+
+#endif // LIBFTPP_NETWORKING_COMPRESSION_HPP
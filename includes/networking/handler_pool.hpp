@@ -0,0 +1,82 @@
+#ifndef LIBFTPP_NETWORKING_HANDLER_POOL_HPP
+#define LIBFTPP_NETWORKING_HANDLER_POOL_HPP
+
+#include "networking/message.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file includes/networking/handler_pool.hpp
+ * @brief Worker threads running Server message handlers off the I/O loops.
+ *
+ * Messages are queued per key (the ClientID): each key is a strand. A
+ * strand is run by at most one worker at a time and its messages run in
+ * submission order, so per-client ordering is the same as with inline
+ * dispatch, while different clients proceed in parallel.
+ *
+ * The queue is bounded: full() turns true once `capacity` messages are
+ * pending, and the Server stops reading sockets until the workers have
+ * brought the backlog down to half the capacity and called onSpace. The
+ * bound is soft: messages already parsed from a read are still accepted,
+ * so the backlog can exceed capacity by what one read produced.
+ */
+class HandlerPool {
+public:
+    using Key = long long;
+    using Runner = std::function<void(Key, Message&)>;
+
+    /**
+     * @param threads number of worker threads (at least 1)
+     * @param capacity pending messages at which full() turns true (at least 1)
+     * @param run invoked on a worker for every message
+     * @param onSpace invoked on a worker when a full queue drains to capacity / 2
+     */
+    HandlerPool(size_t threads, size_t capacity, Runner run, std::function<void()> onSpace);
+
+    /** stop() */
+    ~HandlerPool();
+    HandlerPool(const HandlerPool&) = delete;
+    HandlerPool& operator=(const HandlerPool&) = delete;
+
+    /** Queue a message on the strand of `key`. Never blocks. */
+    void submit(Key key, Message&& message);
+
+    /** True when at least `capacity` messages are pending. Thread-safe. */
+    bool full() const noexcept;
+
+    /** Messages queued or running. Thread-safe. */
+    size_t pending() const noexcept;
+
+    /** Drop queued messages, let running handlers finish, join the workers. */
+    void stop();
+
+private:
+    /** Messages of one key, and whether the key is on the ready queue or running. */
+    struct Strand {
+        std::deque<Message> messages;
+        bool scheduled = false;
+    };
+
+    void work();
+
+    const size_t _capacity;
+    Runner _run;
+    std::function<void()> _on_space;
+    mutable std::mutex _m;
+    std::condition_variable _cv;
+    std::unordered_map<Key, Strand> _strands;
+    std::deque<Key> _ready; // scheduled strands waiting for a worker
+    std::atomic<size_t> _pending{0};
+    bool _was_full = false;
+    bool _stopping = false;
+    std::vector<std::thread> _workers;
+};
+
+#endif // LIBFTPP_NETWORKING_HANDLER_POOL_HPP
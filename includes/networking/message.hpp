@@ -4,6 +4,8 @@
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <span>
 #include <sstream>
 #include <cstring>
 #include "data_structures/data_buffer.hpp"
@@ -20,27 +22,64 @@ public:
      */
     Message(Type t = 0) : _type(t) {}
 
+    /**
+     * @brief Construct a message whose payload allocates from `resource`
+     * (e.g. a per-frame FrameArena). The resource must outlive the message.
+     */
+    Message(Type t, std::pmr::memory_resource* resource) : _type(t), _buf(resource) {}
+
+    /**
+     * @brief Construct a message around an existing payload, e.g. a
+     * DataBuffer::borrow() view of a received frame (no copy).
+     */
+    Message(Type t, DataBuffer&& payload) : _type(t), _buf(std::move(payload)) {}
+
     /** Return the message type. */
     Type type() const { return _type; }
 
+    /**
+     * @brief Return the message to its freshly constructed state, keeping
+     * the payload capacity.
+     *
+     * Hook for Pool's Reset release policy: a pooled Message reused this
+     * way does not reallocate its payload once it has grown.
+     * @param t new message type (default 0)
+     */
+    void reset(Type t = 0) noexcept {
+        _type = t;
+        _buf.clear();
+        _buf.setByteOrder(DataBuffer::ByteOrder::Host);
+        _buf.setIntegerEncoding(DataBuffer::IntegerEncoding::Fixed);
+    }
+
     /** Access to the underlying binary payload buffer (DataBuffer). */
     DataBuffer &payload() { return _buf; }
     const DataBuffer &payload() const { return _buf; }
 
     /**
-     * @brief Serialize a trivially-copyable value into the payload.
+     * @brief Byte order of the payload's multi-byte values.
+     *
+     * Defaults to host order. Set it to Big (network order) or Little on
+     * both peers to exchange messages between hosts of different
+     * endianness; the string length prefix below is always network order.
+     */
+    void setByteOrder(DataBuffer::ByteOrder order) noexcept { _buf.setByteOrder(order); }
+    DataBuffer::ByteOrder byteOrder() const noexcept { return _buf.byteOrder(); }
+
+    /**
+     * @brief Serialize a value into the payload.
      *
-     * This method performs a binary copy (memcpy) of the value into the
-     * payload. It is constrained to trivially-copyable types with a
-     * static_assert.
+     * Trivially-copyable values are copied as raw bytes (memcpy). Standard
+     * containers and vocabulary types (vector, array, map, optional,
+     * variant...) use the DataBuffer codecs; strings nested inside them use
+     * the DataBuffer string encoding, not the 32-bit prefix below.
      *
-     * @tparam T trivially-copyable type
+     * @tparam T trivially-copyable type or type supported by DataBuffer
      * @param value value to serialize
      * @return reference to *this for chaining
      */
     template<typename T>
     Message &operator<<(const T &value) {
-        static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable");
         _buf << value;
         return *this;
     }
@@ -54,27 +93,32 @@ public:
     Message &operator<<(const std::string &s) {
         uint32_t len = static_cast<uint32_t>(s.size());
         uint32_t netlen = htonl(len);
-        _buf << netlen;
-        // write raw bytes
-        const uint8_t *ptr = reinterpret_cast<const uint8_t*>(s.data());
-        for (size_t i = 0; i < len; ++i) _buf << ptr[i];
+        _buf.reserve(_buf.size() + sizeof(netlen) + len);
+        // raw write: the prefix format does not depend on the payload encoding
+        _buf.write(&netlen, sizeof(netlen));
+        _buf.write(s.data(), len);
         return *this;
     }
 
     /**
-     * @brief Deserialize a trivially-copyable value from the payload.
+     * @brief Deserialize a value from the payload.
      *
-     * Advances the internal read position.
+     * Accepts the same types as operator<<. Advances the internal read
+     * position.
      */
     template<typename T>
     void read(T &out) {
-        static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable");
         _buf >> out;
     }
 
+    /** Read a string written by operator<<(const std::string&). */
+    void read(std::string &out) {
+        readString(out);
+    }
+
     /**
      * @brief Extraction operator (stream-like) to read a value.
-     * @tparam T trivially-copyable type
+     * @tparam T any type accepted by read()
      * @param out destination
      * @return reference to *this
      */
@@ -86,7 +130,7 @@ public:
 
     /**
      * @brief Convenience pop helper that returns the next value.
-     * @tparam T trivially-copyable type
+     * @tparam T default-constructible type accepted by read()
      * @return the extracted value
      */
     template<typename T>
@@ -103,16 +147,43 @@ public:
      * Throws std::runtime_error on malformed data.
      */
     void readString(std::string &out) {
+        out.assign(readStringView());
+    }
+
+    /**
+     * @brief Zero-copy variant of readString().
+     *
+     * Returns a view into the payload and only advances the read cursor.
+     * The view is invalidated by any later write to the payload or by the
+     * destruction of the message.
+     * Throws std::runtime_error on malformed data, whether the length prefix
+     * or the bytes it announces are cut short.
+     */
+    std::string_view readStringView() {
         uint32_t netlen = 0;
-        _buf >> netlen;
+        if (_buf.size() - _buf.readPosition() < sizeof(netlen)) throw std::runtime_error("message too small");
+        _buf.read(&netlen, sizeof(netlen));
         uint32_t len = ntohl(netlen);
-        if (_buf.readPosition() + len > _buf.size()) throw std::runtime_error("message too small");
-        out.resize(len);
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t b = 0;
-            _buf >> b;
-            out[i] = static_cast<char>(b);
-        }
+        if (len > _buf.size() - _buf.readPosition()) throw std::runtime_error("message too small");
+        std::span<const uint8_t> bytes = _buf.readBytes(len);
+        return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    /**
+     * @brief View over the next n raw payload bytes (no copy).
+     * @throws std::out_of_range if fewer than n bytes remain.
+     */
+    std::span<const uint8_t> readBytes(size_t n) {
+        return _buf.readBytes(n);
+    }
+
+    /**
+     * @brief View over the next `count` packed trivially-copyable values.
+     * @see ArrayView
+     */
+    template<typename T>
+    ArrayView<T> readArray(size_t count) {
+        return _buf.readArray<T>(count);
     }
 
     /**
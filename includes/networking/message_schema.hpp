@@ -0,0 +1,226 @@
+#ifndef LIBFTPP_NETWORKING_MESSAGE_SCHEMA_HPP
+#define LIBFTPP_NETWORKING_MESSAGE_SCHEMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+#include "networking/message.hpp"
+
+/**
+ * @file includes/networking/message_schema.hpp
+ * @brief Compile-time message layouts with generated encode/decode.
+ *
+ * A schema binds a message type id to an ordered list of struct members:
+ *
+ * @code{.cpp}
+ * struct Move { uint32_t entity; float x, y, z; std::string label; uint8_t flags; };
+ * using MoveSchema = MessageSchema<MSG_MOVE, &Move::entity, &Move::x, &Move::y,
+ *                                  &Move::z, &Move::label, &Move::flags>;
+ *
+ * client.send(MoveSchema::encode(move));
+ * server.defineAction(MoveSchema::type, MoveSchema::serverHandler(
+ *     [](Server::ClientID id, const Move& m) { ... }));
+ * @endcode
+ *
+ * Wire format, entirely in host byte order (the order the fixed runs are
+ * copied in; Message::setByteOrder() does not apply to schemas):
+ * - fixed-size fields (trivially-copyable, non-pointer types) are raw bytes;
+ * - std::string: uint32_t length, then the bytes;
+ * - std::vector<T> of trivially-copyable T: uint32_t element count, then
+ *   the packed elements.
+ * A string or vector longer than UINT32_MAX elements is rejected by encode()
+ * with std::length_error.
+ *
+ * Consecutive fixed-size fields form a run. A run is bounds-checked once and,
+ * when its members are laid out back to back in the struct, copied with a
+ * single memcpy; only variable-length fields are decoded one by one.
+ *
+ * Every member must belong to the same struct and have a supported type;
+ * anything else is rejected by static_assert at compile time. Handlers
+ * built with serverHandler()/clientHandler() must accept the schema struct.
+ */
+
+namespace message_schema_detail {
+
+template<auto Member>
+struct MemberTraits;
+
+template<typename C, typename F, F C::* Member>
+struct MemberTraits<Member> {
+    using Class = C;
+    using Field = F;
+};
+
+template<typename F>
+struct IsByteVector : std::false_type {};
+
+template<typename T, typename A>
+struct IsByteVector<std::vector<T, A>>
+    : std::bool_constant<std::is_trivially_copyable<T>::value && !std::is_same<T, bool>::value> {};
+
+/** Raw-bytes fields: trivially copyable and not a pointer (which would not survive the wire). */
+template<typename F>
+constexpr bool isFixedField() {
+    return std::is_trivially_copyable<F>::value && !std::is_pointer<F>::value
+        && !std::is_member_pointer<F>::value;
+}
+
+template<typename F>
+constexpr bool isVariableField() {
+    return std::is_same<F, std::string>::value || IsByteVector<F>::value;
+}
+
+}
+
+/**
+ * @brief Message layout declared once as a type id plus struct members.
+ * @tparam Id message type written in the frame header
+ * @tparam Members pointers to data members, in wire order
+ */
+template<Message::Type Id, auto... Members>
+class MessageSchema {
+    static_assert(sizeof...(Members) > 0, "A message schema needs at least one field");
+
+    public:
+        /** Struct described by the schema (class of the first member). */
+        using Struct = typename message_schema_detail::MemberTraits<
+            std::get<0>(std::tuple<decltype(Members)...>{Members...})>::Class;
+
+        /** Message type id of this schema. */
+        static constexpr Message::Type type = Id;
+
+        /** Number of fields. */
+        static constexpr size_t fieldCount = sizeof...(Members);
+
+        /** Total size of the fixed-size fields. */
+        static constexpr size_t fixedSize =
+            ((message_schema_detail::isFixedField<typename message_schema_detail::MemberTraits<Members>::Field>()
+                ? sizeof(typename message_schema_detail::MemberTraits<Members>::Field) : 0) + ...);
+
+        static_assert((std::is_same<typename message_schema_detail::MemberTraits<Members>::Class, Struct>::value && ...),
+            "All schema members must belong to the same struct");
+        static_assert(((message_schema_detail::isFixedField<typename message_schema_detail::MemberTraits<Members>::Field>()
+                || message_schema_detail::isVariableField<typename message_schema_detail::MemberTraits<Members>::Field>()) && ...),
+            "Schema fields must be trivially-copyable values, std::string or std::vector of trivially-copyable values");
+
+        /** Exact payload size encode() produces for value. */
+        static size_t encodedSize(const Struct& value) noexcept;
+
+        /**
+         * @brief Build a Message of type Id holding value.
+         * @throws std::length_error if a string or vector exceeds UINT32_MAX elements.
+         */
+        static Message encode(const Struct& value);
+
+        /** Append value's fields to message's payload (reserves once); same throws. */
+        static void encode(const Struct& value, Message& message);
+
+        /**
+         * @brief Decode a message's payload (from its first byte) into a struct.
+         *
+         * Does not touch the message read cursor, so it works on the
+         * `const Message&` handed to handlers.
+         * @throws std::runtime_error if the message type is not Id.
+         * @throws std::out_of_range if the payload is truncated.
+         */
+        static Struct decode(const Message& message);
+
+        /** Same as decode(message) but fills an existing struct. */
+        static void decode(const Message& message, Struct& out);
+
+        /**
+         * @brief Adapt fn(ClientID, const Struct&) to a Server::MessageHandler.
+         *
+         * Passing a callable that does not accept the schema struct is a
+         * compile error.
+         */
+        template<typename Fn>
+        static auto serverHandler(Fn fn);
+
+        /** Adapt fn(const Struct&) to a Client::MessageHandler. */
+        template<typename Fn>
+        static auto clientHandler(Fn fn);
+
+    private:
+        template<size_t I>
+        using FieldAt = typename message_schema_detail::MemberTraits<
+            std::get<I>(std::tuple<decltype(Members)...>{Members...})>::Field;
+
+        template<size_t I>
+        static constexpr auto memberAt() {
+            return std::get<I>(std::tuple<decltype(Members)...>{Members...});
+        }
+
+        template<size_t I>
+        static constexpr bool isFixed() {
+            return message_schema_detail::isFixedField<FieldAt<I>>();
+        }
+
+        /** Field I opens a run of fixed fields. */
+        template<size_t I>
+        static constexpr bool startsRun() {
+            if constexpr (I == 0) {
+                return isFixed<0>();
+            } else {
+                return isFixed<I>() && !isFixed<I - 1>();
+            }
+        }
+
+        /** One past the last field of the run starting at I. */
+        template<size_t I>
+        static constexpr size_t runEnd() {
+            if constexpr (I < fieldCount && isFixed<I>()) {
+                return runEnd<I + 1>();
+            } else {
+                return I;
+            }
+        }
+
+        /** Bytes covered by fields [I, End). */
+        template<size_t I, size_t End>
+        static constexpr size_t runBytes() {
+            if constexpr (I < End) {
+                return sizeof(FieldAt<I>) + runBytes<I + 1, End>();
+            } else {
+                return 0;
+            }
+        }
+
+        /** True if fields [I, End) sit back to back in the struct (no padding). */
+        template<size_t I, size_t End>
+        static bool isContiguous(const Struct& value) noexcept;
+
+        template<size_t I, size_t End>
+        static void writeRunFields(const Struct& value, uint8_t* out) noexcept;
+
+        template<size_t I, size_t End>
+        static void readRunFields(Struct& value, const uint8_t* in) noexcept;
+
+        template<size_t I>
+        static void encodeField(const Struct& value, DataBuffer& buffer);
+
+        template<size_t I>
+        static void decodeField(const uint8_t* data, size_t size, size_t& offset, Struct& value);
+
+        template<size_t I>
+        static size_t variableSize(const Struct& value) noexcept;
+
+        template<size_t... Is>
+        static void encodeAll(const Struct& value, DataBuffer& buffer, std::index_sequence<Is...>);
+
+        template<size_t... Is>
+        static void decodeAll(const uint8_t* data, size_t size, Struct& value, std::index_sequence<Is...>);
+
+        template<size_t... Is>
+        static size_t variableSizes(const Struct& value, std::index_sequence<Is...>) noexcept;
+};
+
+#include "networking/message_schema.tpp"
+
+#endif // LIBFTPP_NETWORKING_MESSAGE_SCHEMA_HPP
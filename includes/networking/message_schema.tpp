@@ -0,0 +1,186 @@
+// MessageSchema implementation (included from message_schema.hpp)
+
+template<Message::Type Id, auto... Members>
+template<size_t I, size_t End>
+bool MessageSchema<Id, Members...>::isContiguous(const Struct& value) noexcept {
+    if constexpr (I + 1 < End) {
+        const uint8_t* current = reinterpret_cast<const uint8_t*>(&(value.*memberAt<I>()));
+        const uint8_t* next = reinterpret_cast<const uint8_t*>(&(value.*memberAt<I + 1>()));
+        return current + sizeof(FieldAt<I>) == next && isContiguous<I + 1, End>(value);
+    } else {
+        (void)value;
+        return true;
+    }
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t I, size_t End>
+void MessageSchema<Id, Members...>::writeRunFields(const Struct& value, uint8_t* out) noexcept {
+    if constexpr (I < End) {
+        std::memcpy(out, &(value.*memberAt<I>()), sizeof(FieldAt<I>));
+        writeRunFields<I + 1, End>(value, out + sizeof(FieldAt<I>));
+    } else {
+        (void)value;
+        (void)out;
+    }
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t I, size_t End>
+void MessageSchema<Id, Members...>::readRunFields(Struct& value, const uint8_t* in) noexcept {
+    if constexpr (I < End) {
+        std::memcpy(&(value.*memberAt<I>()), in, sizeof(FieldAt<I>));
+        readRunFields<I + 1, End>(value, in + sizeof(FieldAt<I>));
+    } else {
+        (void)value;
+        (void)in;
+    }
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t I>
+size_t MessageSchema<Id, Members...>::variableSize(const Struct& value) noexcept {
+    if constexpr (isFixed<I>()) {
+        (void)value;
+        return 0;
+    } else {
+        const auto& field = value.*memberAt<I>();
+        return sizeof(uint32_t) + field.size() * sizeof(typename FieldAt<I>::value_type);
+    }
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t... Is>
+size_t MessageSchema<Id, Members...>::variableSizes(const Struct& value, std::index_sequence<Is...>) noexcept {
+    return (variableSize<Is>(value) + ... + 0);
+}
+
+template<Message::Type Id, auto... Members>
+size_t MessageSchema<Id, Members...>::encodedSize(const Struct& value) noexcept {
+    return fixedSize + variableSizes(value, std::make_index_sequence<fieldCount>{});
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t I>
+void MessageSchema<Id, Members...>::encodeField(const Struct& value, DataBuffer& buffer) {
+    if constexpr (startsRun<I>()) {
+        constexpr size_t end = runEnd<I>();
+        constexpr size_t bytes = runBytes<I, end>();
+        if (isContiguous<I, end>(value)) {
+            buffer.write(&(value.*memberAt<I>()), bytes);
+        } else {
+            uint8_t staging[bytes];
+            writeRunFields<I, end>(value, staging);
+            buffer.write(staging, bytes);
+        }
+    } else if constexpr (!isFixed<I>()) {
+        const auto& field = value.*memberAt<I>();
+        if (field.size() > UINT32_MAX) {
+            throw std::length_error("Schema field too long for its 32-bit count");
+        }
+        const size_t bytes = field.size() * sizeof(typename FieldAt<I>::value_type);
+        const uint32_t count = static_cast<uint32_t>(field.size());
+        buffer.write(&count, sizeof(count));
+        buffer.write(field.data(), bytes);
+    }
+    // fixed fields inside a run were written by the run's first field
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t I>
+void MessageSchema<Id, Members...>::decodeField(const uint8_t* data, size_t size, size_t& offset, Struct& value) {
+    if constexpr (startsRun<I>()) {
+        constexpr size_t end = runEnd<I>();
+        constexpr size_t bytes = runBytes<I, end>();
+        // one bounds check for the whole run
+        if (bytes > size - offset) {
+            throw std::out_of_range("Message payload too short for schema");
+        }
+        if (isContiguous<I, end>(value)) {
+            std::memcpy(&(value.*memberAt<I>()), data + offset, bytes);
+        } else {
+            readRunFields<I, end>(value, data + offset);
+        }
+        offset += bytes;
+    } else if constexpr (!isFixed<I>()) {
+        using Element = typename FieldAt<I>::value_type;
+        uint32_t count = 0;
+        if (sizeof(count) > size - offset) {
+            throw std::out_of_range("Message payload too short for schema");
+        }
+        std::memcpy(&count, data + offset, sizeof(count));
+        offset += sizeof(count);
+        if (count > (size - offset) / sizeof(Element)) {
+            throw std::out_of_range("Message payload too short for schema");
+        }
+        auto& field = value.*memberAt<I>();
+        field.resize(count);
+        if (count > 0) {
+            std::memcpy(field.data(), data + offset, count * sizeof(Element));
+        }
+        offset += count * sizeof(Element);
+    }
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t... Is>
+void MessageSchema<Id, Members...>::encodeAll(const Struct& value, DataBuffer& buffer, std::index_sequence<Is...>) {
+    (encodeField<Is>(value, buffer), ...);
+}
+
+template<Message::Type Id, auto... Members>
+template<size_t... Is>
+void MessageSchema<Id, Members...>::decodeAll(const uint8_t* data, size_t size, Struct& value, std::index_sequence<Is...>) {
+    size_t offset = 0;
+    (decodeField<Is>(data, size, offset, value), ...);
+}
+
+template<Message::Type Id, auto... Members>
+void MessageSchema<Id, Members...>::encode(const Struct& value, Message& message) {
+    DataBuffer& buffer = message.payload();
+    buffer.reserve(buffer.size() + encodedSize(value));
+    encodeAll(value, buffer, std::make_index_sequence<fieldCount>{});
+}
+
+template<Message::Type Id, auto... Members>
+Message MessageSchema<Id, Members...>::encode(const Struct& value) {
+    Message message(Id);
+    encode(value, message);
+    return message;
+}
+
+template<Message::Type Id, auto... Members>
+void MessageSchema<Id, Members...>::decode(const Message& message, Struct& out) {
+    if (message.type() != Id) {
+        throw std::runtime_error("Message type does not match schema");
+    }
+    const DataBuffer& payload = message.payload();
+    decodeAll(payload.data(), payload.size(), out, std::make_index_sequence<fieldCount>{});
+}
+
+template<Message::Type Id, auto... Members>
+typename MessageSchema<Id, Members...>::Struct MessageSchema<Id, Members...>::decode(const Message& message) {
+    Struct value{};
+    decode(message, value);
+    return value;
+}
+
+template<Message::Type Id, auto... Members>
+template<typename Fn>
+auto MessageSchema<Id, Members...>::serverHandler(Fn fn) {
+    return [fn = std::move(fn)](auto clientID, const Message& message) {
+        static_assert(std::is_invocable<const Fn&, decltype(clientID), const Struct&>::value,
+            "Handler must accept (ClientID, const Struct&) for this schema");
+        fn(clientID, decode(message));
+    };
+}
+
+template<Message::Type Id, auto... Members>
+template<typename Fn>
+auto MessageSchema<Id, Members...>::clientHandler(Fn fn) {
+    static_assert(std::is_invocable<const Fn&, const Struct&>::value,
+        "Handler must accept (const Struct&) for this schema");
+    return [fn = std::move(fn)](const Message& message) {
+        fn(decode(message));
+    };
+}
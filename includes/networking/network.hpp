@@ -5,5 +5,9 @@
 #include "networking/message.hpp"
 #include "networking/client.hpp"
 #include "networking/server.hpp"
+#include "networking/poller.hpp"
+#include "networking/handler_pool.hpp"
+#include "networking/message_schema.hpp"
+#include "networking/compression.hpp"
 
 #endif // LIBFTPP_NETWORKING_NETWORK_HPP
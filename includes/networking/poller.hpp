@@ -0,0 +1,108 @@
+#ifndef LIBFTPP_NETWORKING_POLLER_HPP
+#define LIBFTPP_NETWORKING_POLLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <poll.h>
+
+struct epoll_event;
+
+/**
+ * @file includes/networking/poller.hpp
+ * @brief Readiness notification for the Server event loop.
+ *
+ * Poller keeps the set of watched descriptors registered with the kernel
+ * between calls, so a wakeup costs O(ready descriptors) instead of
+ * rebuilding and scanning an O(connections) pollfd array.
+ *
+ * Two backends:
+ * - Epoll (default): edge-triggered epoll. A descriptor is reported once per
+ *   readiness change, so the caller must drain it (read/accept until
+ *   EAGAIN) before waiting again.
+ * - Poll: level-triggered poll() over a persistent pollfd array. Fallback
+ *   and baseline; still O(watched descriptors) per wait. A descriptor
+ *   watched for no events is left out of the poll() set, so a hang-up on
+ *   it (e.g. a paused connection) does not wake every wait.
+ *
+ * Code that always drains until EAGAIN works unchanged with both.
+ *
+ * add/modify/remove/wait must be called from one thread (the loop);
+ * wake() may be called from any thread.
+ */
+class Poller {
+public:
+    enum class Backend { Epoll, Poll };
+
+    /** Interest / readiness bits. */
+    enum : uint32_t {
+        Readable = 1u << 0,
+        Writable = 1u << 1
+    };
+
+    /** One ready descriptor. */
+    struct Event {
+        int fd;
+        /** Readable and/or Writable. Errors and hang-ups report Readable so the read sees them. */
+        uint32_t events;
+    };
+
+    /** Backend used when none is requested (Epoll). */
+    static Backend defaultBackend() noexcept;
+
+    /**
+     * @throws std::runtime_error if the backend (or its wakeup eventfd)
+     *         cannot be created
+     */
+    explicit Poller(Backend backend = defaultBackend());
+    ~Poller();
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+
+    /**
+     * @brief Start watching `fd` for `events`.
+     * @throws std::runtime_error on failure (e.g. fd already watched)
+     */
+    void add(int fd, uint32_t events);
+
+    /** Change the interest set of a watched fd. @throws std::runtime_error */
+    void modify(int fd, uint32_t events);
+
+    /** Stop watching `fd`. Call it before close(fd). No-op if not watched. */
+    void remove(int fd) noexcept;
+
+    /**
+     * @brief Wait for readiness.
+     *
+     * `ready` is cleared and filled with the ready descriptors (wakeups
+     * are consumed internally and never reported).
+     *
+     * @param timeoutMs -1 to block until an event or wake()
+     * @return number of events in `ready`
+     */
+    size_t wait(std::vector<Event>& ready, int timeoutMs);
+
+    /** Make a concurrent or the next wait() return. Thread-safe. */
+    void wake() noexcept;
+
+    Backend backend() const noexcept;
+
+    /** Number of watched descriptors (the wakeup fd excluded). */
+    size_t size() const noexcept;
+
+private:
+    /** Swallow pending wake() notifications. */
+    void drainWakeup() noexcept;
+
+    Backend _backend;
+    int _epoll_fd = -1;
+    int _wake_fd = -1;
+    size_t _watched = 0;
+    std::vector<epoll_event> _epoll_events;
+    // Poll backend: dense array (wakeup fd first) and fd -> position for O(1) removal
+    std::vector<pollfd> _pollfds;
+    std::unordered_map<int, size_t> _poll_index;
+};
+
+#endif // LIBFTPP_NETWORKING_POLLER_HPP
@@ -2,10 +2,17 @@
 #define LIBFTPP_NETWORKING_SERVER_HPP
 
 #include "networking/message.hpp"
+#include "networking/poller.hpp"
+#include "networking/handler_pool.hpp"
+#include "data_structures/segmented_buffer.hpp"
+#include "data_structures/ring_buffer.hpp"
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <atomic>
@@ -20,10 +27,41 @@
  *
  * Notes:
  * - Messages are framed as: [uint32_t len][int32_t type][payload] where
- *   len and type are in network byte order.
- * - The server extracts complete frames while holding the internal mutex
- *   then invokes handlers outside the lock to avoid reentrancy and
- *   deadlocks.
+ *   len and type are in network byte order. The high bit of len marks an
+ *   LZ-compressed payload (see networking/compression.hpp).
+ * - Each event-loop thread runs over its own Poller (edge-triggered epoll
+ *   by default): listening sockets and clients stay registered between
+ *   wakeups, so an idle connection costs nothing per iteration. Sockets
+ *   are always drained until EAGAIN.
+ * - With setEventLoops(n), n loops each own a partition of the
+ *   connections: a connection is read, framed and dispatched by the loop
+ *   that accepted it, so its messages stay in order. Receive buffers are
+ *   private to their loop; only the ClientID registry and the handler
+ *   table are shared (under a reader/writer lock).
+ * - Handlers run on the loop thread that owns the client, outside any
+ *   lock. With several loops, handlers for different clients may run
+ *   concurrently.
+ * - With setHandlerThreads(n), handlers run on a HandlerPool instead, one
+ *   strand per client (a client's messages still run one at a time, in
+ *   order). While its bounded queue is full the loops stop reading, so a
+ *   slow handler pushes back on the senders through TCP flow control
+ *   instead of stalling every connection's reads.
+ * - Sends never write to the socket from the calling thread: the frame is
+ *   appended to the client's outbound RingBuffer and its owning loop is
+ *   woken to flush it. What the socket does not take waits for a writable
+ *   event, so a slow reader no longer gets disconnected on EAGAIN nor
+ *   stalls the sender. The queue is bounded by watermarks and a
+ *   SlowConsumerPolicy.
+ * - Received bytes are read into a per-connection RingBuffer (readv across
+ *   its wrap point) and framed in place: handlers running on the loop see
+ *   payloads borrowed from the ring, without a copy. A partially received
+ *   frame is moved clear of the wrap point so the rest lands after it.
+ *   Frames handed to the handler pool, and the rare frame still split
+ *   (its header was cut by a read), are copied once. A frame that is too
+ *   large or fails to decompress closes the connection.
+ * - Frames queued for a client between two flushes leave in one sendmsg.
+ *   Replies sent by handlers running on the client's own loop are flushed
+ *   once the loop has dispatched everything it read, without a wakeup.
  */
 class Server {
 public:
@@ -41,7 +79,14 @@ public:
      */
     void start(const size_t& p_port);
 
-    /** Stop the server and join the worker thread. */
+    /**
+     * @brief Stop the server and join the loop threads.
+     *
+     * Output already queued, e.g. by a sendTo() just before, is written out
+     * first: best-effort, for half a second at most, so a client that does
+     * not read cannot hold stop() up. Other threads may keep sending while
+     * it runs; what they send once the clients are gone is ignored.
+     */
     void stop();
 
     /**
@@ -51,15 +96,174 @@ public:
      */
     void defineAction(const Message::Type& messageType, const MessageHandler& action);
 
-    /** Send a message to a single client id. */
+    /**
+     * @brief Send a message to a single client id.
+     *
+     * Thread-safe. The frame is queued for the client's loop to write;
+     * unknown or disconnected ids are ignored. Applies the
+     * SlowConsumerPolicy when the client's queue is over its high watermark.
+     * @throws std::length_error if the payload exceeds MAX_FRAME_SIZE.
+     */
     void sendTo(const Message& message, ClientID clientID);
 
+    /**
+     * @brief Send a SegmentedBuffer payload to a single client id.
+     *
+     * Header and segments are queued without linearizing the payload first.
+     * The client receives an ordinary Message.
+     */
+    void sendTo(const Message::Type& messageType, const SegmentedBuffer& payload, ClientID clientID);
+
+    /**
+     * @brief Queue several messages for one client at once.
+     *
+     * One lock, one policy check and at most one wakeup for the whole batch;
+     * the frames reach the socket together with anything already queued.
+     */
+    void sendBatchTo(const std::vector<Message>& messages, ClientID clientID);
+
     /** Send a message to a list of clients. */
     void sendToArray(const Message& message, std::vector<ClientID> clientIDs);
 
     /** Broadcast a message to all connected clients. */
     void sendToAll(const Message& message);
 
+    /**
+     * @brief Choose the readiness backend of the event loop.
+     *
+     * Epoll (the default) scales with the number of active connections;
+     * Poll is kept as a fallback and as a baseline. Takes effect at the
+     * next start().
+     */
+    void setEventBackend(Poller::Backend backend);
+
+    /** Backend used by the event loop. */
+    Poller::Backend eventBackend() const;
+
+    /** Number of connected clients. */
+    size_t clientCount();
+
+    /** How accepted connections are spread over the event loops. */
+    enum class AcceptDistribution {
+        /** One listening socket per loop with SO_REUSEPORT; the kernel balances. */
+        ReusePort,
+        /** Loop 0 accepts and hands connections to the loops in turn. */
+        RoundRobin
+    };
+
+    /**
+     * @brief Run `count` event-loop threads (default 1).
+     *
+     * Takes effect at the next start(). ReusePort falls back to RoundRobin
+     * if the socket option is refused.
+     * @throws std::invalid_argument if count is zero
+     */
+    void setEventLoops(size_t count, AcceptDistribution distribution = AcceptDistribution::ReusePort);
+
+    /** Number of event loops. */
+    size_t eventLoops() const;
+
+    /** Distribution in use (after any fallback when running). */
+    AcceptDistribution acceptDistribution() const;
+
+    /** Index of the loop owning a client, -1 if unknown. */
+    int ownerLoop(ClientID clientID);
+
+    /** Default bound on messages waiting for a handler thread. */
+    static constexpr size_t DEFAULT_HANDLER_QUEUE = 4096;
+
+    /**
+     * @brief Run handlers on `threads` worker threads instead of the I/O loops.
+     *
+     * 0 (the default) keeps handlers on the loops. When `queueCapacity`
+     * messages are waiting, the loops pause reading until the queue has
+     * room again. Messages still queued at stop() are dropped. Takes effect at
+     * the next start().
+     */
+    void setHandlerThreads(size_t threads, size_t queueCapacity = DEFAULT_HANDLER_QUEUE);
+
+    /** Number of handler threads (0 when handlers run on the loops). */
+    size_t handlerThreads() const;
+
+    /** Messages waiting for or running on a handler thread. */
+    size_t pendingHandlers() const;
+
+    /** What a send does when the client's outbound queue is over the high watermark. */
+    enum class SlowConsumerPolicy {
+        /** Discard the message, and every following one until the queue is back to the low watermark. */
+        Drop,
+        /** Disconnect the client and discard the message. */
+        Disconnect,
+        /**
+         * Wait until the queue is back to the low watermark. A send from the
+         * loop that owns the client cannot wait for itself and queues past
+         * the mark instead.
+         */
+        Block
+    };
+
+    /** Default outbound queue bounds, per client. */
+    static constexpr size_t DEFAULT_OUTBOUND_HIGH_WATERMARK = 4 * 1024 * 1024;
+    static constexpr size_t DEFAULT_OUTBOUND_LOW_WATERMARK = 1024 * 1024;
+
+    /**
+     * @brief Bound the bytes queued for each client.
+     *
+     * A send is over the limit when the queue already holds `high` bytes
+     * (the frame crossing the mark is still queued, so a queue never exceeds
+     * high + one frame). `low` ends the over-limit state for Drop and Block.
+     * @throws std::invalid_argument if high is zero or low > high
+     */
+    void setOutboundWatermarks(size_t high, size_t low);
+
+    size_t outboundHighWatermark() const;
+    size_t outboundLowWatermark() const;
+
+    /** Policy for clients over the high watermark (default Disconnect). */
+    void setSlowConsumerPolicy(SlowConsumerPolicy policy);
+
+    SlowConsumerPolicy slowConsumerPolicy() const;
+
+    /** Bytes queued for a client and not yet taken by its socket (0 if unknown). */
+    size_t queuedBytes(ClientID clientID);
+
+    /** Messages discarded by the Drop policy since construction. */
+    size_t droppedMessages() const;
+
+    /**
+     * @brief Set TCP_NODELAY on connections accepted from now on.
+     *
+     * Off by default (Nagle on). Since queued frames already leave in one
+     * write per flush, turning it on mostly removes the delay Nagle adds to
+     * request/response traffic.
+     */
+    void setDefaultNoDelay(bool enabled);
+
+    bool defaultNoDelay() const;
+
+    /** Set TCP_NODELAY on one connection. @return false if unknown or refused. */
+    bool setClientNoDelay(ClientID clientID, bool enabled);
+
+    /**
+     * @brief Set TCP_CORK on one connection.
+     *
+     * While corked the kernel only sends full segments, so a burst is
+     * packed tightly; uncork to push out the remainder. @return false if
+     * unknown or refused.
+     */
+    bool setClientCork(ClientID clientID, bool enabled);
+
+    /**
+     * @brief Compress outgoing payloads of at least `bytes` bytes.
+     *
+     * 0 (the default) disables compression. Incoming compressed frames are
+     * always accepted and decompressed straight into the Message payload.
+     */
+    void setCompressionThreshold(size_t bytes);
+
+    /** Current compression threshold (0 when disabled). */
+    size_t compressionThreshold() const;
+
     /**
      * @brief Process server-side queued events. The tests call update()
      * periodically to let the server run short tasks on the caller thread.
@@ -70,16 +274,168 @@ public:
     size_t getPort() const;
 
 private:
-    int _listen_sock = -1;
-    std::mutex _m;
-    std::map<ClientID, int> _clients; // clientID -> sock
+    /**
+     * @brief Disconnect a client from any thread.
+     *
+     * The socket is only shut down here; its owning loop sees the hang-up
+     * and closes it (see closeClient()), so the fd is never reused while
+     * it is still registered with a poller. Does nothing unless `sock`
+     * still belongs to `clientID`.
+     */
+    void dropClient(ClientID clientID, int sock);
+
+    /** Bytes waiting to be written to one client, shared by senders and its loop. */
+    struct Outbound {
+        std::mutex lock;
+        std::condition_variable drained; // Block policy: queue back to the low watermark
+        RingBuffer queue;
+        bool scheduled = false; // on the loop's flush list or waiting for a writable event
+        bool congested = false; // Drop policy: over the high watermark until back to low
+        bool closed = false;    // client gone or server stopping: discard sends
+    };
+
+    /** Connection state private to its loop thread. */
+    struct Connection {
+        ClientID id;
+        RingBuffer recv; // bytes read but not yet framed
+        std::shared_ptr<Outbound> out;
+        bool paused = false;
+        bool writing = false; // watched for writable events
+    };
+
+    /** One event-loop thread and the connections it owns. */
+    struct EventLoop {
+        size_t index = 0;
+        int listenSock = -1; // -1 for RoundRobin loops other than 0
+        std::unique_ptr<Poller> poller;
+        std::thread thread;
+        std::atomic<std::thread::id> owner{}; // set by the loop thread itself
+        std::unordered_map<int, Connection> connections; // loop thread only
+        std::vector<int> paused; // clients not read while the handler queue is full
+        std::mutex handoffLock;
+        std::vector<int> handoff; // accepted fds waiting to be registered
+        std::mutex flushLock;
+        std::vector<int> flush; // clients with newly queued output
+        std::vector<int> localFlush; // same, queued by this loop's own handlers
+    };
+
+    struct ClientEntry {
+        int sock;
+        size_t loop;
+        std::shared_ptr<Outbound> out;
+    };
+
+    /** Bind and listen on `port`; throws std::runtime_error. */
+    static int openListener(size_t port, bool reusePort);
+
+    /** Event loop run by each loop thread. */
+    void run(EventLoop& loop);
+
+    /** Accept every pending connection (the listening socket is edge-triggered). */
+    void acceptClients(EventLoop& loop);
+
+    /** Start watching an accepted socket from its owning loop's thread. */
+    void registerClient(EventLoop& loop, int fd);
+
+    /** Register the sockets handed to `loop` by the accepting loop. */
+    void takeHandoff(EventLoop& loop);
+
+    /**
+     * @brief Drain a client socket until EAGAIN, dispatching the complete
+     *        frames of each read before reading again.
+     *
+     * Reads go straight into the connection's receive ring. Without a
+     * handler pool, contiguous uncompressed payloads are borrowed from the
+     * ring (handlers run before it is consumed); otherwise they are copied
+     * once. When the handler queue fills up, parsing stops: complete
+     * frames wait in the ring and the rest in the socket.
+     * @param extracted scratch vector, empty on return
+     * @param closed set when the peer hung up, failed, or sent a bad frame
+     * @param full set when reading stopped because the handler queue is full
+     * @return the client id, or -1 if fd is not a client of this loop
+     */
+    ClientID readClient(EventLoop& loop, int fd, std::vector<Message>& extracted, bool& closed, bool& full);
+
+    /**
+     * @brief Frame, dispatch and consume the complete frames buffered in
+     *        `buf`, as many as the handler queue has room for.
+     * @param missing set to the bytes still needed by a partial frame
+     * @return false if frames were left because the handler queue is full
+     */
+    bool extractFrames(ClientID id, RingBuffer& buf, std::vector<Message>& extracted, bool& closed, size_t& missing);
+
+    /** readClient(), then close or pause the client as it reported. */
+    void serviceClient(EventLoop& loop, int fd, std::vector<Message>& extracted);
+
+    /** Run extracted messages inline, or queue them (moved) on the handler pool. */
+    void dispatch(ClientID id, std::vector<Message>& messages);
+
+    /** Look up and invoke the handler of one message, outside the lock. */
+    void invokeHandler(ClientID id, const Message& message);
+
+    /** Stop watching a client for reads until resumePaused(). */
+    void pauseClient(EventLoop& loop, int fd);
+
+    /** Re-arm paused clients once the handler queue has room, and serve what they buffered. */
+    void resumePaused(EventLoop& loop, std::vector<Message>& extracted);
+
+    /** Owning loop thread only: unregister, close and forget a client. */
+    void closeClient(EventLoop& loop, int fd);
+
+    /**
+     * @brief Queue a frame for a client and wake its loop if it was idle.
+     *
+     * Applies the SlowConsumerPolicy. Safe from any thread.
+     */
+    void enqueue(ClientID clientID, const iovec* iov, size_t count);
+
+    /** Flush the clients other threads queued output for. */
+    void takeFlushes(EventLoop& loop);
+
+    /** Flush the clients this loop's handlers queued output for. */
+    void flushLocal(EventLoop& loop);
+
+    /**
+     * @brief Last thing a loop does when the server stops: stop reading and
+     *        write out the queued output, for half a second at most.
+     */
+    void drainOutbound(EventLoop& loop);
+
+    /** Socket of a client, -1 if unknown. */
+    int clientSocket(ClientID clientID);
+
+    /**
+     * @brief Write queued output until EAGAIN.
+     *
+     * Watches the socket for writable events while output remains; a write
+     * error shuts the socket down so the read path closes it.
+     */
+    void flushClient(EventLoop& loop, int fd);
+
+    /** Apply a connection's paused / writing state to its poller interest. */
+    void updateInterest(EventLoop& loop, int fd, const Connection& conn);
+
+    std::shared_mutex _m;
+    std::map<ClientID, ClientEntry> _clients; // clientID -> sock and owning loop
     std::unordered_map<int, ClientID> _fd_to_id; // sock -> clientID
-    std::map<ClientID, std::vector<uint8_t>> _recv_buffers; // partial recv buffer per client
     std::map<Message::Type, MessageHandler> _handlers;
     ClientID _next_client_id = 1;
     std::atomic<bool> _running{false};
-    std::thread _worker;
     size_t _bound_port = 0;
+    std::atomic<size_t> _compression_threshold{0};
+    Poller::Backend _event_backend = Poller::defaultBackend();
+    size_t _loop_count = 1;
+    AcceptDistribution _distribution = AcceptDistribution::ReusePort;
+    std::vector<std::unique_ptr<EventLoop>> _loops;
+    std::atomic<size_t> _next_loop{0}; // RoundRobin cursor
+    size_t _handler_threads = 0;
+    size_t _handler_queue = DEFAULT_HANDLER_QUEUE;
+    std::unique_ptr<HandlerPool> _handler_pool;
+    std::atomic<size_t> _high_watermark{DEFAULT_OUTBOUND_HIGH_WATERMARK};
+    std::atomic<size_t> _low_watermark{DEFAULT_OUTBOUND_LOW_WATERMARK};
+    std::atomic<SlowConsumerPolicy> _slow_consumer_policy{SlowConsumerPolicy::Disconnect};
+    std::atomic<size_t> _dropped_messages{0};
+    std::atomic<bool> _default_no_delay{false};
 };
 
 #endif // LIBFTPP_NETWORKING_SERVER_HPP
@@ -0,0 +1,106 @@
+#ifndef LIBFTPP_NETWORKING_SOCKET_IO_HPP
+#define LIBFTPP_NETWORKING_SOCKET_IO_HPP
+
+#include <sys/uio.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Message;
+
+/**
+ * @file includes/networking/socket_io.hpp
+ * @brief Low-level gather-write helpers shared by Client and Server.
+ *
+ * Frames are described as iovec arrays (header + payload pieces) and
+ * submitted with sendmsg(), so a frame never has to be linearized into a
+ * temporary buffer before hitting the socket.
+ */
+
+/** Size of the frame header on the wire: [uint32_t len][int32_t type]. */
+constexpr size_t FRAME_HEADER_SIZE = 8;
+
+/** Largest frame (type + payload, or decompressed payload) a peer accepts. */
+constexpr size_t MAX_FRAME_SIZE = 10 * 1024 * 1024;
+
+/**
+ * @brief Fill `out` with the network-order frame header.
+ * @param type logical message type
+ * @param payloadSize number of payload bytes following the header
+ * @throws std::length_error if type + payload would exceed MAX_FRAME_SIZE.
+ */
+void encode_frame_header(uint8_t out[FRAME_HEADER_SIZE], int32_t type, size_t payloadSize, bool compressed = false);
+
+/**
+ * @brief Write every byte described by `iov` to `fd`, looping on short writes.
+ *
+ * The iovec array is consumed in place (entries are advanced as data is
+ * written). Uses MSG_NOSIGNAL so a closed peer reports an error instead of
+ * raising SIGPIPE.
+ *
+ * @return true when everything was written, false on error or EOF.
+ */
+bool send_all_iovecs(int fd, iovec* iov, size_t count);
+
+/**
+ * @brief Describe the frame of a Message as header + payload iovecs.
+ *
+ * Payloads of at least compressionThreshold bytes (0 disables compression)
+ * are LZ-compressed into `scratch` and flagged in the header, unless
+ * compression does not make them smaller. The iovecs point into `header`,
+ * `scratch` or the Message payload, which must outlive them.
+ *
+ * @return number of entries filled in `out` (2)
+ * @throws std::length_error if type + payload would exceed MAX_FRAME_SIZE
+ *         (checked on the uncompressed size).
+ */
+size_t frame_message(const Message& message, size_t compressionThreshold, uint8_t header[FRAME_HEADER_SIZE],
+                     std::unique_ptr<uint8_t[]>& scratch, iovec out[2]);
+
+/**
+ * @brief Frame and send a Message with a single gather write.
+ *
+ * Payloads of at least compressionThreshold bytes (0 disables compression)
+ * are LZ-compressed and flagged in the header, unless compression does not
+ * make them smaller.
+ *
+ * @return true when the whole frame was written.
+ */
+bool send_message_frame(int fd, const Message& message, size_t compressionThreshold);
+
+/**
+ * @brief Frames of several Messages as one iovec array.
+ *
+ * Two entries per message (header, payload), so any number of messages
+ * can be submitted with a single gather write. The batch owns the headers
+ * and compressed payloads; the Messages must outlive it.
+ */
+class FrameBatch {
+public:
+    FrameBatch(const Message* messages, size_t count, size_t compressionThreshold);
+
+    iovec* iov() noexcept;
+    size_t size() const noexcept;
+
+private:
+    std::vector<std::array<uint8_t, FRAME_HEADER_SIZE>> _headers;
+    std::vector<std::unique_ptr<uint8_t[]>> _scratch;
+    std::vector<iovec> _iov;
+};
+
+/**
+ * @brief Frame and send several Messages with one gather write
+ *        (IOV_MAX entries per sendmsg()).
+ * @return true when every frame was written.
+ */
+bool send_message_frames(int fd, const Message* messages, size_t count, size_t compressionThreshold);
+
+/**
+ * @brief Turn a boolean TCP-level option (TCP_NODELAY, TCP_CORK) on or off.
+ * @return false if setsockopt() refused it.
+ */
+bool set_tcp_option(int fd, int option, bool enabled);
+
+#endif // LIBFTPP_NETWORKING_SOCKET_IO_HPP
@@ -0,0 +1,140 @@
+#include "data_structures/byte_swap.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+# define LIBFTPP_BYTE_SWAP_X86 1
+#endif
+
+namespace {
+
+template<typename U>
+void swapScalar(uint8_t* dst, const uint8_t* src, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        U bits;
+        std::memcpy(&bits, src + i * sizeof(U), sizeof(U));
+        bits = std::byteswap(bits);
+        std::memcpy(dst + i * sizeof(U), &bits, sizeof(U));
+    }
+}
+
+void swapScalarWidth(uint8_t* dst, const uint8_t* src, size_t count, size_t width) noexcept {
+    switch (width) {
+        case 2: swapScalar<uint16_t>(dst, src, count); break;
+        case 4: swapScalar<uint32_t>(dst, src, count); break;
+        case 8: swapScalar<uint64_t>(dst, src, count); break;
+        default: break;
+    }
+}
+
+#ifdef LIBFTPP_BYTE_SWAP_X86
+
+// pshufb control: reverse each group of `width` bytes within a 16-byte lane
+alignas(16) const uint8_t kShuffle16[16] = {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) const uint8_t kShuffle32[16] = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+alignas(16) const uint8_t kShuffle64[16] = {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+
+const uint8_t* shuffleFor(size_t width) noexcept {
+    return width == 2 ? kShuffle16 : width == 4 ? kShuffle32 : kShuffle64;
+}
+
+__attribute__((target("ssse3")))
+void swapSsse3(void* dst, const void* src, size_t count, size_t width) noexcept {
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    size_t bytes = count * width;
+    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffleFor(width)));
+
+    while (bytes >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(v, mask));
+        in += 16;
+        out += 16;
+        bytes -= 16;
+    }
+    swapScalarWidth(out, in, bytes / width, width);
+}
+
+__attribute__((target("avx2")))
+void swapAvx2(void* dst, const void* src, size_t count, size_t width) noexcept {
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    size_t bytes = count * width;
+    // vpshufb shuffles within each 128-bit lane, so the same control serves both
+    const __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(shuffleFor(width))));
+
+    while (bytes >= 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(a, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_shuffle_epi8(b, mask));
+        in += 64;
+        out += 64;
+        bytes -= 64;
+    }
+    if (bytes >= 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(a, mask));
+        in += 32;
+        out += 32;
+        bytes -= 32;
+    }
+    if (bytes >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(v, _mm256_castsi256_si128(mask)));
+        in += 16;
+        out += 16;
+        bytes -= 16;
+    }
+    swapScalarWidth(out, in, bytes / width, width);
+}
+
+#endif
+
+using SwapKernel = void (*)(void*, const void*, size_t, size_t) noexcept;
+
+struct Dispatch {
+    SwapKernel kernel;
+    const char* name;
+};
+
+Dispatch selectKernel() noexcept {
+#ifdef LIBFTPP_BYTE_SWAP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {swapAvx2, "avx2"};
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return {swapSsse3, "ssse3"};
+    }
+#endif
+    return {byte_swap_copy_scalar, "scalar"};
+}
+
+// Resolved once, on first use
+const Dispatch& dispatch() noexcept {
+    static const Dispatch selected = selectKernel();
+    return selected;
+}
+
+}
+
+void byte_swap_copy_scalar(void* dst, const void* src, size_t count, size_t width) noexcept {
+    swapScalarWidth(static_cast<uint8_t*>(dst), static_cast<const uint8_t*>(src), count, width);
+}
+
+void byte_swap_copy(void* dst, const void* src, size_t count, size_t width) noexcept {
+    if (count == 0) {
+        return;
+    }
+    // Short arrays: the call through the dispatch table is not worth it
+    if (count * width < 16) {
+        swapScalarWidth(static_cast<uint8_t*>(dst), static_cast<const uint8_t*>(src), count, width);
+        return;
+    }
+    dispatch().kernel(dst, src, count, width);
+}
+
+const char* byte_swap_kernel() noexcept {
+    return dispatch().name;
+}
@@ -1,39 +1,137 @@
 #include "data_structures/data_buffer.hpp"
+#include <new>
+#include <bit>
+
+namespace {
+
+// Smallest heap block handed out on the first write, to skip the 1/2/4/8
+// byte doubling steps a fresh buffer would otherwise go through.
+constexpr size_t kMinimumCapacity = 64;
+
+}
 
 DataBuffer::DataBuffer()
-    : m_size(0)
-    , m_readPosition(0) {
+    : m_data(m_inline)
+    , m_capacity(INLINE_CAPACITY)
+    , m_size(0)
+    , m_readPosition(0)
+    , m_integerEncoding(IntegerEncoding::Fixed)
+    , m_byteOrder(ByteOrder::Host)
+    , m_resource(nullptr) {
 }
 
 DataBuffer::DataBuffer(size_t initialCapacity)
-    : m_size(0)
-    , m_readPosition(0) {
-    m_buffer.reserve(initialCapacity);
+    : m_data(m_inline)
+    , m_capacity(INLINE_CAPACITY)
+    , m_size(0)
+    , m_readPosition(0)
+    , m_integerEncoding(IntegerEncoding::Fixed)
+    , m_byteOrder(ByteOrder::Host)
+    , m_resource(nullptr) {
+    reserve(initialCapacity);
+}
+
+DataBuffer::DataBuffer(std::pmr::memory_resource* resource, size_t initialCapacity)
+    : m_data(m_inline)
+    , m_capacity(INLINE_CAPACITY)
+    , m_size(0)
+    , m_readPosition(0)
+    , m_integerEncoding(IntegerEncoding::Fixed)
+    , m_byteOrder(ByteOrder::Host)
+    , m_resource(resource) {
+    reserve(initialCapacity);
+}
+
+DataBuffer DataBuffer::borrow(const void* bytes, size_t size) noexcept {
+    DataBuffer view;
+    if (size > 0) {
+        // Capacity 0 marks the range as not ours: writes reallocate, release skips it
+        view.m_data = static_cast<uint8_t*>(const_cast<void*>(bytes));
+        view.m_capacity = 0;
+        view.m_size = size;
+    }
+    return view;
 }
 
-DataBuffer::~DataBuffer() = default;
+DataBuffer::~DataBuffer() {
+    releaseHeap();
+}
 
 DataBuffer::DataBuffer(DataBuffer&& other) noexcept
-    : m_buffer(std::move(other.m_buffer))
-    , m_size(other.m_size)
-    , m_readPosition(other.m_readPosition) {
-    other.m_size = 0;
-    other.m_readPosition = 0;
+    : m_data(m_inline)
+    , m_capacity(INLINE_CAPACITY)
+    , m_size(0)
+    , m_readPosition(0)
+    , m_integerEncoding(IntegerEncoding::Fixed)
+    , m_byteOrder(ByteOrder::Host)
+    , m_resource(nullptr) {
+    stealFrom(other);
 }
 
 DataBuffer& DataBuffer::operator=(DataBuffer&& other) noexcept {
     if (this != &other) {
-        m_buffer = std::move(other.m_buffer);
-        m_size = other.m_size;
-        m_readPosition = other.m_readPosition;
-        other.m_size = 0;
-        other.m_readPosition = 0;
+        releaseHeap();
+        stealFrom(other);
     }
     return *this;
 }
 
+void DataBuffer::stealFrom(DataBuffer& other) noexcept {
+    if (other.isInline()) {
+        // Small payload: copy the live bytes, there is no block to steal
+        if (other.m_size > 0) {
+            std::memcpy(m_inline, other.m_inline, other.m_size);
+        }
+        m_data = m_inline;
+        m_capacity = INLINE_CAPACITY;
+    } else {
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+    }
+    m_size = other.m_size;
+    m_readPosition = other.m_readPosition;
+    m_integerEncoding = other.m_integerEncoding;
+    m_byteOrder = other.m_byteOrder;
+    // The block (if stolen) must go back where it came from
+    m_resource = other.m_resource;
+
+    other.m_data = other.m_inline;
+    other.m_capacity = INLINE_CAPACITY;
+    other.m_size = 0;
+    other.m_readPosition = 0;
+}
+
+void DataBuffer::releaseHeap() noexcept {
+    if (!isInline()) {
+        if (!isBorrowed()) {
+            freeBlock(m_data, m_capacity);
+        }
+        m_data = m_inline;
+        m_capacity = INLINE_CAPACITY;
+    }
+}
+
+uint8_t* DataBuffer::allocateBlock(size_t bytes) {
+    if (m_resource) {
+        return static_cast<uint8_t*>(m_resource->allocate(bytes, alignof(std::max_align_t)));
+    }
+    return static_cast<uint8_t*>(::operator new(bytes));
+}
+
+void DataBuffer::freeBlock(uint8_t* block, size_t bytes) noexcept {
+    if (m_resource) {
+        m_resource->deallocate(block, bytes, alignof(std::max_align_t));
+    } else {
+        ::operator delete(block);
+    }
+}
+
+std::pmr::memory_resource* DataBuffer::resource() const noexcept {
+    return m_resource;
+}
+
 const uint8_t* DataBuffer::data() const noexcept {
-    return m_buffer.data();
+    return m_data;
 }
 
 size_t DataBuffer::size() const noexcept {
@@ -41,7 +139,15 @@ size_t DataBuffer::size() const noexcept {
 }
 
 size_t DataBuffer::capacity() const noexcept {
-    return m_buffer.capacity();
+    return m_capacity;
+}
+
+bool DataBuffer::isInline() const noexcept {
+    return m_data == m_inline;
+}
+
+bool DataBuffer::isBorrowed() const noexcept {
+    return m_data != m_inline && m_capacity == 0;
 }
 
 bool DataBuffer::empty() const noexcept {
@@ -64,44 +170,234 @@ void DataBuffer::seek(size_t pos) {
 }
 
 void DataBuffer::clear() noexcept {
+    if (isBorrowed()) {
+        releaseHeap();
+    }
     m_size = 0;
     m_readPosition = 0;
 }
 
 void DataBuffer::reserve(size_t newCapacity) {
-    m_buffer.reserve(newCapacity);
+    if (newCapacity <= m_capacity) {
+        return;
+    }
+    uint8_t* fresh = allocateBlock(newCapacity);
+    if (m_size > 0) {
+        std::memcpy(fresh, m_data, m_size);
+    }
+    releaseHeap();
+    m_data = fresh;
+    m_capacity = newCapacity;
 }
 
-// Support spécial pour les std::string
-DataBuffer& DataBuffer::operator<<(const std::string& str) {
-    // Écrire d'abord la taille de la chaîne
-    const size_t length = str.length();
-    *this << length;
+void DataBuffer::grow(size_t required) {
+    // Doubling keeps appends amortized O(1); never allocate less than asked.
+    size_t newCapacity = m_capacity ? m_capacity * 2 : kMinimumCapacity;
+    if (newCapacity < required) {
+        newCapacity = required;
+    }
+    reserve(newCapacity);
+}
 
-    // Ensuite écrire le contenu de la chaîne
-    const size_t currentSize = m_size;
+void DataBuffer::write(const void* src, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    ensureCapacity(m_size + n);
+    std::memcpy(m_data + m_size, src, n);
+    m_size += n;
+}
 
-    // Redimensionner le buffer pour accueillir la chaîne
-    m_buffer.resize(currentSize + length);
+std::span<uint8_t> DataBuffer::extend(size_t n) {
+    ensureCapacity(m_size + n);
+    std::span<uint8_t> fresh(m_data + m_size, n);
+    m_size += n;
+    return fresh;
+}
 
-    // Copier le contenu de la chaîne
-    std::memcpy(m_buffer.data() + currentSize, str.data(), length);
-    m_size = currentSize + length;
+void DataBuffer::truncate(size_t newSize) noexcept {
+    if (newSize >= m_size) {
+        return;
+    }
+    m_size = newSize;
+    if (m_readPosition > m_size) {
+        m_readPosition = m_size;
+    }
+}
+
+void DataBuffer::read(void* dst, size_t n) {
+    if (n > m_size - m_readPosition) {
+        throw std::out_of_range("Not enough data in buffer to read value");
+    }
+    if (n > 0) {
+        std::memcpy(dst, m_data + m_readPosition, n);
+    }
+    m_readPosition += n;
+}
+
+void DataBuffer::setIntegerEncoding(IntegerEncoding encoding) noexcept {
+    m_integerEncoding = encoding;
+}
+
+DataBuffer::IntegerEncoding DataBuffer::integerEncoding() const noexcept {
+    return m_integerEncoding;
+}
+
+void DataBuffer::setByteOrder(ByteOrder order) noexcept {
+    m_byteOrder = order;
+}
+
+DataBuffer::ByteOrder DataBuffer::byteOrder() const noexcept {
+    return m_byteOrder;
+}
+
+void DataBuffer::writeSwapped(const void* src, size_t count, size_t width) {
+    if (count == 0) {
+        return;
+    }
+    ensureCapacity(m_size + count * width);
+    byte_swap_copy(m_data + m_size, src, count, width);
+    m_size += count * width;
+}
+
+size_t DataBuffer::varintSize(uint64_t value) noexcept {
+    // 7 payload bits per byte; value | 1 keeps zero at one byte
+    return static_cast<size_t>((std::bit_width(value | 1) + 6) / 7);
+}
+
+void DataBuffer::writeVarint(uint64_t value) {
+    ensureCapacity(m_size + MAX_VARINT_SIZE);
+    uint8_t* out = m_data + m_size;
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    m_size = static_cast<size_t>(out - m_data);
+}
+
+uint64_t DataBuffer::readVarintSlow() {
+    uint64_t result = 0;
+    for (size_t i = 0; i < MAX_VARINT_SIZE; ++i) {
+        if (m_readPosition >= m_size) {
+            throw std::out_of_range("Not enough data in buffer to read varint");
+        }
+        uint8_t byte = m_data[m_readPosition++];
+        if (i == MAX_VARINT_SIZE - 1 && byte > 1) {
+            throw std::out_of_range("Varint overflows 64 bits");
+        }
+        result |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            return result;
+        }
+    }
+    throw std::out_of_range("Varint overflows 64 bits");
+}
+
+uint64_t DataBuffer::readVarint() {
+    if constexpr (std::endian::native == std::endian::little) {
+        if (m_size - m_readPosition >= sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, m_data + m_readPosition, sizeof(word));
+
+            // One load finds the terminating byte: its high bit is clear
+            const uint64_t stops = ~word & 0x8080808080808080ULL;
+            if (stops != 0) {
+                const size_t length = static_cast<size_t>(std::countr_zero(stops)) / 8 + 1;
+                uint64_t x = word;
+                if (length < 8) {
+                    x &= (uint64_t(1) << (8 * length)) - 1;
+                }
+                // Compact the 7-bit groups pairwise: 8x7 -> 4x14 -> 2x28 -> 1x56 bits
+                x &= 0x7F7F7F7F7F7F7F7FULL;
+                x = ((x & 0x7F007F007F007F00ULL) >> 1) | (x & 0x007F007F007F007FULL);
+                x = ((x & 0x3FFF00003FFF0000ULL) >> 2) | (x & 0x00003FFF00003FFFULL);
+                x = ((x & 0x0FFFFFFF00000000ULL) >> 4) | (x & 0x000000000FFFFFFFULL);
+                m_readPosition += length;
+                return x;
+            }
+        }
+    }
+    // Values above 56 bits, short tails and big-endian hosts
+    return readVarintSlow();
+}
+
+void DataBuffer::writeZigZag(int64_t value) {
+    writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+int64_t DataBuffer::readZigZag() {
+    uint64_t raw = readVarint();
+    return static_cast<int64_t>((raw >> 1) ^ (~(raw & 1) + 1));
+}
+
+void DataBuffer::writeLength(size_t length) {
+    if (m_integerEncoding == IntegerEncoding::Varint) {
+        writeVarint(length);
+    } else {
+        *this << length;
+    }
+}
+
+size_t DataBuffer::readLength() {
+    if (m_integerEncoding == IntegerEncoding::Varint) {
+        return static_cast<size_t>(readVarint());
+    }
+    size_t length;
+    *this >> length;
+    return length;
+}
+
+size_t DataBuffer::readCount(size_t minBytes) {
+    const size_t count = readLength();
+    if (minBytes > 0 && count > (m_size - m_readPosition) / minBytes) {
+        throw std::out_of_range("Not enough data in buffer for container elements");
+    }
+    return count;
+}
+
+std::span<const uint8_t> DataBuffer::readBytes(size_t n) {
+    if (n > m_size - m_readPosition) {
+        throw std::out_of_range("Not enough data in buffer to read bytes");
+    }
+    std::span<const uint8_t> view(m_data + m_readPosition, n);
+    m_readPosition += n;
+    return view;
+}
+
+std::string_view DataBuffer::readStringView() {
+    const size_t length = readLength();
+
+    if (length > m_size - m_readPosition) {
+        throw std::out_of_range("Not enough data in buffer to read string");
+    }
+
+    std::string_view view(reinterpret_cast<const char*>(m_data + m_readPosition), length);
+    m_readPosition += length;
+    return view;
+}
+
+// Support spécial pour les std::string
+DataBuffer& DataBuffer::operator<<(const std::string& str) {
+    // Écrire d'abord la taille de la chaîne, puis son contenu
+    const size_t length = str.length();
+    ensureCapacity(m_size + serializedSize(str));
+    writeLength(length);
+    write(str.data(), length);
 
     return *this;
 }
 
 DataBuffer& DataBuffer::operator>>(std::string& str) {
     // Lire d'abord la taille de la chaîne
-    size_t length;
-    *this >> length;
+    const size_t length = readLength();
 
-    if (m_readPosition + length > m_size) {
+    if (length > m_size - m_readPosition) {
         throw std::out_of_range("Not enough data in buffer to read string");
     }
 
     // Construire la chaîne à partir des données
-    str.assign(reinterpret_cast<const char*>(m_buffer.data() + m_readPosition), length);
+    str.assign(reinterpret_cast<const char*>(m_data + m_readPosition), length);
     m_readPosition += length;
 
     return *this;
@@ -0,0 +1,222 @@
+#include "data_structures/memory_resource.hpp"
+#include <bit>
+#include <new>
+
+namespace {
+
+// Slabs of classes at least this big are aligned to a page at most
+constexpr size_t kMaxSlabAlignment = 4096;
+
+}
+
+// SizeClassResource
+
+SizeClassResource::SizeClassResource(size_t maxBlockSize, size_t slabSize, std::pmr::memory_resource* p_upstream)
+    : upstream(p_upstream ? p_upstream : std::pmr::new_delete_resource())
+    , slabBytes(slabSize) {
+    if (maxBlockSize < MIN_BLOCK_SIZE) {
+        maxBlockSize = MIN_BLOCK_SIZE;
+    }
+    maxBlockSize = std::bit_ceil(maxBlockSize);
+    for (size_t size = MIN_BLOCK_SIZE; size <= maxBlockSize; size *= 2) {
+        classes.push_back(SizeClass{size, nullptr, nullptr, nullptr});
+    }
+}
+
+SizeClassResource::~SizeClassResource() {
+    release();
+}
+
+void SizeClassResource::release() noexcept {
+    for (const Slab& slab : slabs) {
+        upstream->deallocate(slab.memory, slab.bytes, slab.alignment);
+    }
+    slabs.clear();
+    for (SizeClass& sizeClass : classes) {
+        sizeClass.freeList = nullptr;
+        sizeClass.cursor = nullptr;
+        sizeClass.end = nullptr;
+    }
+}
+
+size_t SizeClassResource::classCount() const noexcept {
+    return classes.size();
+}
+
+size_t SizeClassResource::slabCount() const noexcept {
+    return slabs.size();
+}
+
+std::pmr::memory_resource* SizeClassResource::upstreamResource() const noexcept {
+    return upstream;
+}
+
+size_t SizeClassResource::classIndex(size_t bytes, size_t alignment) const noexcept {
+    size_t size = bytes > alignment ? bytes : alignment;
+    if (size < MIN_BLOCK_SIZE) {
+        size = MIN_BLOCK_SIZE;
+    }
+    if (size > classes.back().blockSize || alignment > kMaxSlabAlignment) {
+        return classes.size();
+    }
+    // Classes are consecutive powers of two starting at MIN_BLOCK_SIZE
+    return static_cast<size_t>(std::bit_width(std::bit_ceil(size)) - std::bit_width(MIN_BLOCK_SIZE));
+}
+
+size_t SizeClassResource::blockSizeFor(size_t bytes, size_t alignment) const noexcept {
+    const size_t index = classIndex(bytes, alignment);
+    return index < classes.size() ? classes[index].blockSize : 0;
+}
+
+void SizeClassResource::refill(SizeClass& sizeClass) {
+    const size_t bytes = slabBytes > sizeClass.blockSize ? slabBytes / sizeClass.blockSize * sizeClass.blockSize
+                                                         : sizeClass.blockSize;
+    // A block aligned to its own size satisfies any alignment up to that size
+    const size_t alignment = sizeClass.blockSize < kMaxSlabAlignment ? sizeClass.blockSize : kMaxSlabAlignment;
+    slabs.reserve(slabs.size() + 1);
+    void* memory = upstream->allocate(bytes, alignment);
+    slabs.push_back(Slab{memory, bytes, alignment});
+    // Blocks are carved lazily, so untouched slab pages stay untouched
+    sizeClass.cursor = static_cast<unsigned char*>(memory);
+    sizeClass.end = sizeClass.cursor + bytes;
+}
+
+void* SizeClassResource::do_allocate(size_t bytes, size_t alignment) {
+    const size_t index = classIndex(bytes, alignment);
+    if (index == classes.size()) {
+        return upstream->allocate(bytes, alignment);
+    }
+    SizeClass& sizeClass = classes[index];
+    if (FreeBlock* block = sizeClass.freeList) {
+        sizeClass.freeList = block->next;
+        return block;
+    }
+    if (sizeClass.cursor == sizeClass.end) {
+        refill(sizeClass);
+    }
+    void* block = sizeClass.cursor;
+    sizeClass.cursor += sizeClass.blockSize;
+    return block;
+}
+
+void SizeClassResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    const size_t index = classIndex(bytes, alignment);
+    if (index == classes.size()) {
+        upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+    SizeClass& sizeClass = classes[index];
+    FreeBlock* block = ::new (p) FreeBlock{sizeClass.freeList};
+    sizeClass.freeList = block;
+}
+
+bool SizeClassResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// FrameArena
+
+FrameArena::FrameArena(size_t initialBlockSize, std::pmr::memory_resource* p_upstream)
+    : upstream(p_upstream ? p_upstream : std::pmr::new_delete_resource())
+    , current(0)
+    , used(0)
+    , allocated(0)
+    , nextBlockSize(initialBlockSize ? initialBlockSize : DEFAULT_BLOCK_SIZE) {
+}
+
+FrameArena::FrameArena(void* buffer, size_t bufferSize, std::pmr::memory_resource* p_upstream)
+    : upstream(p_upstream ? p_upstream : std::pmr::new_delete_resource())
+    , current(0)
+    , used(0)
+    , allocated(0)
+    , nextBlockSize(bufferSize ? bufferSize * 2 : DEFAULT_BLOCK_SIZE) {
+    if (buffer && bufferSize) {
+        blocks.push_back(Block{static_cast<unsigned char*>(buffer), bufferSize, false});
+    }
+}
+
+FrameArena::~FrameArena() {
+    release();
+}
+
+void FrameArena::reset() noexcept {
+    current = 0;
+    used = 0;
+    allocated = 0;
+}
+
+void FrameArena::release() noexcept {
+    reset();
+    // Only the caller's buffer (always first) survives
+    size_t kept = 0;
+    for (const Block& block : blocks) {
+        if (block.owned) {
+            upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+        } else {
+            blocks[kept++] = block;
+        }
+    }
+    blocks.resize(kept);
+}
+
+size_t FrameArena::bytesAllocated() const noexcept {
+    return allocated;
+}
+
+size_t FrameArena::capacity() const noexcept {
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+size_t FrameArena::blockCount() const noexcept {
+    return blocks.size();
+}
+
+void* FrameArena::tryBump(size_t bytes, size_t alignment) noexcept {
+    const Block& block = blocks[current];
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+    const uintptr_t start = (base + used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t offset = static_cast<size_t>(start - base);
+    if (offset > block.size || block.size - offset < bytes) {
+        return nullptr;
+    }
+    allocated += offset + bytes - used;
+    used = offset + bytes;
+    return block.data + offset;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    // Current block, then the blocks kept from earlier frames
+    while (current < blocks.size()) {
+        if (void* p = tryBump(bytes, alignment)) {
+            return p;
+        }
+        ++current;
+        used = 0;
+    }
+    size_t size = nextBlockSize;
+    while (size < bytes + alignment) {
+        size *= 2;
+    }
+    blocks.reserve(blocks.size() + 1);
+    unsigned char* data = static_cast<unsigned char*>(upstream->allocate(size, alignof(std::max_align_t)));
+    blocks.push_back(Block{data, size, true});
+    nextBlockSize = size * 2;
+    current = blocks.size() - 1;
+    used = 0;
+    return tryBump(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t) {
+    // Monotonic: memory comes back at reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,47 @@
+#include "data_structures/pool_stats.hpp"
+#include <chrono>
+#include <sstream>
+
+uint64_t PoolLatencyHistogram::percentile(double p) const noexcept {
+    if (total == 0) {
+        return 0;
+    }
+    if (p < 0.0) p = 0.0;
+    if (p > 1.0) p = 1.0;
+    // Rank of the sample we are looking for, 1-based
+    uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total) + 0.5);
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return uint64_t(1) << (i + 1);
+        }
+    }
+    return uint64_t(1) << BUCKETS;
+}
+
+void PoolLatencyHistogram::clear() noexcept {
+    for (auto &c : counts) c = 0;
+    total = 0;
+}
+
+double PoolStats::averageLifetimeNs() const noexcept {
+    return releases == 0 ? 0.0 : static_cast<double>(totalLifetimeNs) / static_cast<double>(releases);
+}
+
+std::string PoolStats::toString() const {
+    std::ostringstream out;
+    out << "used " << used << "/" << capacity << " (peak " << peak << ")"
+        << ", acquires " << acquires << ", releases " << releases
+        << ", failed acquires " << failedAcquires
+        << ", acquire p50/p99 < " << acquireLatency.percentile(0.5) << "/" << acquireLatency.percentile(0.99) << " ns"
+        << ", release p50/p99 < " << releaseLatency.percentile(0.5) << "/" << releaseLatency.percentile(0.99) << " ns"
+        << ", average lifetime " << static_cast<uint64_t>(averageLifetimeNs()) << " ns";
+    return out.str();
+}
+
+uint64_t pool_stats_now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
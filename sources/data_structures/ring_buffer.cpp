@@ -0,0 +1,173 @@
+#include "data_structures/ring_buffer.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr size_t MIN_CAPACITY = 64;
+
+}
+
+RingBuffer::RingBuffer() noexcept
+    : m_data(nullptr)
+    , m_capacity(0)
+    , m_head(0)
+    , m_size(0) {
+}
+
+RingBuffer::RingBuffer(size_t capacity)
+    : RingBuffer() {
+    if (capacity > 0) grow(capacity);
+}
+
+RingBuffer::~RingBuffer() {
+    delete[] m_data;
+}
+
+RingBuffer::RingBuffer(RingBuffer&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_capacity(std::exchange(other.m_capacity, 0))
+    , m_head(std::exchange(other.m_head, 0))
+    , m_size(std::exchange(other.m_size, 0)) {
+}
+
+RingBuffer& RingBuffer::operator=(RingBuffer&& other) noexcept {
+    if (this != &other) {
+        delete[] m_data;
+        m_data = std::exchange(other.m_data, nullptr);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_head = std::exchange(other.m_head, 0);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+size_t RingBuffer::size() const noexcept {
+    return m_size;
+}
+
+bool RingBuffer::empty() const noexcept {
+    return m_size == 0;
+}
+
+size_t RingBuffer::capacity() const noexcept {
+    return m_capacity;
+}
+
+void RingBuffer::reserve(size_t n) {
+    if (m_capacity - m_size < n) grow(m_size + n);
+}
+
+void RingBuffer::makeContiguous(size_t n) {
+    if (n > m_capacity) {
+        grow(n);
+        return;
+    }
+    if (m_head + n <= m_capacity) return;
+    if (m_head + m_size <= m_capacity) {
+        // Queued bytes in one piece: slide them down in place
+        if (m_size > 0) std::memmove(m_data, m_data + m_head, m_size);
+        m_head = 0;
+        return;
+    }
+    relocate(m_capacity);
+}
+
+void RingBuffer::grow(size_t minimum) {
+    size_t capacity = m_capacity ? m_capacity : MIN_CAPACITY;
+    while (capacity < minimum) capacity *= 2;
+    if (capacity == m_capacity) return;
+    relocate(capacity);
+}
+
+void RingBuffer::relocate(size_t capacity) {
+    uint8_t* data = new uint8_t[capacity];
+    // Linearize: the queued bytes start at index 0 of the new array
+    const size_t first = m_size < m_capacity - m_head ? m_size : m_capacity - m_head;
+    if (first > 0) std::memcpy(data, m_data + m_head, first);
+    if (m_size > first) std::memcpy(data + first, m_data, m_size - first);
+    delete[] m_data;
+    m_data = data;
+    m_capacity = capacity;
+    m_head = 0;
+}
+
+void RingBuffer::write(const void* src, size_t n) {
+    if (n == 0) return;
+    reserve(n);
+    const uint8_t* bytes = static_cast<const uint8_t*>(src);
+    const size_t tail = (m_head + m_size) & (m_capacity - 1);
+    const size_t first = n < m_capacity - tail ? n : m_capacity - tail;
+    std::memcpy(m_data + tail, bytes, first);
+    if (n > first) std::memcpy(m_data, bytes + first, n - first);
+    m_size += n;
+}
+
+void RingBuffer::peek(void* dst, size_t n, size_t offset) const {
+    if (offset > m_size || n > m_size - offset) throw std::out_of_range("RingBuffer: not enough bytes");
+    if (n == 0) return;
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    const size_t start = (m_head + offset) & (m_capacity - 1);
+    const size_t first = n < m_capacity - start ? n : m_capacity - start;
+    std::memcpy(out, m_data + start, first);
+    if (n > first) std::memcpy(out + first, m_data, n - first);
+}
+
+const uint8_t* RingBuffer::contiguous(size_t offset, size_t n) const noexcept {
+    if (offset > m_size || n > m_size - offset || m_capacity == 0) return nullptr;
+    const size_t start = (m_head + offset) & (m_capacity - 1);
+    if (n > m_capacity - start) return nullptr;
+    return m_data + start;
+}
+
+void RingBuffer::read(void* dst, size_t n) {
+    peek(dst, n);
+    consume(n);
+}
+
+void RingBuffer::consume(size_t n) {
+    if (n > m_size) throw std::out_of_range("RingBuffer: not enough bytes");
+    m_size -= n;
+    // An empty queue restarts at 0 so the next write is one contiguous piece
+    m_head = m_size == 0 ? 0 : (m_head + n) & (m_capacity - 1);
+}
+
+size_t RingBuffer::readable(iovec out[2]) const noexcept {
+    if (m_size == 0) return 0;
+    const size_t first = m_size < m_capacity - m_head ? m_size : m_capacity - m_head;
+    out[0] = iovec{m_data + m_head, first};
+    if (first == m_size) return 1;
+    out[1] = iovec{m_data, m_size - first};
+    return 2;
+}
+
+size_t RingBuffer::writable(iovec out[2], size_t atLeast) {
+    reserve(atLeast);
+    const size_t free = m_capacity - m_size;
+    if (free == 0) return 0;
+    const size_t tail = (m_head + m_size) & (m_capacity - 1);
+    const size_t first = free < m_capacity - tail ? free : m_capacity - tail;
+    out[0] = iovec{m_data + tail, first};
+    if (first == free) return 1;
+    out[1] = iovec{m_data, free - first};
+    return 2;
+}
+
+void RingBuffer::commit(size_t n) {
+    if (n > m_capacity - m_size) throw std::out_of_range("RingBuffer: commit past the free space");
+    m_size += n;
+}
+
+void RingBuffer::clear() noexcept {
+    m_head = 0;
+    m_size = 0;
+}
+
+void RingBuffer::shrink() noexcept {
+    if (m_size != 0) return;
+    delete[] m_data;
+    m_data = nullptr;
+    m_capacity = 0;
+    m_head = 0;
+}
@@ -0,0 +1,196 @@
+#include "data_structures/segmented_buffer.hpp"
+#include <new>
+
+SegmentedBuffer::SegmentedBuffer() noexcept
+    : m_pool(nullptr)
+    , m_size(0)
+    , m_readPosition(0)
+    , m_readChunk(0)
+    , m_readOffset(0) {
+}
+
+SegmentedBuffer::SegmentedBuffer(SegmentPool& pool) noexcept
+    : m_pool(&pool)
+    , m_size(0)
+    , m_readPosition(0)
+    , m_readChunk(0)
+    , m_readOffset(0) {
+}
+
+SegmentedBuffer::~SegmentedBuffer() {
+    clear();
+}
+
+SegmentedBuffer::SegmentedBuffer(SegmentedBuffer&& other) noexcept
+    : m_chunks(std::move(other.m_chunks))
+    , m_pool(other.m_pool)
+    , m_size(other.m_size)
+    , m_readPosition(other.m_readPosition)
+    , m_readChunk(other.m_readChunk)
+    , m_readOffset(other.m_readOffset) {
+    other.m_chunks.clear();
+    other.m_size = 0;
+    other.m_readPosition = 0;
+    other.m_readChunk = 0;
+    other.m_readOffset = 0;
+}
+
+SegmentedBuffer& SegmentedBuffer::operator=(SegmentedBuffer&& other) noexcept {
+    if (this != &other) {
+        clear();
+        m_chunks = std::move(other.m_chunks);
+        m_pool = other.m_pool;
+        m_size = other.m_size;
+        m_readPosition = other.m_readPosition;
+        m_readChunk = other.m_readChunk;
+        m_readOffset = other.m_readOffset;
+        other.m_chunks.clear();
+        other.m_size = 0;
+        other.m_readPosition = 0;
+        other.m_readChunk = 0;
+        other.m_readOffset = 0;
+    }
+    return *this;
+}
+
+size_t SegmentedBuffer::size() const noexcept {
+    return m_size;
+}
+
+bool SegmentedBuffer::empty() const noexcept {
+    return m_size == 0;
+}
+
+size_t SegmentedBuffer::segmentCount() const noexcept {
+    return m_chunks.size();
+}
+
+size_t SegmentedBuffer::readPosition() const noexcept {
+    return m_readPosition;
+}
+
+void SegmentedBuffer::rewind() noexcept {
+    m_readPosition = 0;
+    m_readChunk = 0;
+    m_readOffset = 0;
+}
+
+void SegmentedBuffer::clear() noexcept {
+    for (auto& chunk : m_chunks) {
+        releaseSegment(chunk);
+    }
+    m_chunks.clear();
+    m_size = 0;
+    rewind();
+}
+
+void SegmentedBuffer::addSegment() {
+    // Reserve the descriptor first so a failing push_back cannot leak a segment
+    m_chunks.reserve(m_chunks.size() + 1);
+
+    Chunk chunk{nullptr, 0, nullptr};
+    if (m_pool) {
+        chunk.pooled = m_pool->try_acquire();
+        if (chunk.pooled) {
+            chunk.data = (*chunk.pooled)->bytes;
+        }
+    }
+    if (!chunk.data) {
+        chunk.data = static_cast<uint8_t*>(::operator new(SEGMENT_SIZE));
+    }
+    m_chunks.push_back(chunk);
+}
+
+void SegmentedBuffer::releaseSegment(Chunk& chunk) noexcept {
+    if (chunk.pooled) {
+        try { m_pool->release(*chunk.pooled); } catch (...) {}
+    } else {
+        ::operator delete(chunk.data);
+    }
+    chunk.data = nullptr;
+    chunk.pooled = nullptr;
+}
+
+void SegmentedBuffer::write(const void* src, size_t n) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    while (n > 0) {
+        if (m_chunks.empty() || m_chunks.back().used == SEGMENT_SIZE) {
+            addSegment();
+        }
+        Chunk& tail = m_chunks.back();
+        size_t room = SEGMENT_SIZE - tail.used;
+        size_t count = n < room ? n : room;
+        std::memcpy(tail.data + tail.used, in, count);
+        tail.used += count;
+        m_size += count;
+        in += count;
+        n -= count;
+    }
+}
+
+void SegmentedBuffer::read(void* dst, size_t n) {
+    if (n > m_size - m_readPosition) {
+        throw std::out_of_range("Not enough data in buffer to read value");
+    }
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    m_readPosition += n;
+    while (n > 0) {
+        const Chunk& chunk = m_chunks[m_readChunk];
+        size_t left = chunk.used - m_readOffset;
+        size_t count = n < left ? n : left;
+        std::memcpy(out, chunk.data + m_readOffset, count);
+        out += count;
+        n -= count;
+        m_readOffset += count;
+        if (m_readOffset == SEGMENT_SIZE) {
+            ++m_readChunk;
+            m_readOffset = 0;
+        }
+    }
+}
+
+size_t SegmentedBuffer::exportIovecs(std::vector<iovec>& out) const {
+    out.reserve(out.size() + m_chunks.size());
+    size_t count = 0;
+    for (const auto& chunk : m_chunks) {
+        if (chunk.used == 0) {
+            continue;
+        }
+        out.push_back(iovec{chunk.data, chunk.used});
+        ++count;
+    }
+    return count;
+}
+
+std::vector<iovec> SegmentedBuffer::iovecs() const {
+    std::vector<iovec> out;
+    exportIovecs(out);
+    return out;
+}
+
+void SegmentedBuffer::copyTo(DataBuffer& out) const {
+    out.reserve(out.size() + m_size);
+    for (const auto& chunk : m_chunks) {
+        out.write(chunk.data, chunk.used);
+    }
+}
+
+SegmentedBuffer& SegmentedBuffer::operator<<(const std::string& str) {
+    const size_t length = str.length();
+    *this << length;
+    write(str.data(), length);
+    return *this;
+}
+
+SegmentedBuffer& SegmentedBuffer::operator>>(std::string& str) {
+    size_t length;
+    *this >> length;
+
+    if (length > m_size - m_readPosition) {
+        throw std::out_of_range("Not enough data in buffer to read string");
+    }
+
+    str.resize(length);
+    read(str.data(), length);
+    return *this;
+}
@@ -1,5 +1,8 @@
 #include "networking/client.hpp"
+#include "networking/socket_io.hpp"
+#include "networking/compression.hpp"
 #include <sys/socket.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
@@ -32,6 +35,8 @@ void Client::connect(const std::string& address, const size_t& port) {
         _sock = -1;
         throw std::runtime_error("connect()");
     }
+    if (_no_delay) set_tcp_option(_sock, TCP_NODELAY, true);
+    if (_cork) set_tcp_option(_sock, TCP_CORK, true);
 
     _running = true;
     // background reader
@@ -41,7 +46,10 @@ void Client::connect(const std::string& address, const size_t& port) {
             ssize_t r = ::recv(_sock, &netlen, sizeof(netlen), MSG_WAITALL);
             if (r <= 0) break;
             uint32_t len = ntohl(netlen);
+            const bool compressed = (len & FRAME_COMPRESSED_FLAG) != 0;
+            len &= ~FRAME_COMPRESSED_FLAG;
             if (len == 0) continue;
+            if (len > MAX_FRAME_SIZE) break;
             std::vector<uint8_t> buf(len);
             r = ::recv(_sock, buf.data(), len, MSG_WAITALL);
             if (r <= 0) break;
@@ -51,11 +59,17 @@ void Client::connect(const std::string& address, const size_t& port) {
                 std::memcpy(&net_t, buf.data(), 4);
                 int32_t t = ntohl(net_t);
                 Message m(static_cast<int>(t));
-                if (buf.size() > 4) {
+                if (compressed) {
+                    try {
+                        decompress_frame_payload(buf.data() + 4, buf.size() - 4, MAX_FRAME_SIZE, m.payload());
+                    } catch (const std::exception&) {
+                        break; // corrupt stream, stop reading
+                    }
+                } else if (buf.size() > 4) {
                     // payload after type
                     m.payload().clear();
                     m.payload().reserve(buf.size() - 4);
-                    for (size_t i = 4; i < buf.size(); ++i) m.payload() << buf[i];
+                    m.payload().write(buf.data() + 4, buf.size() - 4);
                 }
                 std::lock_guard<std::mutex> lg(_m);
                 _inbox.push(std::move(m));
@@ -81,34 +95,42 @@ void Client::defineAction(const Message::Type& messageType, const MessageHandler
 
 void Client::send(const Message& message) {
     if (_sock < 0) return;
-    // framing: [len(uint32_t)][type(int32_t)][payload]
-    std::vector<uint8_t> buf;
-    int32_t t = static_cast<int32_t>(message.type());
-    int32_t net_t = htonl(t);
-    const uint8_t *tp = reinterpret_cast<const uint8_t*>(&net_t);
-    buf.insert(buf.end(), tp, tp + sizeof(net_t));
-    const auto &p = message.payload();
-    const uint8_t *pdata = p.data();
-    size_t psz = p.size();
-    if (pdata && psz > 0) buf.insert(buf.end(), pdata, pdata + psz);
-    uint32_t len = static_cast<uint32_t>(buf.size());
-    uint32_t netlen = htonl(len);
-    // send length
-    const uint8_t *len_ptr = reinterpret_cast<const uint8_t*>(&netlen);
-    size_t to_write = sizeof(netlen);
-    while (to_write > 0) {
-        ssize_t w = ::send(_sock, len_ptr + (sizeof(netlen) - to_write), static_cast<size_t>(to_write), 0);
-        if (w <= 0) return; // write error
-        to_write -= static_cast<size_t>(w);
-    }
-    // send payload
-    const uint8_t *data_ptr = buf.data();
-    to_write = len;
-    while (to_write > 0) {
-        ssize_t w = ::send(_sock, data_ptr + (len - to_write), to_write, 0);
-        if (w <= 0) return;
-        to_write -= static_cast<size_t>(w);
-    }
+    // framing: [len(uint32_t)][type(int32_t)][payload], optionally compressed
+    send_message_frame(_sock, message, _compression_threshold);
+}
+
+void Client::setCompressionThreshold(size_t bytes) {
+    _compression_threshold = bytes;
+}
+
+size_t Client::compressionThreshold() const {
+    return _compression_threshold;
+}
+
+void Client::send(const Message::Type& messageType, const SegmentedBuffer& payload) {
+    if (_sock < 0) return;
+    uint8_t header[FRAME_HEADER_SIZE];
+    encode_frame_header(header, static_cast<int32_t>(messageType), payload.size());
+    std::vector<iovec> iov;
+    iov.reserve(payload.segmentCount() + 1);
+    iov.push_back(iovec{header, sizeof(header)});
+    payload.exportIovecs(iov);
+    send_all_iovecs(_sock, iov.data(), iov.size());
+}
+
+void Client::sendBatch(const std::vector<Message>& messages) {
+    if (_sock < 0 || messages.empty()) return;
+    send_message_frames(_sock, messages.data(), messages.size(), _compression_threshold);
+}
+
+void Client::setNoDelay(bool enabled) {
+    _no_delay = enabled;
+    if (_sock >= 0) set_tcp_option(_sock, TCP_NODELAY, enabled);
+}
+
+void Client::setCork(bool enabled) {
+    _cork = enabled;
+    if (_sock >= 0) set_tcp_option(_sock, TCP_CORK, enabled);
 }
 
 void Client::update() {
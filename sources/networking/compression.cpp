@@ -0,0 +1,240 @@
+#include "networking/compression.hpp"
+#include <arpa/inet.h>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr unsigned kHashBits = 12;
+// The last bytes are always emitted as literals, which lets match search
+// read whole words without checking the end of the input each time.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchSearchMargin = 12;
+
+inline uint32_t load32(const uint8_t* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t load64(const uint8_t* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) noexcept {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+// Number of equal bytes at a and b, without reading past limit (on a's side)
+inline size_t commonLength(const uint8_t* a, const uint8_t* b, const uint8_t* limit) noexcept {
+    const uint8_t* start = a;
+    while (a + sizeof(uint64_t) <= limit) {
+        const uint64_t diff = load64(a) ^ load64(b);
+        if (diff != 0) {
+            const int bits = std::endian::native == std::endian::little ? std::countr_zero(diff) : std::countl_zero(diff);
+            return static_cast<size_t>(a - start) + static_cast<size_t>(bits / 8);
+        }
+        a += sizeof(uint64_t);
+        b += sizeof(uint64_t);
+    }
+    while (a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<size_t>(a - start);
+}
+
+// 255-continued length extension; returns false if out of room
+inline bool writeLength(uint8_t*& op, const uint8_t* oend, size_t length) noexcept {
+    while (length >= 255) {
+        if (op >= oend) return false;
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= oend) return false;
+    *op++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+inline bool emitSequence(uint8_t*& op, const uint8_t* oend, const uint8_t* literals, size_t literalLength,
+                         size_t offset, size_t matchLength) noexcept {
+    // token + literals + offset, extensions are checked as they are written
+    if (static_cast<size_t>(oend - op) < 1 + literalLength + 2) return false;
+    const size_t matchCode = matchLength - kMinMatch;
+    uint8_t* token = op++;
+    *token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+    if (literalLength >= 15 && !writeLength(op, oend, literalLength - 15)) return false;
+    if (static_cast<size_t>(oend - op) < literalLength + 2) return false;
+    std::memcpy(op, literals, literalLength);
+    op += literalLength;
+    *op++ = static_cast<uint8_t>(offset);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    *token |= static_cast<uint8_t>(matchCode < 15 ? matchCode : 15);
+    if (matchCode >= 15 && !writeLength(op, oend, matchCode - 15)) return false;
+    return true;
+}
+
+inline bool emitLastLiterals(uint8_t*& op, const uint8_t* oend, const uint8_t* literals, size_t literalLength) noexcept {
+    if (op >= oend) return false;
+    uint8_t* token = op++;
+    *token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+    if (literalLength >= 15 && !writeLength(op, oend, literalLength - 15)) return false;
+    if (static_cast<size_t>(oend - op) < literalLength) return false;
+    std::memcpy(op, literals, literalLength);
+    op += literalLength;
+    return true;
+}
+
+// Reads a 255-continued extension and adds it to length
+inline void readLength(const uint8_t*& ip, const uint8_t* iend, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= iend) throw std::runtime_error("lz_decompress: truncated length");
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+}
+
+}
+
+size_t lz_compress_bound(size_t srcSize) noexcept {
+    // all literals: one token, one extension byte per 255 bytes, the bytes
+    return srcSize + srcSize / 255 + 16;
+}
+
+size_t lz_compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) noexcept {
+    uint8_t* op = dst;
+    const uint8_t* oend = dst + dstCapacity;
+    const uint8_t* anchor = src;
+
+    if (srcSize > kMatchSearchMargin) {
+        uint32_t table[1u << kHashBits];
+        std::memset(table, 0, sizeof(table));
+
+        const uint8_t* ip = src + 1;
+        const uint8_t* matchLimit = src + srcSize - kLastLiterals;
+        const uint8_t* searchLimit = src + srcSize - kMatchSearchMargin;
+
+        while (ip < searchLimit) {
+            const uint32_t sequence = load32(ip);
+            const uint32_t h = hashSequence(sequence);
+            const uint8_t* candidate = src + table[h];
+            table[h] = static_cast<uint32_t>(ip - src);
+
+            if (candidate >= ip || static_cast<size_t>(ip - candidate) > kMaxOffset || load32(candidate) != sequence) {
+                // step faster through data that does not compress
+                ip += 1 + (static_cast<size_t>(ip - anchor) >> 6);
+                continue;
+            }
+
+            // extend backwards over pending literals
+            while (ip > anchor && candidate > src && ip[-1] == candidate[-1]) {
+                --ip;
+                --candidate;
+            }
+            const size_t matchLength = kMinMatch + commonLength(ip + kMinMatch, candidate + kMinMatch, matchLimit);
+
+            if (!emitSequence(op, oend, anchor, static_cast<size_t>(ip - anchor),
+                              static_cast<size_t>(ip - candidate), matchLength)) {
+                return 0;
+            }
+            ip += matchLength;
+            anchor = ip;
+
+            // seed the table inside the match so the next search finds it
+            if (ip < searchLimit) {
+                table[hashSequence(load32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+    }
+
+    if (!emitLastLiterals(op, oend, anchor, static_cast<size_t>(src + srcSize - anchor))) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+void lz_decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstSize;
+
+    while (true) {
+        if (ip >= iend) throw std::runtime_error("lz_decompress: truncated block");
+        const uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) readLength(ip, iend, literalLength);
+        if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op)) {
+            throw std::runtime_error("lz_decompress: literal run out of bounds");
+        }
+        if (literalLength <= 16 && iend - ip >= 16 && oend - op >= 16) {
+            // fixed-size copy: the extra bytes are overwritten by what follows
+            std::memcpy(op, ip, 16);
+        } else {
+            std::memcpy(op, ip, literalLength);
+        }
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == iend) break; // last sequence carries literals only
+
+        if (iend - ip < 2) throw std::runtime_error("lz_decompress: truncated offset");
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            throw std::runtime_error("lz_decompress: invalid match offset");
+        }
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15) readLength(ip, iend, matchLength);
+        matchLength += kMinMatch;
+        if (matchLength > static_cast<size_t>(oend - op)) {
+            throw std::runtime_error("lz_decompress: match out of bounds");
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= 16 && matchLength <= 16 && oend - op >= 16) {
+            std::memcpy(op, match, 16);
+            op += matchLength;
+        } else if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // Overlapping copy of a repeating pattern: [match, op) is periodic,
+            // so each copy can be as long as everything produced so far
+            while (matchLength > 0) {
+                const size_t available = static_cast<size_t>(op - match);
+                const size_t chunk = available < matchLength ? available : matchLength;
+                std::memcpy(op, match, chunk);
+                op += chunk;
+                matchLength -= chunk;
+            }
+        }
+    }
+
+    if (op != oend) throw std::runtime_error("lz_decompress: size mismatch");
+}
+
+void decompress_frame_payload(const uint8_t* body, size_t size, size_t maxRawSize, DataBuffer& out) {
+    uint32_t netRaw = 0;
+    if (size < sizeof(netRaw)) throw std::runtime_error("compressed frame too small");
+    std::memcpy(&netRaw, body, sizeof(netRaw));
+    const size_t rawSize = ntohl(netRaw);
+    if (rawSize > maxRawSize) throw std::runtime_error("compressed frame too large");
+
+    const size_t start = out.size();
+    std::span<uint8_t> target = out.extend(rawSize);
+    try {
+        lz_decompress(body + sizeof(netRaw), size - sizeof(netRaw), target.data(), rawSize);
+    } catch (...) {
+        out.truncate(start);
+        throw;
+    }
+}
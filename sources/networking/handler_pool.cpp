@@ -0,0 +1,102 @@
+#include "networking/handler_pool.hpp"
+#include <stdexcept>
+
+namespace {
+
+// Messages a worker takes from one strand before letting other strands run
+constexpr size_t STRAND_BATCH = 32;
+
+}
+
+HandlerPool::HandlerPool(size_t threads, size_t capacity, Runner run, std::function<void()> onSpace)
+    : _capacity(capacity), _run(std::move(run)), _on_space(std::move(onSpace)) {
+    if (threads == 0) throw std::invalid_argument("HandlerPool needs at least one thread");
+    if (capacity == 0) throw std::invalid_argument("HandlerPool capacity must be greater than 0");
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        _workers.emplace_back([this]() { work(); });
+    }
+}
+
+HandlerPool::~HandlerPool() {
+    stop();
+}
+
+void HandlerPool::submit(Key key, Message&& message) {
+    {
+        std::lock_guard<std::mutex> lg(_m);
+        if (_stopping) return;
+        Strand &strand = _strands[key];
+        strand.messages.push_back(std::move(message));
+        if (++_pending >= _capacity) _was_full = true;
+        if (strand.scheduled) return; // the worker running it will see the message
+        strand.scheduled = true;
+        _ready.push_back(key);
+    }
+    _cv.notify_one();
+}
+
+bool HandlerPool::full() const noexcept {
+    return _pending.load(std::memory_order_relaxed) >= _capacity;
+}
+
+size_t HandlerPool::pending() const noexcept {
+    return _pending.load(std::memory_order_relaxed);
+}
+
+void HandlerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lg(_m);
+        if (_stopping && _workers.empty()) return;
+        _stopping = true;
+    }
+    _cv.notify_all();
+    for (auto &t : _workers) {
+        if (t.joinable()) t.join();
+    }
+    _workers.clear();
+    std::lock_guard<std::mutex> lg(_m);
+    _strands.clear();
+    _ready.clear();
+    _pending = 0;
+}
+
+void HandlerPool::work() {
+    std::vector<Message> batch;
+    batch.reserve(STRAND_BATCH);
+    std::unique_lock<std::mutex> lk(_m);
+    while (true) {
+        _cv.wait(lk, [this]() { return _stopping || !_ready.empty(); });
+        if (_stopping) return;
+        const Key key = _ready.front();
+        _ready.pop_front();
+        // Node-based map: the reference survives other strands coming and going
+        Strand &strand = _strands[key];
+        while (!strand.messages.empty() && batch.size() < STRAND_BATCH) {
+            batch.push_back(std::move(strand.messages.front()));
+            strand.messages.pop_front();
+        }
+
+        // The strand stays scheduled while it runs, so no other worker takes it
+        lk.unlock();
+        for (auto &m : batch) _run(key, m);
+        lk.lock();
+
+        const size_t done = batch.size();
+        batch.clear();
+        if (_stopping) return;
+        if (strand.messages.empty()) {
+            _strands.erase(key);
+        } else {
+            _ready.push_back(key);
+            _cv.notify_one();
+        }
+        const size_t left = (_pending -= done);
+        if (_was_full && left <= _capacity / 2) {
+            _was_full = false;
+            lk.unlock();
+            _on_space();
+            lk.lock();
+        }
+    }
+}
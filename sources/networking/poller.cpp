@@ -0,0 +1,182 @@
+#include "networking/poller.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Ready descriptors collected per epoll_wait(); any more are reported by the next call
+constexpr size_t EPOLL_BATCH = 256;
+
+std::runtime_error poller_error(const char* what) {
+    return std::runtime_error(std::string("Poller: ") + what + ": " + std::strerror(errno));
+}
+
+uint32_t to_epoll(uint32_t events) {
+    uint32_t out = EPOLLET | EPOLLRDHUP;
+    if (events & Poller::Readable) out |= EPOLLIN;
+    if (events & Poller::Writable) out |= EPOLLOUT;
+    return out;
+}
+
+short to_poll(uint32_t events) {
+    short out = 0;
+    if (events & Poller::Readable) out |= POLLIN;
+    if (events & Poller::Writable) out |= POLLOUT;
+    return out;
+}
+
+// poll() skips negative fds, but still reports POLLHUP/POLLERR for an empty
+// interest set: a descriptor watched for nothing is parked as ~fd
+int poll_slot_fd(int fd, uint32_t events) {
+    return events ? fd : ~fd;
+}
+
+int poll_real_fd(const pollfd& pf) {
+    return pf.fd < 0 ? ~pf.fd : pf.fd;
+}
+
+}
+
+Poller::Backend Poller::defaultBackend() noexcept {
+    return Backend::Epoll;
+}
+
+Poller::Poller(Backend backend) : _backend(backend) {
+    _wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wake_fd < 0) throw poller_error("eventfd()");
+    if (_backend == Backend::Epoll) {
+        _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd < 0) {
+            ::close(_wake_fd);
+            throw poller_error("epoll_create1()");
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = _wake_fd;
+        if (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &ev) < 0) {
+            ::close(_epoll_fd);
+            ::close(_wake_fd);
+            throw poller_error("epoll_ctl(wakeup)");
+        }
+        _epoll_events.resize(EPOLL_BATCH);
+    } else {
+        _pollfds.push_back(pollfd{_wake_fd, POLLIN, 0});
+    }
+}
+
+Poller::~Poller() {
+    if (_epoll_fd >= 0) ::close(_epoll_fd);
+    if (_wake_fd >= 0) ::close(_wake_fd);
+}
+
+void Poller::add(int fd, uint32_t events) {
+    if (_backend == Backend::Epoll) {
+        epoll_event ev{};
+        ev.events = to_epoll(events);
+        ev.data.fd = fd;
+        if (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) throw poller_error("epoll_ctl(ADD)");
+    } else {
+        if (_poll_index.count(fd)) {
+            errno = EEXIST;
+            throw poller_error("add()");
+        }
+        _poll_index[fd] = _pollfds.size();
+        _pollfds.push_back(pollfd{poll_slot_fd(fd, events), to_poll(events), 0});
+    }
+    ++_watched;
+}
+
+void Poller::modify(int fd, uint32_t events) {
+    if (_backend == Backend::Epoll) {
+        epoll_event ev{};
+        ev.events = to_epoll(events);
+        ev.data.fd = fd;
+        if (::epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &ev) < 0) throw poller_error("epoll_ctl(MOD)");
+        return;
+    }
+    auto it = _poll_index.find(fd);
+    if (it == _poll_index.end()) {
+        errno = ENOENT;
+        throw poller_error("modify()");
+    }
+    _pollfds[it->second].fd = poll_slot_fd(fd, events);
+    _pollfds[it->second].events = to_poll(events);
+}
+
+void Poller::remove(int fd) noexcept {
+    if (_backend == Backend::Epoll) {
+        if (::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == 0) --_watched;
+        return;
+    }
+    auto it = _poll_index.find(fd);
+    if (it == _poll_index.end()) return;
+    // swap-remove keeps the array dense
+    const size_t pos = it->second;
+    _poll_index.erase(it);
+    if (pos != _pollfds.size() - 1) {
+        _pollfds[pos] = _pollfds.back();
+        _poll_index[poll_real_fd(_pollfds[pos])] = pos;
+    }
+    _pollfds.pop_back();
+    --_watched;
+}
+
+size_t Poller::wait(std::vector<Event>& ready, int timeoutMs) {
+    ready.clear();
+    if (_backend == Backend::Epoll) {
+        int n = ::epoll_wait(_epoll_fd, _epoll_events.data(), static_cast<int>(_epoll_events.size()), timeoutMs);
+        if (n < 0) return 0; // EINTR: the caller loops
+        for (int i = 0; i < n; ++i) {
+            const epoll_event& ev = _epoll_events[static_cast<size_t>(i)];
+            if (ev.data.fd == _wake_fd) {
+                drainWakeup();
+                continue;
+            }
+            uint32_t events = 0;
+            if (ev.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) events |= Readable;
+            if (ev.events & EPOLLOUT) events |= Writable;
+            ready.push_back(Event{ev.data.fd, events});
+        }
+        return ready.size();
+    }
+
+    int n = ::poll(_pollfds.data(), static_cast<nfds_t>(_pollfds.size()), timeoutMs);
+    if (n <= 0) return 0;
+    for (const pollfd& pf : _pollfds) {
+        if (!pf.revents) continue;
+        if (pf.fd == _wake_fd) {
+            drainWakeup();
+            continue;
+        }
+        uint32_t events = 0;
+        if (pf.revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) events |= Readable;
+        if (pf.revents & POLLOUT) events |= Writable;
+        ready.push_back(Event{pf.fd, events});
+    }
+    return ready.size();
+}
+
+void Poller::wake() noexcept {
+    const uint64_t one = 1;
+    ssize_t r = ::write(_wake_fd, &one, sizeof(one));
+    (void)r; // EAGAIN: the counter is already non-zero, the wakeup is pending
+}
+
+void Poller::drainWakeup() noexcept {
+    uint64_t count;
+    ssize_t r = ::read(_wake_fd, &count, sizeof(count));
+    (void)r;
+}
+
+Poller::Backend Poller::backend() const noexcept {
+    return _backend;
+}
+
+size_t Poller::size() const noexcept {
+    return _watched;
+}
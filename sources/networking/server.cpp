@@ -1,11 +1,32 @@
 #include "networking/server.hpp"
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
 #include <cstring>
-#include <poll.h>
+#include <cerrno>
 #include <fcntl.h>
+#include <netinet/tcp.h>
 #include "networking/debug.hpp"
+#include "networking/socket_io.hpp"
+#include "networking/compression.hpp"
+
+namespace {
+
+// An emptied outbound queue keeps up to this much storage for the next burst
+constexpr size_t OUTBOUND_KEEP_CAPACITY = 64 * 1024;
+
+// How long stop() lets each loop write out what is still queued
+constexpr std::chrono::milliseconds STOP_FLUSH_TIMEOUT(500);
+
+// Largest single read into a receive ring, and what an emptied ring keeps
+constexpr size_t RECV_CHUNK = 16 * 1024;
+constexpr size_t RECV_KEEP_CAPACITY = 64 * 1024;
+
+}
 
 static int set_nonblocking(int fd) {
     int flags = fcntl(fd, F_GETFL, 0);
@@ -17,315 +38,667 @@ Server::Server() = default;
 
 Server::~Server() {
     stop();
-    std::lock_guard<std::mutex> lg(_m);
-    for (auto &p : _clients) {
-        ::shutdown(p.second, SHUT_RDWR);
-        ::close(p.second);
-    }
-    _clients.clear();
-    if (_listen_sock >= 0) {
-        ::shutdown(_listen_sock, SHUT_RDWR);
-        ::close(_listen_sock);
-        _listen_sock = -1;
-    }
 }
 
 void Server::stop() {
     _running = false;
-    if (_worker.joinable()) _worker.join();
+    for (auto &loop : _loops) {
+        if (loop->poller) loop->poller->wake();
+    }
+    for (auto &loop : _loops) {
+        if (loop->thread.joinable()) loop->thread.join();
+    }
+    {
+        // Release senders waiting under the Block policy (handler threads too)
+        std::shared_lock<std::shared_mutex> lg(_m);
+        for (auto &p : _clients) {
+            std::lock_guard<std::mutex> out(p.second.out->lock);
+            p.second.out->closed = true;
+            p.second.out->drained.notify_all();
+        }
+    }
+    // Running handlers finish; queued ones are dropped
+    _handler_pool.reset();
     {
-        std::lock_guard<std::mutex> lg(_m);
+        std::lock_guard<std::shared_mutex> lg(_m);
         for (auto &p : _clients) {
-            ::shutdown(p.second, SHUT_RDWR);
-            ::close(p.second);
+            ::shutdown(p.second.sock, SHUT_RDWR);
+            ::close(p.second.sock);
         }
         _clients.clear();
         _fd_to_id.clear();
-        _recv_buffers.clear();
     }
-    if (_listen_sock >= 0) {
-        ::shutdown(_listen_sock, SHUT_RDWR);
-        ::close(_listen_sock);
-        _listen_sock = -1;
+    for (auto &loop : _loops) {
+        // accepted but never registered
+        for (int fd : loop->handoff) ::close(fd);
+        if (loop->listenSock >= 0) {
+            ::shutdown(loop->listenSock, SHUT_RDWR);
+            ::close(loop->listenSock);
+        }
     }
+    _loops.clear();
 }
 
-void Server::start(const size_t& p_port) {
-    NET_LOG("SERVER: start this=" << this << " port=" << p_port);
-    _listen_sock = ::socket(AF_INET, SOCK_STREAM, 0);
-    if (_listen_sock < 0) throw std::runtime_error("socket()");
+int Server::openListener(size_t port, bool reusePort) {
+    int sock = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) throw std::runtime_error("socket()");
 
     int opt = 1;
-    setsockopt(_listen_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    if (reusePort && setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        ::close(sock);
+        throw std::runtime_error("setsockopt(SO_REUSEPORT)");
+    }
 
     sockaddr_in serv{};
     serv.sin_family = AF_INET;
     serv.sin_addr.s_addr = INADDR_ANY;
-    serv.sin_port = htons(static_cast<uint16_t>(p_port));
+    serv.sin_port = htons(static_cast<uint16_t>(port));
 
-    if (::bind(_listen_sock, reinterpret_cast<sockaddr*>(&serv), sizeof(serv)) < 0) {
-        ::close(_listen_sock);
-        _listen_sock = -1;
+    if (::bind(sock, reinterpret_cast<sockaddr*>(&serv), sizeof(serv)) < 0) {
+        ::close(sock);
         throw std::runtime_error("bind()");
     }
 
-    // store the bound port (useful if p_port == 0)
-    {
-        sockaddr_in addr{};
-        socklen_t len = sizeof(addr);
-        if (::getsockname(_listen_sock, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
-            _bound_port = ntohs(addr.sin_port);
-        }
-    }
-
-    if (::listen(_listen_sock, 16) < 0) {
-        ::close(_listen_sock);
-        _listen_sock = -1;
+    if (::listen(sock, SOMAXCONN) < 0) {
+        ::close(sock);
         throw std::runtime_error("listen()");
     }
 
-    if (set_nonblocking(_listen_sock) < 0) {
-        ::close(_listen_sock);
-        _listen_sock = -1;
+    if (set_nonblocking(sock) < 0) {
+        ::close(sock);
         throw std::runtime_error("set_nonblocking()");
     }
+    return sock;
+}
+
+void Server::start(const size_t& p_port) {
+    NET_LOG("SERVER: start this=" << this << " port=" << p_port << " loops=" << _loop_count);
+    for (size_t i = 0; i < _loop_count; ++i) {
+        _loops.push_back(std::make_unique<EventLoop>());
+        _loops.back()->index = i;
+    }
+    try {
+        bool reusePort = _loop_count > 1 && _distribution == AcceptDistribution::ReusePort;
+        if (reusePort) {
+            try {
+                _loops[0]->listenSock = openListener(p_port, true);
+            } catch (const std::runtime_error &) {
+                // no SO_REUSEPORT: a single listener hands connections out
+                reusePort = false;
+                _distribution = AcceptDistribution::RoundRobin;
+            }
+        }
+        if (_loops[0]->listenSock < 0) {
+            _loops[0]->listenSock = openListener(p_port, false);
+        }
+
+        // store the bound port (useful if p_port == 0)
+        {
+            sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            if (::getsockname(_loops[0]->listenSock, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+                _bound_port = ntohs(addr.sin_port);
+            }
+        }
+
+        for (auto &loop : _loops) {
+            if (reusePort && loop->listenSock < 0) {
+                loop->listenSock = openListener(_bound_port, true);
+            }
+            loop->poller = std::make_unique<Poller>(_event_backend);
+            if (loop->listenSock >= 0) loop->poller->add(loop->listenSock, Poller::Readable);
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+
+    if (_handler_threads > 0) {
+        _handler_pool = std::make_unique<HandlerPool>(
+            _handler_threads, _handler_queue,
+            [this](HandlerPool::Key id, Message &m) { invokeHandler(id, m); },
+            [this]() {
+                for (auto &loop : _loops) loop->poller->wake();
+            });
+    }
 
     _running = true;
-    _worker = std::thread([this]() {
-        while (_running) {
-            // Accept new clients
-            while (true) {
-                int client = ::accept(_listen_sock, nullptr, nullptr);
-                if (client < 0) break;
-                    NET_LOG("SERVER: accepted client fd=" << client);
-                if (set_nonblocking(client) < 0) {
-                    ::close(client);
-                    continue;
-                }
-                ClientID id;
-                {
-                    std::lock_guard<std::mutex> lg(_m);
-                    id = _next_client_id++;
-                    _clients[id] = client;
-                    _fd_to_id[client] = id;
-                    _recv_buffers[id] = {};
-                }
+    for (auto &loop : _loops) {
+        EventLoop *owned = loop.get();
+        owned->thread = std::thread([this, owned]() { run(*owned); });
+    }
+}
+
+void Server::run(EventLoop& loop) {
+    loop.owner = std::this_thread::get_id();
+    std::vector<Poller::Event> ready;
+    // Reused across reads so steady-state parsing does not allocate;
+    // payloads are borrowed from the receive ring or stay inline.
+    std::vector<Message> extracted_msgs;
+    while (_running) {
+        // Only ready sockets come back; stop(), hand-offs and a draining
+        // handler queue wake the wait
+        loop.poller->wait(ready, -1);
+        takeHandoff(loop);
+        takeFlushes(loop);
+        for (const Poller::Event &ev : ready) {
+            if (ev.fd == loop.listenSock) {
+                acceptClients(loop);
+                continue;
             }
+            if (ev.events & Poller::Writable) flushClient(loop, ev.fd);
+            if (ev.events & Poller::Readable) serviceClient(loop, ev.fd, extracted_msgs);
+        }
+        // After the reads: the queue may already have drained below capacity
+        // without crossing the onSpace threshold
+        resumePaused(loop, extracted_msgs);
+        // Replies of the handlers above: one write per client
+        flushLocal(loop);
+    }
+    drainOutbound(loop);
+}
 
-            // Build pollfds
-            std::vector<pollfd> fds;
-            {
-                std::lock_guard<std::mutex> lg(_m);
-                fds.reserve(_clients.size() + 1);
-                pollfd lf{};
-                lf.fd = _listen_sock;
-                lf.events = POLLIN;
-                fds.push_back(lf);
-                for (auto &p : _clients) {
-                    pollfd pf{};
-                    pf.fd = p.second;
-                    pf.events = POLLIN;
-                    fds.push_back(pf);
+void Server::drainOutbound(EventLoop& loop) {
+    // No more reads: only writable events can wake the waits below
+    for (auto &entry : loop.connections) {
+        entry.second.paused = true;
+        updateInterest(loop, entry.first, entry.second);
+    }
+    std::vector<Poller::Event> ready;
+    const auto deadline = std::chrono::steady_clock::now() + STOP_FLUSH_TIMEOUT;
+    while (true) {
+        // Sends that raced with stop() are written too
+        takeFlushes(loop);
+        flushLocal(loop);
+        bool pending = false;
+        for (auto &entry : loop.connections) {
+            std::lock_guard<std::mutex> lg(entry.second.out->lock);
+            if (!entry.second.out->queue.empty()) {
+                pending = true;
+                break;
+            }
+        }
+        if (!pending) return;
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            NET_LOG("SERVER: loop " << loop.index << " stopped with output still queued");
+            return;
+        }
+        loop.poller->wait(ready, static_cast<int>(left.count()) + 1);
+        for (const Poller::Event &ev : ready) {
+            if (ev.events & Poller::Writable) flushClient(loop, ev.fd);
+        }
+    }
+}
+
+void Server::acceptClients(EventLoop& loop) {
+    while (true) {
+        int client = ::accept4(loop.listenSock, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break; // EAGAIN: backlog drained (or fd limit hit, retried on the next connection)
+        }
+        NET_LOG("SERVER: loop " << loop.index << " accepted client fd=" << client);
+        if (_distribution == AcceptDistribution::RoundRobin && _loops.size() > 1) {
+            EventLoop &target = *_loops[_next_loop++ % _loops.size()];
+            if (&target != &loop) {
+                {
+                    std::lock_guard<std::mutex> lg(target.handoffLock);
+                    target.handoff.push_back(client);
                 }
+                target.poller->wake();
+                continue;
             }
+        }
+        registerClient(loop, client);
+    }
+}
+
+void Server::takeHandoff(EventLoop& loop) {
+    std::vector<int> fds;
+    {
+        std::lock_guard<std::mutex> lg(loop.handoffLock);
+        if (loop.handoff.empty()) return;
+        fds.swap(loop.handoff);
+    }
+    for (int fd : fds) registerClient(loop, fd);
+}
+
+void Server::registerClient(EventLoop& loop, int client) {
+    if (_default_no_delay && !set_tcp_option(client, TCP_NODELAY, true)) {
+        NET_LOG("SERVER: TCP_NODELAY refused on fd=" << client);
+    }
+    try {
+        loop.poller->add(client, Poller::Readable);
+    } catch (const std::exception &e) {
+        NET_LOG("SERVER: cannot watch fd=" << client << ": " << e.what());
+        ::close(client);
+        return;
+    }
+    auto out = std::make_shared<Outbound>();
+    std::lock_guard<std::shared_mutex> lg(_m);
+    ClientID id = _next_client_id++;
+    _clients[id] = ClientEntry{client, loop.index, out};
+    _fd_to_id[client] = id;
+    loop.connections[client] = Connection{id, {}, std::move(out)};
+}
+
+Server::ClientID Server::readClient(EventLoop& loop, int fd, std::vector<Message>& extracted_msgs, bool& closed, bool& full) {
+    auto it = loop.connections.find(fd);
+    if (it == loop.connections.end() || it->second.paused) return -1;
+    Connection &conn = it->second;
+    const ClientID id = conn.id;
+    RingBuffer &buf = conn.recv;
 
-            int ret = ::poll(fds.data(), static_cast<nfds_t>(fds.size()), 200);
-            if (ret < 0) continue;
-            if (ret == 0) continue;
-
-            // Iterate fds
-            for (size_t i = 0; i < fds.size(); ++i) {
-                if (!(fds[i].revents & POLLIN)) continue;
-                int fd = fds[i].fd;
-                if (fd == _listen_sock) continue; // accept handled above
-
-                // read available data into buffer
-                uint8_t tmp[4096];
-                ssize_t r = ::recv(fd, tmp, sizeof(tmp), 0);
-                if (r > 0) {
-                    NET_LOG("SERVER: recv fd=" << fd << " bytes=" << r);
+    // Edge-triggered: keep reading until the socket is empty
+    while (!closed) {
+        // Frames already buffered go first (left over by a full handler queue)
+        size_t missing = 0;
+        if (!extractFrames(id, buf, extracted_msgs, closed, missing)) {
+            // leave the rest in the socket; TCP flow control reaches the sender
+            full = true;
+            break;
+        }
+        if (closed) break;
+        // recv lands in the ring itself; a read spanning the wrap point is one
+        // readv. A partial frame is read whole, whatever its size.
+        const size_t limit = missing > RECV_CHUNK ? missing : RECV_CHUNK;
+        iovec iov[2];
+        size_t count = buf.writable(iov, limit);
+        if (iov[0].iov_len >= limit) {
+            iov[0].iov_len = limit;
+            count = 1;
+        } else if (count == 2 && iov[0].iov_len + iov[1].iov_len > limit) {
+            iov[1].iov_len = limit - iov[0].iov_len;
+        }
+        ssize_t r = ::readv(fd, iov, static_cast<int>(count));
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) closed = true;
+            break;
+        }
+        if (r == 0) {
+            // disconnected
+            closed = true;
+            break;
+        }
+        NET_LOG("SERVER: recv fd=" << fd << " bytes=" << r);
+        buf.commit(static_cast<size_t>(r));
+        NET_LOG("SERVER: client id=" << id << " buffer_size=" << buf.size());
+    }
+    if (buf.empty() && buf.capacity() > RECV_KEEP_CAPACITY) buf.shrink();
+    return id;
+}
+
+bool Server::extractFrames(ClientID id, RingBuffer& buf, std::vector<Message>& extracted_msgs, bool& closed, size_t& missing) {
+    // Inline handlers are done with a frame before its bytes are consumed,
+    // so they can read it in place; queued ones get their own copy
+    const bool borrow = !_handler_pool;
+    const size_t room = _handler_pool ? _handler_queue - std::min(_handler_queue, _handler_pool->pending())
+                                      : SIZE_MAX;
+    std::vector<uint8_t> linear; // compressed frame split by the wrap point
+    size_t parsed = 0;
+    size_t waiting = 0; // size of the partial frame at the end, if any
+    bool more = true;
+    while (buf.size() - parsed >= 4) {
+        if (extracted_msgs.size() >= room) {
+            // the handler queue is full: the rest stays in the ring
+            more = false;
+            break;
+        }
+        uint32_t netlen;
+        buf.peek(&netlen, 4, parsed);
+        uint32_t msglen = ntohl(netlen);
+        const bool compressed = (msglen & FRAME_COMPRESSED_FLAG) != 0;
+        msglen &= ~FRAME_COMPRESSED_FLAG;
+        NET_LOG("SERVER: parsed msglen=" << msglen << " (buf_size=" << buf.size() - parsed << ")");
+        if (msglen > MAX_FRAME_SIZE) { // 10MB cap
+            // bad frame, drop connection
+            closed = true;
+            break;
+        }
+        if (buf.size() - parsed < 4 + msglen) {
+            waiting = 4 + msglen;
+            missing = waiting - (buf.size() - parsed); // wait for full frame
+            break;
+        }
+        if (msglen >= 4) {
+            int32_t net_t;
+            buf.peek(&net_t, 4, parsed + 4);
+            int32_t t = ntohl(net_t);
+            const size_t body = msglen - 4;
+            const uint8_t* slice = buf.contiguous(parsed + FRAME_HEADER_SIZE, body);
+            NET_LOG("SERVER: message type=" << t << " payload_len=" << body);
+            if (!compressed && borrow && slice) {
+                extracted_msgs.emplace_back(static_cast<int>(t), DataBuffer::borrow(slice, body));
+            } else if (!compressed) {
+                extracted_msgs.emplace_back(static_cast<int>(t));
+                if (body > 0) buf.peek(extracted_msgs.back().payload().extend(body).data(), body, parsed + FRAME_HEADER_SIZE);
+            } else {
+                if (!slice) {
+                    linear.resize(body);
+                    buf.peek(linear.data(), body, parsed + FRAME_HEADER_SIZE);
+                    slice = linear.data();
                 }
-                if (r <= 0) {
-                    // disconnected or error
-                    ClientID id = -1;
-                    {
-                        std::lock_guard<std::mutex> lg(_m);
-                        auto it = _fd_to_id.find(fd);
-                        if (it != _fd_to_id.end()) id = it->second;
-                    }
-                    if (id != -1) {
-                        std::lock_guard<std::mutex> lg(_m);
-                        ::shutdown(fd, SHUT_RDWR);
-                        ::close(fd);
-                        _fd_to_id.erase(fd);
-                        _clients.erase(id);
-                        _recv_buffers.erase(id);
-                    }
-                    continue;
+                extracted_msgs.emplace_back(static_cast<int>(t));
+                try {
+                    decompress_frame_payload(slice, body, MAX_FRAME_SIZE, extracted_msgs.back().payload());
+                } catch (const std::exception &e) {
+                    // corrupt or hostile stream, drop connection (as Client does)
+                    NET_LOG("SERVER: bad compressed frame: " << e.what());
+                    extracted_msgs.pop_back();
+                    closed = true;
+                    break;
                 }
+            }
+        }
+        parsed += 4 + msglen;
+    }
+    dispatch(id, extracted_msgs);
+    extracted_msgs.clear();
+    buf.consume(parsed);
+    // No borrowed payload is left: the ring may move. The partial frame now
+    // starts at the head; keeping all of it before the wrap point lets it
+    // arrive contiguous, ready to be borrowed.
+    if (waiting > 0) buf.makeContiguous(waiting);
+    return more;
+}
 
-                // append to client's buffer and extract any complete frames
-                ClientID id = -1;
-                std::vector<std::vector<uint8_t>> extracted_msgs;
-                {
-                    std::lock_guard<std::mutex> lg(_m);
-                    auto it = _fd_to_id.find(fd);
-                    if (it != _fd_to_id.end()) id = it->second;
-                    if (id != -1) {
-                        auto &buf = _recv_buffers[id];
-                        buf.insert(buf.end(), tmp, tmp + r);
-                        NET_LOG("SERVER: client id=" << id << " buffer_size=" << buf.size());
-                        // extract complete frames while holding the lock, push them to extracted_msgs
-                        while (true) {
-                            if (buf.size() < 4) break;
-                            uint32_t netlen;
-                            std::memcpy(&netlen, buf.data(), 4);
-                            uint32_t msglen = ntohl(netlen);
-                            NET_LOG("SERVER: parsed msglen=" << msglen << " (buf_size=" << buf.size() << ")");
-                            if (msglen > 10 * 1024 * 1024) { // 10MB cap
-                                // bad frame, drop connection
-                                ::shutdown(fd, SHUT_RDWR);
-                                ::close(fd);
-                                _fd_to_id.erase(fd);
-                                _clients.erase(id);
-                                _recv_buffers.erase(id);
-                                id = -1;
-                                break;
-                            }
-                            if (buf.size() < 4 + msglen) break; // wait for full frame
-                            // extract message bytes (type+payload)
-                            std::vector<uint8_t> msgbuf(buf.begin() + 4, buf.begin() + 4 + msglen);
-                            // consume from buffer
-                            buf.erase(buf.begin(), buf.begin() + 4 + msglen);
-                            extracted_msgs.push_back(std::move(msgbuf));
-                        }
-                    }
-                }
+void Server::dispatch(ClientID id, std::vector<Message>& messages) {
+    if (_handler_pool) {
+        for (auto &m : messages) _handler_pool->submit(id, std::move(m));
+        return;
+    }
+    for (auto &m : messages) invokeHandler(id, m);
+}
 
-                // process extracted messages outside the lock
-                if (id != -1) {
-                    for (auto &msgbuf : extracted_msgs) {
-                        if (msgbuf.size() < 4) continue;
-                        int32_t net_t;
-                        std::memcpy(&net_t, msgbuf.data(), 4);
-                        int32_t t = ntohl(net_t);
-                                NET_LOG("SERVER: message type=" << t << " payload_len=" << (msgbuf.size()-4));
-                        Message m(static_cast<int>(t));
-                        if (msgbuf.size() > 4) {
-                            m.payload().clear();
-                            m.payload().reserve(msgbuf.size() - 4);
-                            for (size_t i = 4; i < msgbuf.size(); ++i) m.payload() << msgbuf[i];
-                        }
-
-                        // find handler (lock briefly)
-                        MessageHandler h = nullptr;
+void Server::invokeHandler(ClientID id, const Message& m) {
+    {
+        // find handler (lock briefly)
+        MessageHandler h = nullptr;
 #ifdef LIBFTPP_NETWORK_DEBUG
-                        size_t handlers_count = 0;
-                        bool found = false;
+        size_t handlers_count = 0;
+        bool found = false;
 #endif
-                        {
-                            std::lock_guard<std::mutex> lg(_m);
+        {
+            std::shared_lock<std::shared_mutex> lg(_m);
 #ifdef LIBFTPP_NETWORK_DEBUG
-                            handlers_count = _handlers.size();
+            handlers_count = _handlers.size();
 #endif
-                            auto it = _handlers.find(m.type());
+            auto it = _handlers.find(m.type());
 #ifdef LIBFTPP_NETWORK_DEBUG
-                            if (it != _handlers.end()) { h = it->second; found = true; }
+            if (it != _handlers.end()) { h = it->second; found = true; }
 #else
-                            if (it != _handlers.end()) h = it->second;
+            if (it != _handlers.end()) h = it->second;
 #endif
-                        }
+        }
 #ifdef LIBFTPP_NETWORK_DEBUG
-                        NET_LOG("SERVER: handlers_count=" << handlers_count << " found=" << found);
+        NET_LOG("SERVER: handlers_count=" << handlers_count << " found=" << found);
 #endif
-                        if (h) {
-                            try {
-                                NET_LOG("SERVER: invoking handler for id=" << id);
-                                h(id, m);
-                                NET_LOG("SERVER: handler returned for id=" << id);
-                            } catch (const std::exception &e) {
-                                NET_LOG("SERVER: handler threw: " << e.what());
-                            } catch (...) {
-                                NET_LOG("SERVER: handler threw unknown exception");
-                            }
-                        }
-                    }
-                }
+        if (h) {
+            try {
+                NET_LOG("SERVER: invoking handler for id=" << id);
+                h(id, m);
+                NET_LOG("SERVER: handler returned for id=" << id);
+            } catch (const std::exception &e) {
+                NET_LOG("SERVER: handler threw: " << e.what());
+            } catch (...) {
+                NET_LOG("SERVER: handler threw unknown exception");
             }
         }
-    });
+    }
 }
 
-void Server::defineAction(const Message::Type& messageType, const MessageHandler& action) {
-    std::lock_guard<std::mutex> lg(_m);
-    _handlers[messageType] = action;
-    NET_LOG("SERVER: defineAction type=" << messageType << " this=" << this << " handlers_count=" << _handlers.size());
+void Server::serviceClient(EventLoop& loop, int fd, std::vector<Message>& extracted_msgs) {
+    bool closed = false;
+    bool full = false;
+    if (readClient(loop, fd, extracted_msgs, closed, full) == -1) return;
+    if (closed) {
+        closeClient(loop, fd);
+    } else if (full) {
+        pauseClient(loop, fd);
+    }
 }
 
-size_t Server::getPort() const {
-    return _bound_port;
+void Server::pauseClient(EventLoop& loop, int fd) {
+    auto conn = loop.connections.find(fd);
+    if (conn == loop.connections.end()) return;
+    conn->second.paused = true;
+    loop.paused.push_back(fd);
+    updateInterest(loop, fd, conn->second);
 }
 
-void Server::sendTo(const Message& message, ClientID clientID) {
+void Server::resumePaused(EventLoop& loop, std::vector<Message>& extracted_msgs) {
+    if (loop.paused.empty() || _handler_pool->full()) return;
+    std::vector<int> fds;
+    fds.swap(loop.paused); // serviceClient() may pause them again
+    for (int fd : fds) {
+        auto conn = loop.connections.find(fd);
+        if (conn == loop.connections.end()) continue;
+        conn->second.paused = false;
+        // Re-arming reports data that arrived while paused, even edge-triggered
+        updateInterest(loop, fd, conn->second);
+        // but not the frames already buffered: no socket event would come for them
+        if (!conn->second.recv.empty()) serviceClient(loop, fd, extracted_msgs);
+    }
+    // Paused again while the workers kept draining: the pool may never
+    // report crossing back under half capacity, so retry next iteration
+    if (!loop.paused.empty() && !_handler_pool->full()) loop.poller->wake();
+}
+
+void Server::updateInterest(EventLoop& loop, int fd, const Connection& conn) {
+    const uint32_t events = (conn.paused ? 0u : static_cast<uint32_t>(Poller::Readable))
+                          | (conn.writing ? static_cast<uint32_t>(Poller::Writable) : 0u);
+    try {
+        loop.poller->modify(fd, events);
+    } catch (const std::exception &e) {
+        NET_LOG("SERVER: cannot watch fd=" << fd << " for " << events << ": " << e.what());
+    }
+}
+
+void Server::takeFlushes(EventLoop& loop) {
+    std::vector<int> fds;
+    {
+        std::lock_guard<std::mutex> lg(loop.flushLock);
+        if (loop.flush.empty()) return;
+        fds.swap(loop.flush);
+    }
+    for (int fd : fds) flushClient(loop, fd);
+}
+
+void Server::flushLocal(EventLoop& loop) {
+    if (loop.localFlush.empty()) return;
+    std::vector<int> fds;
+    fds.swap(loop.localFlush);
+    for (int fd : fds) flushClient(loop, fd);
+}
+
+void Server::flushClient(EventLoop& loop, int fd) {
+    auto it = loop.connections.find(fd);
+    if (it == loop.connections.end()) return;
+    Connection &conn = it->second;
+    Outbound &out = *conn.out;
+    bool failed = false;
+    bool pending = false;
+    {
+        std::lock_guard<std::mutex> lg(out.lock);
+        iovec iov[2];
+        size_t count;
+        while ((count = out.queue.readable(iov)) > 0) {
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = count;
+            ssize_t w = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+            if (w < 0 && errno == EINTR) continue;
+            if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (w <= 0) {
+                failed = true;
+                out.queue.clear();
+                break;
+            }
+            out.queue.consume(static_cast<size_t>(w));
+        }
+        if (out.queue.size() <= _low_watermark) {
+            out.congested = false;
+            out.drained.notify_all();
+        }
+        pending = !out.queue.empty();
+        if (!pending) {
+            // Senders queue onto the flush list again from now on
+            out.scheduled = false;
+            if (out.queue.capacity() > OUTBOUND_KEEP_CAPACITY) out.queue.shrink();
+        }
+    }
+    if (failed) {
+        ::shutdown(fd, SHUT_RDWR);
+        return;
+    }
+    if (pending != conn.writing) {
+        conn.writing = pending;
+        updateInterest(loop, fd, conn);
+    }
+}
+
+void Server::enqueue(ClientID clientID, const iovec* iov, size_t count) {
     int sock = -1;
+    std::shared_ptr<Outbound> out;
+    EventLoop *loop = nullptr;
+    bool onOwnerLoop = false;
     {
-        std::lock_guard<std::mutex> lg(_m);
+        std::shared_lock<std::shared_mutex> lg(_m);
         auto it = _clients.find(clientID);
         if (it == _clients.end()) return;
-        sock = it->second;
-    }
-    std::vector<uint8_t> buf;
-    int32_t t = static_cast<int32_t>(message.type());
-    int32_t net_t = htonl(t);
-    const uint8_t *tp = reinterpret_cast<const uint8_t*>(&net_t);
-    buf.insert(buf.end(), tp, tp + sizeof(net_t));
-    const auto &p = message.payload();
-    const uint8_t *pdata = p.data();
-    size_t psz = p.size();
-    if (pdata && psz > 0) buf.insert(buf.end(), pdata, pdata + psz);
-    uint32_t len = static_cast<uint32_t>(buf.size());
-    uint32_t netlen = htonl(len);
-    // send length
-    const uint8_t *len_ptr = reinterpret_cast<const uint8_t*>(&netlen);
-    size_t to_write = sizeof(netlen);
-    while (to_write > 0) {
-        ssize_t w = ::send(sock, len_ptr + (sizeof(netlen) - to_write), to_write, 0);
-        if (w <= 0) {
-            // remove client
-            std::lock_guard<std::mutex> lg(_m);
-            auto it = _fd_to_id.find(sock);
-            if (it != _fd_to_id.end()) {
-                ClientID id = it->second;
-                ::shutdown(sock, SHUT_RDWR);
-                ::close(sock);
-                _fd_to_id.erase(sock);
-                _clients.erase(id);
-                _recv_buffers.erase(id);
-            }
-            return;
+        sock = it->second.sock;
+        out = it->second.out;
+        loop = _loops[it->second.loop].get();
+        onOwnerLoop = loop->owner.load() == std::this_thread::get_id();
+    }
+
+    std::unique_lock<std::mutex> lk(out->lock);
+    if (out->closed) return;
+    if (out->congested || out->queue.size() >= _high_watermark) {
+        switch (_slow_consumer_policy.load()) {
+            case SlowConsumerPolicy::Drop:
+                out->congested = true;
+                ++_dropped_messages;
+                return;
+            case SlowConsumerPolicy::Disconnect:
+                out->closed = true;
+                out->queue.clear();
+                lk.unlock();
+                NET_LOG("SERVER: slow consumer id=" << clientID << " disconnected");
+                dropClient(clientID, sock);
+                return;
+            case SlowConsumerPolicy::Block:
+                if (onOwnerLoop) break; // only this thread could drain it
+                out->drained.wait(lk, [&]() { return out->closed || out->queue.size() <= _low_watermark; });
+                if (out->closed) return;
+                break;
         }
-        to_write -= static_cast<size_t>(w);
-    }
-    // send payload
-    const uint8_t *data_ptr = buf.data();
-    to_write = len;
-    while (to_write > 0) {
-        ssize_t w = ::send(sock, data_ptr + (len - to_write), to_write, 0);
-        if (w <= 0) {
-            std::lock_guard<std::mutex> lg(_m);
-            auto it = _fd_to_id.find(sock);
-            if (it != _fd_to_id.end()) {
-                ClientID id = it->second;
-                ::shutdown(sock, SHUT_RDWR);
-                ::close(sock);
-                _fd_to_id.erase(sock);
-                _clients.erase(id);
-                _recv_buffers.erase(id);
-            }
-            return;
+    }
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) bytes += iov[i].iov_len;
+    out->queue.reserve(bytes);
+    for (size_t i = 0; i < count; ++i) out->queue.write(iov[i].iov_base, iov[i].iov_len);
+    if (out->scheduled) return; // the loop flushes it already
+    out->scheduled = true;
+    lk.unlock();
+    if (onOwnerLoop) {
+        // Called from a handler on the loop: flushed after the dispatch, no wakeup
+        loop->localFlush.push_back(sock);
+        return;
+    }
+    // stop() forgets every client under _m before destroying the loops: a
+    // client still known under the shared lock means its loop is alive
+    std::shared_lock<std::shared_mutex> known(_m);
+    auto it = _clients.find(clientID);
+    if (it == _clients.end()) return; // closed meanwhile, nothing to flush
+    loop = _loops[it->second.loop].get();
+    {
+        std::lock_guard<std::mutex> lg(loop->flushLock);
+        loop->flush.push_back(sock);
+    }
+    loop->poller->wake();
+}
+
+void Server::closeClient(EventLoop& loop, int fd) {
+    loop.poller->remove(fd);
+    auto conn = loop.connections.find(fd);
+    if (conn != loop.connections.end()) {
+        {
+            std::lock_guard<std::mutex> lg(conn->second.out->lock);
+            conn->second.out->closed = true;
+            conn->second.out->queue.clear();
+            conn->second.out->drained.notify_all();
+        }
+        loop.connections.erase(conn);
+    }
+    {
+        std::lock_guard<std::shared_mutex> lg(_m);
+        auto it = _fd_to_id.find(fd);
+        if (it != _fd_to_id.end()) {
+            _clients.erase(it->second);
+            _fd_to_id.erase(it);
         }
-        to_write -= static_cast<size_t>(w);
     }
+    ::shutdown(fd, SHUT_RDWR);
+    ::close(fd);
+}
+
+void Server::defineAction(const Message::Type& messageType, const MessageHandler& action) {
+    std::lock_guard<std::shared_mutex> lg(_m);
+    _handlers[messageType] = action;
+    NET_LOG("SERVER: defineAction type=" << messageType << " this=" << this << " handlers_count=" << _handlers.size());
+}
+
+size_t Server::getPort() const {
+    return _bound_port;
+}
+
+void Server::sendTo(const Message& message, ClientID clientID) {
+    uint8_t header[FRAME_HEADER_SIZE];
+    std::unique_ptr<uint8_t[]> scratch;
+    iovec iov[2];
+    const size_t count = frame_message(message, _compression_threshold, header, scratch, iov);
+    enqueue(clientID, iov, count);
+}
+
+void Server::setCompressionThreshold(size_t bytes) {
+    _compression_threshold = bytes;
+}
+
+size_t Server::compressionThreshold() const {
+    return _compression_threshold;
+}
+
+void Server::sendTo(const Message::Type& messageType, const SegmentedBuffer& payload, ClientID clientID) {
+    uint8_t header[FRAME_HEADER_SIZE];
+    encode_frame_header(header, static_cast<int32_t>(messageType), payload.size());
+    std::vector<iovec> iov;
+    iov.reserve(payload.segmentCount() + 1);
+    iov.push_back(iovec{header, sizeof(header)});
+    payload.exportIovecs(iov);
+    enqueue(clientID, iov.data(), iov.size());
+}
+
+void Server::dropClient(ClientID clientID, int sock) {
+    std::shared_lock<std::shared_mutex> lg(_m);
+    // The fd may have been closed and reused by a newer client since it was
+    // looked up; closeClient() unmaps it before closing, so a match under
+    // the lock means it is still ours
+    auto it = _fd_to_id.find(sock);
+    if (it != _fd_to_id.end() && it->second == clientID) {
+        // the owning loop reads EOF and calls closeClient()
+        ::shutdown(sock, SHUT_RDWR);
+    }
+}
+
+void Server::sendBatchTo(const std::vector<Message>& messages, ClientID clientID) {
+    if (messages.empty()) return;
+    FrameBatch batch(messages.data(), messages.size(), _compression_threshold);
+    enqueue(clientID, batch.iov(), batch.size());
 }
 
 void Server::sendToArray(const Message& message, std::vector<ClientID> clientIDs) {
@@ -335,12 +708,122 @@ void Server::sendToArray(const Message& message, std::vector<ClientID> clientIDs
 void Server::sendToAll(const Message& message) {
     std::vector<ClientID> copy;
     {
-        std::lock_guard<std::mutex> lg(_m);
+        std::shared_lock<std::shared_mutex> lg(_m);
         for (auto &p : _clients) copy.push_back(p.first);
     }
     for (auto id : copy) sendTo(message, id);
 }
 
+void Server::setEventBackend(Poller::Backend backend) {
+    _event_backend = backend;
+}
+
+Poller::Backend Server::eventBackend() const {
+    return _event_backend;
+}
+
+size_t Server::clientCount() {
+    std::shared_lock<std::shared_mutex> lg(_m);
+    return _clients.size();
+}
+
+void Server::setEventLoops(size_t count, AcceptDistribution distribution) {
+    if (count == 0) throw std::invalid_argument("Server needs at least one event loop");
+    _loop_count = count;
+    _distribution = distribution;
+}
+
+size_t Server::eventLoops() const {
+    return _loop_count;
+}
+
+Server::AcceptDistribution Server::acceptDistribution() const {
+    return _distribution;
+}
+
+void Server::setHandlerThreads(size_t threads, size_t queueCapacity) {
+    if (queueCapacity == 0) throw std::invalid_argument("Handler queue capacity must be greater than 0");
+    _handler_threads = threads;
+    _handler_queue = queueCapacity;
+}
+
+size_t Server::handlerThreads() const {
+    return _handler_threads;
+}
+
+size_t Server::pendingHandlers() const {
+    return _handler_pool ? _handler_pool->pending() : 0;
+}
+
+void Server::setOutboundWatermarks(size_t high, size_t low) {
+    if (high == 0) throw std::invalid_argument("Outbound high watermark must be greater than 0");
+    if (low > high) throw std::invalid_argument("Outbound low watermark must not exceed the high watermark");
+    _high_watermark = high;
+    _low_watermark = low;
+}
+
+size_t Server::outboundHighWatermark() const {
+    return _high_watermark;
+}
+
+size_t Server::outboundLowWatermark() const {
+    return _low_watermark;
+}
+
+void Server::setSlowConsumerPolicy(SlowConsumerPolicy policy) {
+    _slow_consumer_policy = policy;
+}
+
+Server::SlowConsumerPolicy Server::slowConsumerPolicy() const {
+    return _slow_consumer_policy;
+}
+
+size_t Server::queuedBytes(ClientID clientID) {
+    std::shared_ptr<Outbound> out;
+    {
+        std::shared_lock<std::shared_mutex> lg(_m);
+        auto it = _clients.find(clientID);
+        if (it == _clients.end()) return 0;
+        out = it->second.out;
+    }
+    std::lock_guard<std::mutex> lg(out->lock);
+    return out->queue.size();
+}
+
+size_t Server::droppedMessages() const {
+    return _dropped_messages;
+}
+
+void Server::setDefaultNoDelay(bool enabled) {
+    _default_no_delay = enabled;
+}
+
+bool Server::defaultNoDelay() const {
+    return _default_no_delay;
+}
+
+int Server::clientSocket(ClientID clientID) {
+    std::shared_lock<std::shared_mutex> lg(_m);
+    auto it = _clients.find(clientID);
+    return it == _clients.end() ? -1 : it->second.sock;
+}
+
+bool Server::setClientNoDelay(ClientID clientID, bool enabled) {
+    int sock = clientSocket(clientID);
+    return sock >= 0 && set_tcp_option(sock, TCP_NODELAY, enabled);
+}
+
+bool Server::setClientCork(ClientID clientID, bool enabled) {
+    int sock = clientSocket(clientID);
+    return sock >= 0 && set_tcp_option(sock, TCP_CORK, enabled);
+}
+
+int Server::ownerLoop(ClientID clientID) {
+    std::shared_lock<std::shared_mutex> lg(_m);
+    auto it = _clients.find(clientID);
+    return it == _clients.end() ? -1 : static_cast<int>(it->second.loop);
+}
+
 void Server::update() {
-    // With poll-based worker loop, nothing to do here. API kept for compatibility.
+    // The event loops run on their own threads, nothing to do here. API kept for compatibility.
 }
@@ -0,0 +1,123 @@
+#include "networking/socket_io.hpp"
+#include "networking/compression.hpp"
+#include "networking/message.hpp"
+#include <memory>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <climits>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+void encode_frame_header(uint8_t out[FRAME_HEADER_SIZE], int32_t type, size_t payloadSize, bool compressed) {
+    // Past this the length would reach the compression flag bit, or the peer's cap
+    if (payloadSize > MAX_FRAME_SIZE - sizeof(int32_t)) {
+        throw std::length_error("Frame payload exceeds MAX_FRAME_SIZE");
+    }
+    // len covers the type field plus the payload
+    uint32_t len = static_cast<uint32_t>(payloadSize + sizeof(int32_t));
+    if (compressed) len |= FRAME_COMPRESSED_FLAG;
+    uint32_t netlen = htonl(len);
+    int32_t net_t = htonl(type);
+    std::memcpy(out, &netlen, sizeof(netlen));
+    std::memcpy(out + sizeof(netlen), &net_t, sizeof(net_t));
+}
+
+bool send_all_iovecs(int fd, iovec* iov, size_t count) {
+    while (count > 0) {
+        // skip exhausted entries so sendmsg never sees an empty prefix
+        if (iov->iov_len == 0) {
+            ++iov;
+            --count;
+            continue;
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count < static_cast<size_t>(IOV_MAX) ? count : static_cast<size_t>(IOV_MAX);
+
+        ssize_t w = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+
+        size_t written = static_cast<size_t>(w);
+        while (written > 0) {
+            if (written >= iov->iov_len) {
+                written -= iov->iov_len;
+                ++iov;
+                --count;
+            } else {
+                iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + written;
+                iov->iov_len -= written;
+                written = 0;
+            }
+        }
+    }
+    return true;
+}
+
+size_t frame_message(const Message& message, size_t compressionThreshold, uint8_t header[FRAME_HEADER_SIZE],
+                     std::unique_ptr<uint8_t[]>& scratch, iovec out[2]) {
+    const DataBuffer& payload = message.payload();
+    const int32_t type = static_cast<int32_t>(message.type());
+    // Checked before compressing: the peer also caps the decompressed size
+    if (payload.size() > MAX_FRAME_SIZE - sizeof(int32_t)) {
+        throw std::length_error("Frame payload exceeds MAX_FRAME_SIZE");
+    }
+
+    if (compressionThreshold > 0 && payload.size() >= compressionThreshold) {
+        // [uint32_t raw size][block]; scratch is not value-initialized
+        const size_t bound = sizeof(uint32_t) + lz_compress_bound(payload.size());
+        scratch = std::make_unique_for_overwrite<uint8_t[]>(bound);
+        const size_t packed = lz_compress(payload.data(), payload.size(), scratch.get() + sizeof(uint32_t),
+                                          bound - sizeof(uint32_t));
+        if (packed > 0 && packed + sizeof(uint32_t) < payload.size()) {
+            const uint32_t netRaw = htonl(static_cast<uint32_t>(payload.size()));
+            std::memcpy(scratch.get(), &netRaw, sizeof(netRaw));
+            encode_frame_header(header, type, packed + sizeof(uint32_t), true);
+            out[0] = iovec{header, FRAME_HEADER_SIZE};
+            out[1] = iovec{scratch.get(), packed + sizeof(uint32_t)};
+            return 2;
+        }
+    }
+
+    encode_frame_header(header, type, payload.size());
+    out[0] = iovec{header, FRAME_HEADER_SIZE};
+    out[1] = iovec{const_cast<uint8_t*>(payload.data()), payload.size()};
+    return 2;
+}
+
+bool send_message_frame(int fd, const Message& message, size_t compressionThreshold) {
+    uint8_t header[FRAME_HEADER_SIZE];
+    std::unique_ptr<uint8_t[]> scratch;
+    iovec iov[2];
+    const size_t count = frame_message(message, compressionThreshold, header, scratch, iov);
+    return send_all_iovecs(fd, iov, count);
+}
+
+FrameBatch::FrameBatch(const Message* messages, size_t count, size_t compressionThreshold)
+    : _headers(count), _scratch(count), _iov(2 * count) {
+    for (size_t i = 0; i < count; ++i) {
+        frame_message(messages[i], compressionThreshold, _headers[i].data(), _scratch[i], &_iov[2 * i]);
+    }
+}
+
+iovec* FrameBatch::iov() noexcept {
+    return _iov.data();
+}
+
+size_t FrameBatch::size() const noexcept {
+    return _iov.size();
+}
+
+bool send_message_frames(int fd, const Message* messages, size_t count, size_t compressionThreshold) {
+    FrameBatch batch(messages, count, compressionThreshold);
+    return send_all_iovecs(fd, batch.iov(), batch.size());
+}
+
+bool set_tcp_option(int fd, int option, bool enabled) {
+    int value = enabled ? 1 : 0;
+    return ::setsockopt(fd, IPPROTO_TCP, option, &value, sizeof(value)) == 0;
+}
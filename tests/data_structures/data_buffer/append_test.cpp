@@ -0,0 +1,103 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <string>
+
+// Bulk write()/read() round trip, append() packing and geometric growth.
+extern "C" int data_buffer_append_test(void) {
+    try {
+        DataBuffer buf;
+        ASSERT_EQ(buf.capacity(), DataBuffer::INLINE_CAPACITY);
+
+        // append() must produce exactly the bytes of the equivalent << chain
+        int32_t id = 17;
+        float x = 1.5f;
+        double y = -2.25;
+        uint8_t flags = 0xA5;
+        buf.append(id, x, y, flags);
+
+        DataBuffer chained;
+        chained << id << x << y << flags;
+        ASSERT_EQ(buf.size(), chained.size());
+        ASSERT_TRUE(std::memcmp(buf.data(), chained.data(), buf.size()) == 0);
+
+        int32_t rid = 0;
+        float rx = 0;
+        double ry = 0;
+        uint8_t rflags = 0;
+        buf >> rid >> rx >> ry >> rflags;
+        ASSERT_EQ(rid, id);
+        ASSERT_EQ(rx, x);
+        ASSERT_EQ(ry, y);
+        ASSERT_EQ(rflags, flags);
+
+        // ... under any byte order or integer encoding
+        const DataBuffer::ByteOrder orders[] = {DataBuffer::ByteOrder::Big, DataBuffer::ByteOrder::Little};
+        for (DataBuffer::ByteOrder order : orders) {
+            for (DataBuffer::IntegerEncoding encoding : {DataBuffer::IntegerEncoding::Fixed, DataBuffer::IntegerEncoding::Varint}) {
+                DataBuffer packed;
+                DataBuffer expected;
+                packed.setByteOrder(order);
+                expected.setByteOrder(order);
+                packed.setIntegerEncoding(encoding);
+                expected.setIntegerEncoding(encoding);
+                packed.append(id, x, y, flags, int64_t(-300));
+                expected << id << x << y << flags << int64_t(-300);
+                ASSERT_EQ(packed.size(), expected.size());
+                ASSERT_TRUE(std::memcmp(packed.data(), expected.data(), packed.size()) == 0);
+
+                int64_t rbig = 0;
+                packed >> rid >> rx >> ry >> rflags >> rbig;
+                ASSERT_EQ(rid, id);
+                ASSERT_EQ(rx, x);
+                ASSERT_EQ(ry, y);
+                ASSERT_EQ(rflags, flags);
+                ASSERT_EQ(rbig, int64_t(-300));
+            }
+        }
+
+        // raw bulk write/read
+        const char text[] = "bulk payload";
+        DataBuffer raw;
+        raw.write(text, sizeof(text));
+        char out[sizeof(text)] = {};
+        raw.read(out, sizeof(out));
+        ASSERT_EQ(std::string(out), std::string(text));
+
+        bool threw = false;
+        try {
+            raw.read(out, 1);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+
+        // growth is geometric: a thousand small writes only reallocate a few times
+        DataBuffer grown;
+        size_t reallocations = 0;
+        size_t lastCapacity = grown.capacity();
+        for (uint32_t i = 0; i < 1000; ++i) {
+            grown << i;
+            if (grown.capacity() != lastCapacity) {
+                ++reallocations;
+                lastCapacity = grown.capacity();
+            }
+        }
+        ASSERT_EQ(grown.size(), 1000 * sizeof(uint32_t));
+        ASSERT_TRUE(reallocations < 12);
+        for (uint32_t i = 0; i < 1000; ++i) {
+            uint32_t v = 0;
+            grown >> v;
+            ASSERT_EQ(v, i);
+        }
+
+        // clear() keeps the allocation around for reuse
+        size_t before = grown.capacity();
+        grown.clear();
+        ASSERT_EQ(grown.size(), 0u);
+        ASSERT_EQ(grown.capacity(), before);
+
+        return 0;
+    } catch (...) {
+        return 255;
+    }
+}
@@ -0,0 +1,59 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include "networking/message.hpp"
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// A borrowed buffer reads the caller's bytes in place, keeps them across
+// moves, and copies them out on the first write.
+extern "C" int data_buffer_borrow_test(void) {
+    try {
+        std::vector<uint8_t> bytes(256);
+        for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i);
+
+        DataBuffer view = DataBuffer::borrow(bytes.data(), bytes.size());
+        ASSERT_TRUE(view.isBorrowed());
+        ASSERT_TRUE(!view.isInline());
+        ASSERT_TRUE(view.data() == bytes.data());
+        ASSERT_EQ(view.size(), bytes.size());
+        ASSERT_EQ(view.capacity(), 0u);
+        uint8_t first = 0;
+        view >> first;
+        ASSERT_EQ(first, 0);
+
+        // a move hands the borrowed range over, read position included
+        Message m(3, std::move(view));
+        ASSERT_TRUE(view.isInline());
+        ASSERT_EQ(view.size(), 0u);
+        ASSERT_TRUE(m.payload().isBorrowed());
+        ASSERT_TRUE(m.payload().data() == bytes.data());
+        uint8_t second = 0;
+        m.payload() >> second;
+        ASSERT_EQ(second, 1);
+
+        // the first write copies into owned storage, the source is untouched
+        m.payload() << uint8_t(0xFF);
+        ASSERT_TRUE(!m.payload().isBorrowed());
+        ASSERT_TRUE(m.payload().data() != bytes.data());
+        ASSERT_EQ(m.payload().size(), bytes.size() + 1);
+        ASSERT_EQ(std::memcmp(m.payload().data(), bytes.data(), bytes.size()), 0);
+        ASSERT_EQ(bytes.size(), 256u);
+        ASSERT_EQ(bytes[255], 255);
+
+        // clear() forgets the range instead of writing over it
+        DataBuffer cleared = DataBuffer::borrow(bytes.data(), 16);
+        cleared.clear();
+        ASSERT_TRUE(!cleared.isBorrowed());
+        ASSERT_TRUE(cleared.isInline());
+        cleared << uint32_t(42);
+        ASSERT_EQ(bytes[0], 0);
+
+        DataBuffer empty = DataBuffer::borrow(bytes.data(), 0);
+        ASSERT_TRUE(!empty.isBorrowed());
+        ASSERT_TRUE(empty.isInline());
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include "networking/message.hpp"
+#include <vector>
+#include <array>
+#include <string>
+
+// Explicit byte order: exact wire bytes, round trips through scalars,
+// containers and views, and agreement of the SIMD kernel with the scalar one.
+extern "C" int data_buffer_byte_order_test(void) {
+    try {
+        // Scalars in big endian are laid out most significant byte first
+        DataBuffer big;
+        big.setByteOrder(DataBuffer::ByteOrder::Big);
+        big << uint32_t(0x01020304) << uint16_t(0x0A0B) << 1.0f;
+        const uint8_t expected[] = {0x01, 0x02, 0x03, 0x04, 0x0A, 0x0B, 0x3F, 0x80, 0x00, 0x00};
+        ASSERT_EQ(big.size(), sizeof(expected));
+        ASSERT_TRUE(std::memcmp(big.data(), expected, sizeof(expected)) == 0);
+
+        uint32_t u32 = 0;
+        uint16_t u16 = 0;
+        float f = 0;
+        big >> u32 >> u16 >> f;
+        ASSERT_EQ(u32, 0x01020304u);
+        ASSERT_EQ(u16, 0x0A0B);
+        ASSERT_EQ(f, 1.0f);
+
+        DataBuffer little;
+        little.setByteOrder(DataBuffer::ByteOrder::Little);
+        little << uint32_t(0x01020304);
+        ASSERT_EQ(little.data()[0], 0x04);
+
+        // Arrays of every width and awkward lengths hit the vector body and the tail
+        for (size_t n : {0ul, 1ul, 7ul, 8ul, 17ul, 33ul, 100ul, 1000ul}) {
+            std::vector<uint16_t> a16(n);
+            std::vector<int32_t> a32(n);
+            std::vector<double> a64(n);
+            for (size_t i = 0; i < n; ++i) {
+                a16[i] = static_cast<uint16_t>(i * 257 + 1);
+                a32[i] = static_cast<int32_t>(i * 16777259) - 5;
+                a64[i] = static_cast<double>(i) * 1.25 - 3.0;
+            }
+            DataBuffer buf;
+            buf.setByteOrder(DataBuffer::ByteOrder::Big);
+            buf << a16 << a32 << a64;
+
+            if (n > 0) {
+                // Count prefix is big endian too, first element follows it
+                const uint8_t* p = buf.data();
+                ASSERT_EQ(p[sizeof(size_t) - 1], static_cast<uint8_t>(n));
+                ASSERT_EQ(p[sizeof(size_t)], static_cast<uint8_t>(a16[0] >> 8));
+            }
+
+            std::vector<uint16_t> b16;
+            std::vector<int32_t> b32;
+            std::vector<double> b64;
+            buf >> b16 >> b32 >> b64;
+            ASSERT_TRUE(a16 == b16);
+            ASSERT_TRUE(a32 == b32);
+            ASSERT_TRUE(a64 == b64);
+        }
+
+        // Views convert element by element and refuse to expose a typed span
+        DataBuffer arr;
+        arr.setByteOrder(DataBuffer::ByteOrder::Big);
+        const std::array<uint64_t, 3> src = {1, 0x0102030405060708ULL, 3};
+        arr.writeArray(src.data(), src.size());
+        ASSERT_EQ(arr.data()[8], 0x01);
+        ArrayView<uint64_t> view = arr.readArray<uint64_t>(3);
+        ASSERT_EQ(view[1], 0x0102030405060708ULL);
+        uint64_t sum = 0;
+        for (uint64_t v : view) sum += v;
+        ASSERT_EQ(sum, 4 + 0x0102030405060708ULL);
+        ASSERT_EQ(view.isSwapped(), std::endian::native == std::endian::little);
+        if (view.isSwapped()) {
+            bool threw = false;
+            try { (void)view.asSpan(); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+        }
+
+        // Dispatched kernel matches the scalar reference, including in place
+        std::vector<uint8_t> raw(257);
+        for (size_t i = 0; i < raw.size(); ++i) raw[i] = static_cast<uint8_t>(i * 31 + 7);
+        for (size_t width : {2ul, 4ul, 8ul}) {
+            for (size_t count = 0; count * width <= raw.size(); ++count) {
+                std::vector<uint8_t> fast(raw.size()), slow(raw.size());
+                byte_swap_copy(fast.data(), raw.data() + 1, count, width);
+                byte_swap_copy_scalar(slow.data(), raw.data() + 1, count, width);
+                ASSERT_TRUE(std::memcmp(fast.data(), slow.data(), count * width) == 0);
+                std::vector<uint8_t> inplace(raw.begin() + 1, raw.end());
+                byte_swap_copy(inplace.data(), inplace.data(), count, width);
+                ASSERT_TRUE(std::memcmp(inplace.data(), slow.data(), count * width) == 0);
+            }
+        }
+
+        // Message forwards the mode to its payload
+        Message msg(1);
+        msg.setByteOrder(DataBuffer::ByteOrder::Big);
+        msg << uint32_t(7) << std::string("x");
+        ASSERT_EQ(msg.payload().data()[3], 7);
+        msg.payload().rewind();
+        ASSERT_EQ(msg.pop<uint32_t>(), 7u);
+        ASSERT_EQ(msg.popString(), "x");
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include "networking/message.hpp"
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <optional>
+#include <variant>
+
+namespace {
+
+struct Sample {
+    float x;
+    float y;
+    uint16_t id;
+};
+
+// Round trip every codec under the given integer encoding.
+int roundTrip(DataBuffer::IntegerEncoding encoding) {
+    DataBuffer buf;
+    buf.setIntegerEncoding(encoding);
+
+    const std::vector<float> floats = {1.0f, -2.5f, 3.25f, 1e6f};
+    const std::vector<int32_t> ints = {0, -1, 70000, -70000};
+    const std::vector<std::string> words = {"alpha", "", "gamma"};
+    const std::vector<bool> bits = {true, false, true};
+    const std::vector<Sample> samples = {{1.0f, 2.0f, 3}, {4.0f, 5.0f, 6}};
+    const std::array<uint32_t, 3> fixed = {7, 8, 9};
+    const std::map<std::string, std::vector<int16_t>> table = {{"a", {1, 2}}, {"b", {}}};
+    const std::unordered_map<uint32_t, double> lookup = {{1, 0.5}, {2, 0.25}};
+    const std::optional<std::string> some = std::string("present");
+    const std::optional<int64_t> none;
+    const std::variant<int32_t, std::string, std::vector<uint8_t>> alt = std::string("variant");
+    const std::pair<uint8_t, std::string> pair = {4, "four"};
+
+    const size_t expected = buf.serializedSize(floats) + buf.serializedSize(ints)
+        + buf.serializedSize(words) + buf.serializedSize(bits) + buf.serializedSize(samples)
+        + buf.serializedSize(fixed) + buf.serializedSize(table) + buf.serializedSize(lookup)
+        + buf.serializedSize(some) + buf.serializedSize(none) + buf.serializedSize(alt)
+        + buf.serializedSize(pair);
+
+    buf << floats << ints << words << bits << samples << fixed << table << lookup
+        << some << none << alt << pair;
+    ASSERT_EQ(buf.size(), expected);
+
+    std::vector<float> rFloats;
+    std::vector<int32_t> rInts;
+    std::vector<std::string> rWords;
+    std::vector<bool> rBits;
+    std::vector<Sample> rSamples;
+    std::array<uint32_t, 3> rFixed{};
+    std::map<std::string, std::vector<int16_t>> rTable;
+    std::unordered_map<uint32_t, double> rLookup;
+    std::optional<std::string> rSome;
+    std::optional<int64_t> rNone = 5;
+    std::variant<int32_t, std::string, std::vector<uint8_t>> rAlt;
+    std::pair<uint8_t, std::string> rPair;
+
+    buf >> rFloats >> rInts >> rWords >> rBits >> rSamples >> rFixed >> rTable >> rLookup
+        >> rSome >> rNone >> rAlt >> rPair;
+
+    ASSERT_TRUE(rFloats == floats);
+    ASSERT_TRUE(rInts == ints);
+    ASSERT_TRUE(rWords == words);
+    ASSERT_TRUE(rBits == bits);
+    ASSERT_EQ(rSamples.size(), samples.size());
+    ASSERT_EQ(rSamples[1].id, 6);
+    ASSERT_EQ(rSamples[1].y, 5.0f);
+    ASSERT_TRUE(rFixed == fixed);
+    ASSERT_TRUE(rTable == table);
+    ASSERT_TRUE(rLookup == lookup);
+    ASSERT_TRUE(rSome == some);
+    ASSERT_TRUE(!rNone.has_value());
+    ASSERT_TRUE(rAlt == alt);
+    ASSERT_TRUE(rPair == pair);
+    ASSERT_EQ(buf.readPosition(), buf.size());
+    return 0;
+}
+
+}
+
+extern "C" int data_buffer_container_codec_test(void) {
+    try {
+        if (roundTrip(DataBuffer::IntegerEncoding::Fixed) != 0) return 255;
+        if (roundTrip(DataBuffer::IntegerEncoding::Varint) != 0) return 255;
+
+        // trivially-copyable vectors are a length prefix plus one block
+        DataBuffer bulk;
+        std::vector<double> values(100, 1.5);
+        bulk << values;
+        ASSERT_EQ(bulk.size(), sizeof(size_t) + 100 * sizeof(double));
+
+        // a forged element count larger than the payload is rejected before allocating
+        DataBuffer forged;
+        forged << size_t(1) << 60;
+        bool threw = false;
+        try {
+            std::vector<uint64_t> out;
+            forged >> out;
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+
+        // Message forwards containers to its payload; strings keep their own format
+        Message m(9);
+        m << std::vector<uint16_t>{10, 20, 30} << std::string("tail");
+        std::vector<uint16_t> r = m.pop<std::vector<uint16_t>>();
+        ASSERT_EQ(r.size(), 3u);
+        ASSERT_EQ(r[2], 30);
+        ASSERT_EQ(m.pop<std::string>(), "tail");
+        return 0;
+    } catch (...) {
+        return 255;
+    }
+}
@@ -0,0 +1,67 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include "networking/message.hpp"
+#include <string>
+#include <utility>
+
+// Small payloads stay in the inline area; spilling and moves keep the data.
+extern "C" int data_buffer_inline_storage_test(void) {
+    try {
+        DataBuffer small;
+        ASSERT_TRUE(small.isInline());
+        ASSERT_EQ(small.capacity(), DataBuffer::INLINE_CAPACITY);
+        small << int32_t(1) << double(2.5) << std::string("tiny");
+        ASSERT_TRUE(small.isInline());
+
+        // moving an inline buffer copies the bytes and empties the source
+        DataBuffer movedSmall(std::move(small));
+        ASSERT_TRUE(movedSmall.isInline());
+        ASSERT_EQ(small.size(), 0u);
+        ASSERT_TRUE(small.isInline());
+        int32_t a = 0;
+        double b = 0;
+        std::string c;
+        movedSmall >> a;
+        // read position travels with the data
+        DataBuffer resumed;
+        resumed = std::move(movedSmall);
+        resumed >> b >> c;
+        ASSERT_EQ(a, 1);
+        ASSERT_EQ(b, 2.5);
+        ASSERT_EQ(c, "tiny");
+
+        // spill to the heap once the inline area is exhausted
+        DataBuffer big;
+        for (uint32_t i = 0; i < 64; ++i) big << i;
+        ASSERT_TRUE(!big.isInline());
+        const uint8_t* heapBlock = big.data();
+        DataBuffer movedBig(std::move(big));
+        ASSERT_TRUE(movedBig.data() == heapBlock);
+        ASSERT_TRUE(big.isInline());
+        ASSERT_EQ(big.size(), 0u);
+        for (uint32_t i = 0; i < 64; ++i) {
+            uint32_t v = 0;
+            movedBig >> v;
+            ASSERT_EQ(v, i);
+        }
+
+        // a heap buffer move-assigned over an inline one and back
+        DataBuffer target;
+        target << uint8_t(9);
+        target = std::move(movedBig);
+        ASSERT_EQ(target.size(), 64 * sizeof(uint32_t));
+        movedBig = std::move(target);
+        ASSERT_EQ(movedBig.data(), heapBlock);
+
+        // a typical small Message never leaves the inline area
+        Message m(1);
+        m << int32_t(7) << std::string("ping");
+        ASSERT_TRUE(m.payload().isInline());
+        Message moved(std::move(m));
+        ASSERT_EQ(moved.pop<int32_t>(), 7);
+        ASSERT_EQ(moved.popString(), "ping");
+        return 0;
+    } catch (...) {
+        return 255;
+    }
+}
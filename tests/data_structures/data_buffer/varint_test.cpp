@@ -0,0 +1,120 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <string>
+#include <limits>
+#include <vector>
+
+// Varint/zigzag round trips, encoded sizes, and agreement between the
+// word-at-a-time decoder and the byte-by-byte tail decoder.
+extern "C" int data_buffer_varint_test(void) {
+    try {
+        const std::vector<uint64_t> unsignedValues = {
+            0, 1, 127, 128, 300, 16383, 16384, (1ULL << 28) - 1, 1ULL << 35,
+            (1ULL << 56) - 1, 1ULL << 56, (1ULL << 63), std::numeric_limits<uint64_t>::max()
+        };
+        for (uint64_t v : unsignedValues) {
+            DataBuffer buf;
+            buf.writeVarint(v);
+            ASSERT_EQ(buf.size(), DataBuffer::varintSize(v));
+            // padded: exercises the 64-bit load path
+            DataBuffer padded;
+            padded.writeVarint(v);
+            padded << uint64_t(0) << uint64_t(0);
+            ASSERT_EQ(buf.readVarint(), v);
+            ASSERT_EQ(padded.readVarint(), v);
+            ASSERT_EQ(padded.readPosition(), buf.size());
+        }
+
+        const std::vector<int64_t> signedValues = {
+            0, -1, 1, -64, 63, -65, 64, -1000000, 1000000,
+            std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()
+        };
+        for (int64_t v : signedValues) {
+            DataBuffer buf;
+            buf.writeZigZag(v);
+            ASSERT_EQ(buf.readZigZag(), v);
+        }
+
+        // operator<< / >> follow the selected encoding
+        DataBuffer compact;
+        compact.setIntegerEncoding(DataBuffer::IntegerEncoding::Varint);
+        compact << uint32_t(5) << int32_t(-3) << uint64_t(1) << int16_t(-2)
+                << std::string("id") << float(1.5f) << uint8_t(200);
+        // 4 one-byte integers, (1 + 2) for the string, 4 for the float, 1 raw byte
+        ASSERT_EQ(compact.size(), 12u);
+
+        uint32_t a = 0;
+        int32_t b = 0;
+        uint64_t c = 0;
+        int16_t d = 0;
+        std::string e;
+        float f = 0;
+        uint8_t g = 0;
+        compact >> a >> b >> c >> d >> e >> f >> g;
+        ASSERT_EQ(a, 5u);
+        ASSERT_EQ(b, -3);
+        ASSERT_EQ(c, 1u);
+        ASSERT_EQ(d, -2);
+        ASSERT_EQ(e, "id");
+        ASSERT_EQ(f, 1.5f);
+        ASSERT_EQ(g, 200);
+
+        // the encoding travels with a moved buffer
+        DataBuffer moved(std::move(compact));
+        ASSERT_TRUE(moved.integerEncoding() == DataBuffer::IntegerEncoding::Varint);
+
+        // a value too large for the target type is rejected
+        DataBuffer wide;
+        wide.setIntegerEncoding(DataBuffer::IntegerEncoding::Varint);
+        wide << uint64_t(70000);
+        bool threw = false;
+        try {
+            uint16_t narrow;
+            wide >> narrow;
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+
+        // truncated input
+        DataBuffer truncated;
+        truncated << uint8_t(0x80) << uint8_t(0x80);
+        threw = false;
+        try {
+            truncated.readVarint();
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+
+        // over-long input (11 continuation bytes)
+        DataBuffer overlong;
+        for (int i = 0; i < 11; ++i) overlong << uint8_t(0xFF);
+        overlong << uint8_t(0);
+        threw = false;
+        try {
+            overlong.readVarint();
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+
+        // many mixed values back to back through both decode paths
+        DataBuffer stream;
+        uint64_t x = 0x9E3779B97F4A7C15ULL;
+        std::vector<uint64_t> written;
+        for (int i = 0; i < 2000; ++i) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            uint64_t v = x >> (x % 64);
+            written.push_back(v);
+            stream.writeVarint(v);
+        }
+        for (uint64_t v : written) {
+            ASSERT_EQ(stream.readVarint(), v);
+        }
+        ASSERT_EQ(stream.readPosition(), stream.size());
+        return 0;
+    } catch (...) {
+        return 255;
+    }
+}
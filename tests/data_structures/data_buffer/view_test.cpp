@@ -0,0 +1,65 @@
+#include "../../test_utils.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <string>
+#include <string_view>
+
+// Views point into the buffer: no copy, only the read cursor moves.
+extern "C" int data_buffer_view_test(void) {
+    try {
+        DataBuffer buf;
+        uint8_t tag = 3;
+        buf << tag << std::string("zero-copy");
+        const int16_t samples[5] = {1, -2, 300, -4000, 32000};
+        buf.write(samples, sizeof(samples));
+        buf << uint32_t(0xDEADBEEF);
+
+        uint8_t rtag = 0;
+        buf >> rtag;
+        ASSERT_EQ(rtag, tag);
+
+        std::string_view sv = buf.readStringView();
+        ASSERT_EQ(sv, std::string_view("zero-copy"));
+        ASSERT_TRUE(reinterpret_cast<const uint8_t*>(sv.data()) > buf.data());
+        ASSERT_TRUE(reinterpret_cast<const uint8_t*>(sv.data()) < buf.data() + buf.size());
+
+        // samples start at an odd offset: elements are still readable by value
+        ArrayView<int16_t> view = buf.readArray<int16_t>(5);
+        ASSERT_EQ(view.size(), 5u);
+        for (size_t i = 0; i < 5; ++i) {
+            ASSERT_EQ(view[i], samples[i]);
+        }
+        int sum = 0;
+        for (int16_t v : view) sum += v;
+        ASSERT_EQ(sum, 1 - 2 + 300 - 4000 + 32000);
+        int16_t copied[5] = {};
+        view.copyTo(copied);
+        ASSERT_TRUE(std::memcmp(copied, samples, sizeof(samples)) == 0);
+
+        std::span<const uint8_t> tail = buf.readBytes(sizeof(uint32_t));
+        uint32_t magic = 0;
+        std::memcpy(&magic, tail.data(), sizeof(magic));
+        ASSERT_EQ(magic, 0xDEADBEEFu);
+        ASSERT_EQ(buf.readPosition(), buf.size());
+
+        bool threw = false;
+        try {
+            buf.readBytes(1);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+
+        // an oversized element count must not overflow the bounds check
+        buf.rewind();
+        threw = false;
+        try {
+            buf.readArray<uint64_t>(static_cast<size_t>(-1) / 4);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+        return 0;
+    } catch (...) {
+        return 255;
+    }
+}
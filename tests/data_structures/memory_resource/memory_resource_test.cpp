@@ -0,0 +1,136 @@
+#include "../../test_utils.hpp"
+#include "data_structures/memory_resource.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <memory_resource>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace {
+
+// Upstream that counts what reaches it
+class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+};
+
+bool aligned(const void* p, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+}
+
+// SizeClassResource and FrameArena behind std::pmr containers and DataBuffer.
+extern "C" int memory_resource_test(void) {
+    try {
+        CountingResource upstream;
+        {
+            SizeClassResource classes(1024, 4096, &upstream);
+            ASSERT_EQ(classes.classCount(), 8u); // 8 .. 1024
+            ASSERT_EQ(classes.blockSizeFor(1, 1), 8u);
+            ASSERT_EQ(classes.blockSizeFor(1), alignof(std::max_align_t));
+            ASSERT_EQ(classes.blockSizeFor(24, 8), 32u);
+            ASSERT_EQ(classes.blockSizeFor(8, 64), 64u);
+            ASSERT_EQ(classes.blockSizeFor(2000), 0u);
+
+            // Freed blocks are reused without going upstream
+            void* a = classes.allocate(24, 8);
+            void* b = classes.allocate(24, 8);
+            ASSERT_TRUE(a != b);
+            ASSERT_EQ(upstream.allocations, 1u);
+            classes.deallocate(a, 24, 8);
+            void* c = classes.allocate(30, 8);
+            ASSERT_TRUE(c == a);
+            void* wide = classes.allocate(8, 64);
+            ASSERT_TRUE(aligned(wide, 64));
+            classes.deallocate(b, 24, 8);
+            classes.deallocate(c, 30, 8);
+            classes.deallocate(wide, 8, 64);
+
+            // Oversized requests go straight upstream
+            const size_t before = upstream.allocations;
+            void* big = classes.allocate(5000);
+            ASSERT_EQ(upstream.allocations, before + 1);
+            classes.deallocate(big, 5000);
+
+            std::pmr::vector<std::pmr::string> names(&classes);
+            for (int i = 0; i < 200; ++i) names.emplace_back(std::string(40, static_cast<char>('a' + i % 26)));
+            ASSERT_TRUE(names[27] == std::pmr::string(40, 'b'));
+            ASSERT_TRUE(names[0].get_allocator().resource() == &classes);
+        }
+        ASSERT_EQ(upstream.allocations, upstream.deallocations);
+
+        // FrameArena: reset() recycles the blocks, nothing reaches upstream again
+        CountingResource arenaUpstream;
+        {
+            FrameArena frame(1024, &arenaUpstream);
+            for (int round = 0; round < 3; ++round) {
+                std::pmr::vector<int> values(&frame);
+                for (int i = 0; i < 1000; ++i) values.push_back(i);
+                std::pmr::string text("a string long enough to leave the SSO buffer", &frame);
+                DataBuffer scratch(&frame);
+                ASSERT_TRUE(scratch.resource() == &frame);
+                std::vector<uint8_t> bytes(300, 7);
+                scratch.write(bytes.data(), bytes.size());
+                ASSERT_EQ(values[999], 999);
+                ASSERT_TRUE(frame.bytesAllocated() > 4000u);
+                if (round == 0) {
+                    ASSERT_TRUE(arenaUpstream.allocations > 0u);
+                }
+                const size_t blocksBefore = frame.blockCount();
+                // Objects die before the reset
+                values = std::pmr::vector<int>(&frame);
+                frame.reset();
+                ASSERT_EQ(frame.bytesAllocated(), 0u);
+                ASSERT_EQ(frame.blockCount(), blocksBefore);
+            }
+            const size_t warm = arenaUpstream.allocations;
+            void* p = frame.allocate(100, 32);
+            ASSERT_TRUE(aligned(p, 32));
+            ASSERT_EQ(arenaUpstream.allocations, warm);
+            frame.release();
+            ASSERT_EQ(frame.blockCount(), 0u);
+        }
+        ASSERT_EQ(arenaUpstream.allocations, arenaUpstream.deallocations);
+
+        // A caller-owned first buffer is used first and never freed
+        alignas(std::max_align_t) unsigned char stack[256];
+        FrameArena onStack(stack, sizeof(stack));
+        void* first = onStack.allocate(64);
+        ASSERT_TRUE(first == stack);
+        void* spill = onStack.allocate(1000);
+        ASSERT_TRUE(spill != nullptr);
+        ASSERT_EQ(onStack.blockCount(), 2u);
+        onStack.release();
+        ASSERT_EQ(onStack.blockCount(), 1u);
+
+        // DataBuffer moves carry the resource with the block
+        SizeClassResource pool;
+        DataBuffer source(&pool, 512);
+        std::vector<uint8_t> payload(400, 3);
+        source.write(payload.data(), payload.size());
+        DataBuffer moved(std::move(source));
+        ASSERT_TRUE(moved.resource() == &pool);
+        ASSERT_EQ(moved.size(), 400u);
+        DataBuffer plain;
+        plain = std::move(moved);
+        ASSERT_TRUE(plain.resource() == &pool);
+        ASSERT_EQ(plain.data()[399], 3);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "../../test_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "data_structures/concurrent_pool.hpp"
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+namespace {
+
+// Throws when built from the value 3
+struct Picky {
+    int value;
+    explicit Picky(int v) : value(v) {
+        if (v == 3) throw std::runtime_error("picky");
+    }
+};
+
+}
+
+// acquireN()/releaseN(): batches come out in acquire() order, and a failing
+// batch (short pool, throwing constructor, bad release list) changes nothing.
+extern "C" int pool_batch_test(void) {
+    try {
+        Pool<std::string> pool;
+        pool.resize(8);
+        std::vector<Pool<std::string>::Object*> batch(5);
+        pool.acquireN(batch, [](size_t i) { return std::string(1, static_cast<char>('a' + i)); });
+        ASSERT_EQ(pool.usedCount(), 5u);
+        ASSERT_EQ(pool.liveObjects().size(), 5u);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            ASSERT_EQ(**batch[i], std::string(1, static_cast<char>('a' + i)));
+            // slots come out in address order, as with acquire()
+            if (i > 0) ASSERT_TRUE(batch[i]->object > batch[i - 1]->object);
+        }
+
+        // Too many for a fixed pool: nothing taken
+        std::vector<Pool<std::string>::Object*> tooMany(4);
+        bool threw = false;
+        try { pool.acquireN(tooMany); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(pool.availableCount(), 3u);
+
+        // Duplicate in the release list: nothing released
+        std::vector<Pool<std::string>::Object*> dup = {batch[0], batch[1], batch[0]};
+        threw = false;
+        try { pool.releaseN(dup); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(pool.usedCount(), 5u);
+        ASSERT_TRUE(batch[0]->isInUse() && batch[1]->isInUse());
+
+        pool.releaseN(batch);
+        ASSERT_EQ(pool.usedCount(), 0u);
+        ASSERT_EQ(pool.liveObjects().size(), 0u);
+
+        // Construction from a range; a throwing constructor rolls back
+        Pool<Picky> picky;
+        picky.resize(6);
+        std::vector<Pool<Picky>::Object*> out(3);
+        std::vector<int> good = {0, 1, 2, 99};
+        picky.acquireN(out, good);
+        ASSERT_EQ((*out[2])->value, 2);
+        picky.releaseN(out);
+        Pool<Picky>::Object* next = picky.try_acquire(7);
+        ASSERT_TRUE(next != nullptr);
+        picky.release(*next);
+
+        std::vector<int> bad = {1, 2, 3};
+        threw = false;
+        try { picky.acquireN(out, bad); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(picky.usedCount(), 0u);
+        std::vector<int> shortRange = {1};
+        threw = false;
+        try { picky.acquireN(out, shortRange); } catch (const std::invalid_argument&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(picky.usedCount(), 0u);
+        // The free list order is preserved by the failed batches
+        Pool<Picky>::Object* again = picky.try_acquire(7);
+        ASSERT_TRUE(again == next);
+        picky.release(*again);
+
+        // Growth pools grow to fit the batch
+        Pool<int> grown;
+        grown.setGrowth(4);
+        std::vector<Pool<int>::Object*> ints(10);
+        grown.acquireN(ints, [](size_t i) { return static_cast<int>(i); });
+        ASSERT_EQ(grown.capacity(), 12u);
+        ASSERT_EQ(grown.highWaterMark(), 10u);
+        grown.releaseN(ints);
+
+        // ConcurrentPool: same contract
+        ConcurrentPool<Picky> cpool;
+        cpool.resize(4);
+        std::vector<ConcurrentPool<Picky>::Object*> cout(3);
+        cpool.acquireN(cout, [](size_t i) { return static_cast<int>(i + 10); });
+        ASSERT_EQ(cpool.usedCount(), 3u);
+        ASSERT_EQ((*cout[1])->value, 11);
+        std::vector<ConcurrentPool<Picky>::Object*> two(2);
+        threw = false;
+        try { cpool.acquireN(two, good); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(cpool.availableCount(), 1u);
+        cpool.releaseN(cout);
+        ASSERT_EQ(cpool.availableCount(), 4u);
+        threw = false;
+        try { cpool.acquireN(cout, bad); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(cpool.availableCount(), 4u);
+        threw = false;
+        try { cpool.releaseN(cout); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        // Concurrent batches never hand out a slot twice
+        ConcurrentPool<int> shared;
+        shared.resize(64);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&shared, t] {
+                std::vector<ConcurrentPool<int>::Object*> mine(8);
+                for (int round = 0; round < 2000; ++round) {
+                    shared.acquireN(mine, [t](size_t i) { return t * 100 + static_cast<int>(i); });
+                    for (size_t i = 0; i < mine.size(); ++i) {
+                        if (**mine[i] != t * 100 + static_cast<int>(i)) throw std::runtime_error("slot shared");
+                    }
+                    shared.releaseN(mine);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        ASSERT_EQ(shared.availableCount(), 64u);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
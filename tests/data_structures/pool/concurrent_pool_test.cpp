@@ -0,0 +1,77 @@
+#include "../../test_utils.hpp"
+#include "data_structures/concurrent_pool.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Single-threaded contract (same as Pool) and a multi-threaded stress run
+// checking that no slot is ever handed to two threads at once.
+extern "C" int concurrent_pool_test(void) {
+    try {
+        ConcurrentPool<std::string> strings;
+        strings.resize(2);
+        auto& a = strings.acquire("alpha");
+        auto& b = strings.acquire(3, 'b');
+        ASSERT_EQ(*a, "alpha");
+        ASSERT_EQ(*b, "bbb");
+        ASSERT_EQ(strings.usedCount(), 2u);
+        ASSERT_TRUE(strings.try_acquire("none") == nullptr);
+        bool threw = false;
+        try { strings.acquire("none"); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        strings.release(a);
+        threw = false;
+        try { strings.release(a); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        {
+            auto h = strings.acquireHandle("scoped");
+            ASSERT_TRUE(h.valid());
+            ASSERT_EQ(*h, "scoped");
+            ASSERT_EQ(strings.availableCount(), 0u);
+        }
+        ASSERT_EQ(strings.availableCount(), 1u);
+
+        ConcurrentPool<std::string> other;
+        other.resize(1);
+        auto& foreign = other.acquire("x");
+        threw = false;
+        try { strings.release(foreign); } catch (const std::invalid_argument&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        // Stress: every thread stamps its objects and checks the stamp survives
+        constexpr int kThreads = 4;
+        constexpr int kRounds = 20000;
+        ConcurrentPool<uint64_t> shared;
+        shared.resize(16);
+        std::atomic<bool> corrupted{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < kThreads; ++t) {
+            workers.emplace_back([&, t] {
+                ConcurrentPool<uint64_t>::Object* held[3];
+                for (int r = 0; r < kRounds; ++r) {
+                    for (int k = 0; k < 3; ++k) {
+                        held[k] = shared.try_acquire(uint64_t(t) << 32 | uint64_t(r * 3 + k));
+                        while (!held[k]) {
+                            std::this_thread::yield();
+                            held[k] = shared.try_acquire(uint64_t(t) << 32 | uint64_t(r * 3 + k));
+                        }
+                    }
+                    if (r % 64 == 0) std::this_thread::yield();
+                    for (int k = 0; k < 3; ++k) {
+                        if (**held[k] != (uint64_t(t) << 32 | uint64_t(r * 3 + k))) corrupted = true;
+                        shared.release(*held[k]);
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        ASSERT_TRUE(!corrupted.load());
+        ASSERT_EQ(shared.availableCount(), 16u);
+        ASSERT_EQ(shared.usedCount(), 0u);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "../../test_utils.hpp"
+#include "data_structures/pool.hpp"
+#include <string>
+#include <vector>
+
+// Growth mode: chunks are appended on demand, objects never move, shrink()
+// frees idle chunks and the high-water mark records the peak.
+extern "C" int pool_growth_test(void) {
+    try {
+        Pool<std::string> pool;
+        pool.setGrowth(4);
+        ASSERT_EQ(pool.growthChunk(), 4u);
+        pool.resize(2);
+
+        std::vector<Pool<std::string>::Object*> held;
+        std::vector<std::string*> addresses;
+        for (int i = 0; i < 11; ++i) {
+            held.push_back(&pool.acquire(std::to_string(i)));
+            addresses.push_back(held.back()->object);
+        }
+        // 2 initial slots + 3 chunks of 4
+        ASSERT_EQ(pool.capacity(), 14u);
+        ASSERT_EQ(pool.chunkCount(), 4u);
+        ASSERT_EQ(pool.highWaterMark(), 11u);
+        for (int i = 0; i < 11; ++i) {
+            ASSERT_EQ(held[i]->object, addresses[i]);
+            ASSERT_EQ(**held[i], std::to_string(i));
+        }
+
+        // Empty the third chunk (slots 6..9) and the initial one (0..1)
+        for (int i : {0, 1, 6, 7, 8, 9}) pool.release(*held[i]);
+        ASSERT_EQ(pool.shrink(), 6u);
+        ASSERT_EQ(pool.capacity(), 8u);
+        ASSERT_EQ(pool.chunkCount(), 2u);
+        ASSERT_EQ(pool.availableCount(), 3u);
+        ASSERT_EQ(**held[10], "10");
+
+        // Holes are reused, survivors still release cleanly
+        for (int i = 0; i < 5; ++i) pool.acquire("again");
+        ASSERT_EQ(pool.capacity(), 12u);
+        ASSERT_EQ(pool.highWaterMark(), 11u);
+        pool.resetHighWaterMark();
+        ASSERT_EQ(pool.highWaterMark(), 10u);
+        for (int i : {2, 3, 4, 5, 10}) pool.release(*held[i]);
+
+        // shrink() respects the requested floor
+        Pool<int> ints;
+        ints.setGrowth(8);
+        std::vector<Pool<int>::Object*> some;
+        for (int i = 0; i < 24; ++i) some.push_back(&ints.acquire(i));
+        for (auto* o : some) ints.release(*o);
+        ASSERT_EQ(ints.shrink(10), 8u);
+        ASSERT_EQ(ints.capacity(), 16u);
+        ASSERT_EQ(ints.shrink(), 16u);
+        ASSERT_EQ(ints.capacity(), 0u);
+        ASSERT_TRUE(ints.try_acquire(5) != nullptr);
+
+        // Fixed pools still throw when exhausted
+        Pool<int> fixed;
+        fixed.resize(1);
+        fixed.acquire(1);
+        bool threw = false;
+        try { fixed.acquire(2); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_TRUE(fixed.try_acquire(3) == nullptr);
+
+        // Releasing a foreign object is rejected
+        Pool<int> other;
+        other.resize(1);
+        auto& foreign = other.acquire(9);
+        threw = false;
+        try { fixed.release(foreign); } catch (const std::invalid_argument&) { threw = true; }
+        ASSERT_TRUE(threw);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "../../test_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "data_structures/data_buffer.hpp"
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// Compact Ids: stale use is detected after release/reacquire, clear() and
+// shrink(), Ids survive serialization, and forEach() walks live objects only.
+extern "C" int pool_id_test(void) {
+    try {
+        static_assert(sizeof(Pool<int>::Id) == 8);
+
+        Pool<std::string> pool;
+        pool.resize(4);
+        ASSERT_TRUE(!Pool<std::string>::Id{});
+        ASSERT_TRUE(pool.lookup(Pool<std::string>::Id{}) == nullptr);
+
+        Pool<std::string>::Id a = pool.acquireId("a");
+        Pool<std::string>::Id b = pool.acquireId("b");
+        ASSERT_TRUE(static_cast<bool>(a));
+        ASSERT_TRUE(pool.contains(a) && pool.contains(b));
+        ASSERT_EQ(**pool.lookup(b), "b");
+        ASSERT_TRUE(pool.idOf(*pool.lookup(a)) == a);
+
+        // Same slot reacquired: the old Id is stale, the new one is not
+        pool.release(a);
+        ASSERT_TRUE(!pool.contains(a));
+        Pool<std::string>::Id again = pool.acquireId("again");
+        ASSERT_EQ(again.slot, a.slot);
+        ASSERT_TRUE(!(again == a));
+        ASSERT_TRUE(pool.lookup(a) == nullptr);
+        ASSERT_EQ(**pool.lookup(again), "again");
+
+        bool threw = false;
+        try { pool.release(a); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        // Ids are plain data and round-trip through a DataBuffer
+        DataBuffer buf;
+        buf << b;
+        Pool<std::string>::Id decoded;
+        buf >> decoded;
+        ASSERT_EQ(**pool.lookup(decoded), "b");
+
+        // Dense live iteration and Handle ids
+        auto h = pool.acquireHandle("h");
+        ASSERT_TRUE(pool.contains(h.id()));
+        pool.release(b);
+        std::vector<std::string> seen;
+        pool.forEach([&](std::string& s) { seen.push_back(s); });
+        std::sort(seen.begin(), seen.end());
+        ASSERT_EQ(seen.size(), 2u);
+        ASSERT_EQ(seen[0], "again");
+        ASSERT_EQ(seen[1], "h");
+        ASSERT_EQ(pool.liveObjects().size(), pool.usedCount());
+        Pool<std::string>::Id hid = h.id();
+        h.release();
+        ASSERT_TRUE(!pool.contains(hid));
+
+        // clear() + resize() reuse slot numbers but never old generations
+        pool.resize(4);
+        ASSERT_TRUE(!pool.contains(again));
+        Pool<std::string>::Id fresh = pool.acquireId("fresh");
+        ASSERT_TRUE(!pool.contains(again));
+        ASSERT_TRUE(pool.contains(fresh));
+
+        // Slot numbers freed by shrink() are reused by later growth
+        Pool<int> ints;
+        ints.setGrowth(4);
+        std::vector<Pool<int>::Id> ids;
+        for (int i = 0; i < 12; ++i) ids.push_back(ints.acquireId(i));
+        for (int i = 4; i < 8; ++i) ints.release(ids[i]);
+        ASSERT_EQ(ints.shrink(), 4u);
+        for (int i = 4; i < 8; ++i) ASSERT_TRUE(!ints.contains(ids[i]));
+        std::vector<Pool<int>::Id> refill;
+        for (int i = 0; i < 4; ++i) refill.push_back(ints.acquireId(100 + i));
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(refill[i].slot >= 4 && refill[i].slot < 8);
+            ASSERT_TRUE(!ints.contains(ids[4 + i]));
+        }
+        int sum = 0;
+        ints.forEach([&](int& v) { sum += v; });
+        ASSERT_EQ(sum, (0 + 1 + 2 + 3) + (8 + 9 + 10 + 11) + (100 + 101 + 102 + 103));
+        for (int i : {0, 1, 2, 3, 8, 9, 10, 11}) ASSERT_EQ(**ints.lookup(ids[i]), i);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "../../test_utils.hpp"
+#include "data_structures/magazine_pool.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cache refill/spill through the depot, exhaustion, and objects acquired on
+// one thread and released on another.
+extern "C" int magazine_pool_test(void) {
+    try {
+        MagazinePool<std::string> pool(4);
+        pool.resize(10);
+        ASSERT_EQ(pool.magazineSize(), 4u);
+        {
+            MagazinePool<std::string>::Cache cache(pool);
+            std::vector<MagazinePool<std::string>::Object*> held;
+            for (int i = 0; i < 10; ++i) held.push_back(&cache.acquire(std::to_string(i)));
+            ASSERT_EQ(**held[9], "9");
+            ASSERT_EQ(pool.availableCount(), 0u);
+            bool threw = false;
+            try { cache.acquire("none"); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+            ASSERT_TRUE(cache.try_acquire("none") == nullptr);
+
+            // 10 releases: two magazines stay in the cache, one goes to the depot
+            for (auto* o : held) cache.release(*o);
+            ASSERT_EQ(cache.cachedCount() + pool.depotCount(), 10u);
+            ASSERT_EQ(pool.depotCount(), 4u);
+            threw = false;
+            try { cache.release(*held[0]); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+
+            ASSERT_EQ(pool.trim(), 4u);
+            ASSERT_EQ(pool.availableCount(), 4u);
+        }
+        // the cache flushed its slots on destruction
+        ASSERT_EQ(pool.availableCount(), 10u);
+
+        // Growth lets the depot add chunks instead of failing
+        MagazinePool<int> growing(8);
+        growing.setGrowth(16);
+        {
+            MagazinePool<int>::Cache cache(growing);
+            for (int i = 0; i < 40; ++i) cache.acquire(i);
+            ASSERT_EQ(growing.capacity(), 48u);
+        }
+
+        // Producer acquires, consumer releases; slots flow back via the depot
+        MagazinePool<uint64_t> shared(16);
+        shared.resize(256);
+        std::mutex m;
+        std::condition_variable cv;
+        std::deque<MagazinePool<uint64_t>::Object*> queue;
+        constexpr uint64_t kItems = 50000;
+        bool ok = true;
+
+        std::thread consumer([&] {
+            MagazinePool<uint64_t>::Cache cache(shared);
+            for (uint64_t expected = 0; expected < kItems; ++expected) {
+                std::unique_lock<std::mutex> lk(m);
+                cv.wait(lk, [&] { return !queue.empty(); });
+                auto* obj = queue.front();
+                queue.pop_front();
+                lk.unlock();
+                if (**obj != expected) ok = false;
+                cache.release(*obj);
+            }
+        });
+        {
+            MagazinePool<uint64_t>::Cache cache(shared);
+            for (uint64_t i = 0; i < kItems; ++i) {
+                MagazinePool<uint64_t>::Object* obj = cache.try_acquire(i);
+                while (!obj) {
+                    std::this_thread::yield();
+                    obj = cache.try_acquire(i);
+                }
+                {
+                    std::lock_guard<std::mutex> lg(m);
+                    queue.push_back(obj);
+                }
+                cv.notify_one();
+            }
+            consumer.join();
+        }
+        ASSERT_TRUE(ok);
+        shared.trim();
+        ASSERT_EQ(shared.availableCount(), 256u);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
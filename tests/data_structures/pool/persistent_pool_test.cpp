@@ -0,0 +1,131 @@
+#include "../../test_utils.hpp"
+#include "data_structures/persistent_pool.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct Record {
+    uint64_t id;
+    double balance;
+    char name[16];
+};
+
+struct TempFile {
+    std::string path;
+    explicit TempFile(std::string p_path) : path(std::move(p_path)) { ::unlink(path.c_str()); }
+    ~TempFile() { ::unlink(path.c_str()); }
+};
+
+}
+
+// Live records survive close()/open() and a process that dies without
+// closing; header mismatches are refused.
+extern "C" int persistent_pool_test(void) {
+    const TempFile file("/tmp/libftpp_persistent_pool_" + std::to_string(::getpid()) + ".pool");
+    const std::string& path = file.path;
+    int status = 0;
+    try {
+        std::vector<size_t> kept;
+        {
+            PersistentPool<Record> pool;
+            ASSERT_TRUE(pool.open(path, 8) == PersistentPool<Record>::OpenResult::Created);
+            ASSERT_EQ(pool.capacity(), 8u);
+            for (uint64_t i = 0; i < 5; ++i) {
+                Record& r = pool.acquire(Record{i, 10.0 * static_cast<double>(i), "user"});
+                kept.push_back(pool.indexOf(r));
+            }
+            pool.release(kept[1]);
+            kept.erase(kept.begin() + 1);
+            ASSERT_EQ(pool.usedCount(), 4u);
+
+            pool.release(*pool.at(kept[0]));
+            bool threw = false;
+            try { pool.release(kept[0]); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+            kept.erase(kept.begin());
+            Record outside{};
+            threw = false;
+            try { pool.release(outside); } catch (const std::invalid_argument&) { threw = true; }
+            ASSERT_TRUE(threw);
+
+            // A second opener is locked out
+            PersistentPool<Record> other;
+            threw = false;
+            try { other.open(path, 8); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+        }
+
+        // Clean restart: same objects at the same indices
+        {
+            PersistentPool<Record> pool;
+            ASSERT_TRUE(pool.open(path, 8) == PersistentPool<Record>::OpenResult::Resumed);
+            ASSERT_EQ(pool.usedCount(), 3u);
+            ASSERT_EQ(pool.at(kept[0])->id, 2u);
+            ASSERT_EQ(pool.at(kept[2])->balance, 40.0);
+            ASSERT_EQ(std::string(pool.at(kept[1])->name), "user");
+            ASSERT_TRUE(pool.at(0) == nullptr);
+            size_t visited = 0;
+            bool indicesMatch = true;
+            pool.forEach([&](size_t index, Record& r) {
+                indicesMatch = indicesMatch && r.id == index;
+                ++visited;
+            });
+            ASSERT_EQ(visited, 3u);
+            ASSERT_TRUE(indicesMatch);
+            // The free list survived too: 5 slots left, then full
+            for (int i = 0; i < 5; ++i) pool.acquire(Record{100, 0.0, ""});
+            ASSERT_TRUE(pool.try_acquire(Record{}) == nullptr);
+            for (size_t i = 0; i < 8; ++i) {
+                if (pool.at(i) && pool.at(i)->id == 100) pool.release(i);
+            }
+        }
+
+        // Header checks refuse a different capacity, user version or type
+        {
+            PersistentPool<Record> pool;
+            bool threw = false;
+            try { pool.open(path, 16); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+            threw = false;
+            try { pool.open(path, 8, 2); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+            PersistentPool<uint64_t> wrongType;
+            threw = false;
+            try { wrongType.open(path, 8); } catch (const std::runtime_error&) { threw = true; }
+            ASSERT_TRUE(threw);
+            ASSERT_TRUE(!pool.isOpen());
+        }
+
+        // A process that dies with the file open: the free list is rebuilt
+        const pid_t child = ::fork();
+        if (child == 0) {
+            PersistentPool<Record> pool;
+            pool.open(path, 8);
+            pool.acquire(Record{7, 7.0, "crash"});
+            pool.release(kept[0]);
+            ::_exit(0);
+        }
+        ::waitpid(child, &status, 0);
+        ASSERT_TRUE(WIFEXITED(status));
+        {
+            PersistentPool<Record> pool;
+            ASSERT_TRUE(pool.open(path, 8) == PersistentPool<Record>::OpenResult::Recovered);
+            ASSERT_EQ(pool.usedCount(), 3u);
+            ASSERT_EQ(pool.availableCount(), 5u);
+            ASSERT_TRUE(!pool.contains(kept[0]));
+            size_t crashed = 0;
+            pool.forEach([&](size_t, Record& r) { crashed += r.id == 7; });
+            ASSERT_EQ(crashed, 1u);
+            pool.sync();
+        }
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "../../test_utils.hpp"
+#include "data_structures/pool.hpp"
+#include "networking/message.hpp"
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace {
+
+struct Counted {
+    static int constructions;
+    static int destructions;
+    static int resets;
+    std::vector<int> items;
+    int tag;
+
+    explicit Counted(int t = 0) : tag(t) { ++constructions; }
+    ~Counted() { ++destructions; }
+    void reset() { items.clear(); tag = 0; ++resets; }
+    void reset(int t) {
+        if (t < 0) throw std::runtime_error("negative tag");
+        reset();
+        tag = t;
+    }
+};
+
+int Counted::constructions = 0;
+int Counted::destructions = 0;
+int Counted::resets = 0;
+
+}
+
+// ReleasePolicy::Reset keeps objects (and the capacity they own) alive
+// across release/acquire cycles and calls reset() instead of ~TType().
+extern "C" int pool_reset_policy_test(void) {
+    try {
+        Pool<Counted> pool;
+        pool.resize(2);
+        ASSERT_TRUE(pool.releasePolicy() == Pool<Counted>::ReleasePolicy::Destroy);
+        pool.setReleasePolicy(Pool<Counted>::ReleasePolicy::Reset);
+
+        Pool<Counted>::Object& first = pool.acquire(7);
+        first->items.assign(1000, 1);
+        const int* storage = first->items.data();
+        pool.release(first);
+        ASSERT_EQ(Counted::destructions, 0);
+        ASSERT_EQ(Counted::resets, 1);
+        ASSERT_TRUE(first.isConstructed());
+
+        // Same slot, same heap block: reset(int) re-initializes in place
+        Pool<Counted>::Object& second = pool.acquire(9);
+        ASSERT_TRUE(&second == &first);
+        ASSERT_EQ(second->tag, 9);
+        ASSERT_TRUE(second->items.empty());
+        second->items.assign(1000, 2);
+        ASSERT_TRUE(second->items.data() == storage);
+        ASSERT_EQ(Counted::constructions, 1);
+        pool.release(second);
+
+        // A throwing reset(args) destroys the warm object and leaves the slot free
+        bool threw = false;
+        try { pool.acquire(-1); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(pool.usedCount(), 0u);
+        ASSERT_EQ(Counted::destructions, 1);
+
+        // Batches reuse warm objects too
+        std::vector<Pool<Counted>::Object*> batch(2);
+        pool.acquireN(batch);
+        pool.releaseN(batch);
+        ASSERT_EQ(Counted::constructions, 3);
+
+        // Back to Destroy: warm free objects are destroyed right away
+        pool.setReleasePolicy(Pool<Counted>::ReleasePolicy::Destroy);
+        ASSERT_EQ(Counted::destructions, Counted::constructions);
+
+        // Types without reset() cannot use the policy
+        Pool<std::string> strings;
+        threw = false;
+        try { strings.setReleasePolicy(Pool<std::string>::ReleasePolicy::Reset); } catch (const std::invalid_argument&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        // Message::reset() keeps the payload's heap capacity
+        Pool<Message> messages;
+        messages.resize(1);
+        messages.setReleasePolicy(Pool<Message>::ReleasePolicy::Reset);
+        Pool<Message>::Object& msg = messages.acquire(1);
+        std::vector<uint8_t> big(4096, 0xab);
+        msg->payload().write(big.data(), big.size());
+        msg->setByteOrder(DataBuffer::ByteOrder::Big);
+        const size_t capacity = msg->payload().capacity();
+        messages.release(msg);
+        Pool<Message>::Object& reused = messages.acquire(2);
+        ASSERT_EQ(reused->type(), 2);
+        ASSERT_EQ(reused->payload().size(), 0u);
+        ASSERT_EQ(reused->payload().capacity(), capacity);
+        ASSERT_TRUE(reused->byteOrder() == DataBuffer::ByteOrder::Host);
+        messages.release(reused);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
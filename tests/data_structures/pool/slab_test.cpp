@@ -0,0 +1,70 @@
+#include "../../test_utils.hpp"
+#include "data_structures/pool.hpp"
+#include <string>
+#include <cstdint>
+
+namespace {
+
+struct alignas(128) Wide {
+    Wide(int v) : value(v) {}
+    int value;
+};
+
+}
+
+// Slots are carved from one aligned slab, in index order, for both backings.
+extern "C" int pool_slab_test(void) {
+    try {
+        Pool<std::string> strings;
+        strings.resize(8);
+        ASSERT_TRUE(strings.slabBacking() == Pool<std::string>::SlabBacking::Heap);
+        auto& a = strings.acquire("first");
+        auto& b = strings.acquire("second");
+        // consecutive slots, fixed stride
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(b.object) - reinterpret_cast<uintptr_t>(a.object), sizeof(std::string));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(a.object) % 64, 0u);
+        ASSERT_EQ(*b, "second");
+        strings.release(a);
+        strings.release(b);
+
+        // Over-aligned types keep their alignment in every slot
+        Pool<Wide> wide;
+        wide.resize(5);
+        for (int i = 0; i < 5; ++i) {
+            auto& w = wide.acquire(i);
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(w.object) % alignof(Wide), 0u);
+            ASSERT_EQ(w->value, i);
+        }
+        ASSERT_EQ(wide.availableCount(), 0u);
+
+        // Mapped slab: usable, survives a move, and releases cleanly
+        Pool<uint64_t> mapped;
+        mapped.resize(100000, Pool<uint64_t>::SlabBacking::HugePages);
+        ASSERT_EQ(mapped.capacity(), 100000u);
+        auto& first = mapped.acquire(uint64_t(7));
+        Pool<uint64_t> moved(std::move(mapped));
+        ASSERT_EQ(mapped.capacity(), 0u);
+        ASSERT_EQ(*first, 7u);
+        ASSERT_EQ(moved.usedCount(), 1u);
+        moved.release(first);
+        for (size_t i = 0; i < 100000; ++i) {
+            moved.acquire(uint64_t(i));
+        }
+        ASSERT_EQ(moved.availableCount(), 0u);
+
+        // Resizing replaces the slab; a failed resize leaves the pool intact
+        moved.resize(3);
+        ASSERT_EQ(moved.capacity(), 3u);
+        bool threw = false;
+        try {
+            moved.resize(0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+        ASSERT_EQ(moved.capacity(), 3u);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
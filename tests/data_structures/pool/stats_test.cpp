@@ -0,0 +1,120 @@
+// Pool::stats() only exists in instrumented builds: run with 'make tests-stats'
+// (POOL_STATS=1 compiles the library and every test with LIBFTPP_POOL_STATS).
+#include "../../test_utils.hpp"
+#include "data_structures/pool.hpp"
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+#include <utility>
+
+#ifdef LIBFTPP_POOL_STATS
+namespace {
+
+struct Tracked {
+    int value;
+    explicit Tracked(int v = 0) : value(v) {
+        if (v < 0) throw std::runtime_error("negative");
+    }
+};
+
+struct Leaky {
+    int value;
+};
+
+}
+#endif
+
+// Counters, histograms, lifetimes and the leak report of an instrumented Pool.
+extern "C" int pool_stats_test(void) {
+#ifdef LIBFTPP_POOL_STATS
+    try {
+        PoolLatencyHistogram histogram;
+        ASSERT_EQ(histogram.percentile(0.5), 0u);
+        for (uint64_t ns : {0u, 1u, 3u, 100u, 100u, 100u, 5000u}) histogram.record(ns);
+        ASSERT_EQ(histogram.count(), 7u);
+        ASSERT_EQ(histogram.bucket(0), 2u);
+        ASSERT_EQ(histogram.bucket(6), 3u);
+        ASSERT_EQ(histogram.percentile(0.5), 128u);
+        ASSERT_EQ(histogram.percentile(1.0), 8192u);
+
+        Pool<Tracked> pool;
+        pool.resize(2);
+        Pool<Tracked>::Object& a = pool.acquire(1);
+        Pool<Tracked>::Object* b = pool.try_acquire(2);
+        ASSERT_TRUE(b != nullptr);
+        ASSERT_TRUE(pool.try_acquire(3) == nullptr);
+        bool threw = false;
+        try { pool.acquire(4); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        pool.release(a);
+        threw = false;
+        try { pool.acquire(-1); } catch (const std::runtime_error&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        PoolStats stats = pool.stats();
+        ASSERT_EQ(stats.used, 1u);
+        ASSERT_EQ(stats.peak, 2u);
+        ASSERT_EQ(stats.capacity, 2u);
+        ASSERT_EQ(stats.acquires, 2u);
+        ASSERT_EQ(stats.releases, 1u);
+        ASSERT_EQ(stats.failedAcquires, 3u);
+        ASSERT_EQ(stats.acquireLatency.count(), 2u);
+        ASSERT_EQ(stats.releaseLatency.count(), 1u);
+        ASSERT_TRUE(stats.averageLifetimeNs() >= 2e6);
+        ASSERT_TRUE(stats.toString().find("failed acquires 3") != std::string::npos);
+
+        // Batches count every object but one latency sample per call
+        std::vector<Pool<Tracked>::Object*> one(1);
+        pool.acquireN(one);
+        ASSERT_EQ(pool.stats().acquires, 3u);
+        ASSERT_EQ(pool.stats().acquireLatency.count(), 3u);
+
+        // Outstanding objects are listed, with their call site in debug builds
+        std::string report = pool.leakReport();
+        ASSERT_TRUE(report.find("2 object(s) still acquired") != std::string::npos);
+#ifndef NDEBUG
+        ASSERT_TRUE(report.find("acquired from 0x") != std::string::npos);
+#endif
+        pool.releaseN(one);
+        pool.release(*b);
+        ASSERT_TRUE(pool.leakReport().empty());
+
+        // The counters move with the slabs
+        Pool<Tracked> moved(std::move(pool));
+        ASSERT_EQ(moved.stats().acquires, 3u);
+        ASSERT_EQ(moved.stats().releases, 3u);
+        ASSERT_EQ(moved.stats().failedAcquires, 3u);
+        ASSERT_EQ(pool.stats().acquires, 0u);
+        ASSERT_EQ(pool.stats().acquireLatency.count(), 0u);
+        pool = std::move(moved);
+        ASSERT_EQ(pool.stats().acquires, 3u);
+        ASSERT_EQ(pool.stats().releaseLatency.count(), 3u);
+        ASSERT_EQ(moved.stats().releases, 0u);
+
+        pool.resetStats();
+        ASSERT_EQ(pool.stats().acquires, 0u);
+        ASSERT_EQ(pool.stats().peak, 2u);
+
+        // Handles and Ids report the user's call site, not the pool's
+        Pool<Leaky> leaky;
+        leaky.resize(2);
+        auto handle = leaky.acquireHandle(Leaky{7});
+        leaky.acquireId(Leaky{8});
+        ASSERT_EQ(leaky.stats().acquires, 2u);
+#ifndef NDEBUG
+        for (auto* obj : leaky.liveObjects()) {
+            ASSERT_TRUE(obj->acquiredFrom != nullptr);
+        }
+#endif
+        handle.release();
+        // `leaky` still holds one object: its destructor prints the leak report
+    } catch (...) {
+        return 255;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "../../test_utils.hpp"
+#include "data_structures/ring_buffer.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// FIFO order across the wrap point, growth that keeps the queued bytes,
+// and iovec views of both the queued data and the free space.
+extern "C" int ring_buffer_test(void) {
+    try {
+        RingBuffer ring;
+        ASSERT_EQ(ring.capacity(), 0u);
+        ASSERT_TRUE(ring.empty());
+        iovec iov[2];
+        ASSERT_EQ(ring.readable(iov), 0u);
+
+        ring.reserve(100);
+        const size_t capacity = ring.capacity();
+        ASSERT_EQ(capacity, 128u);
+
+        // Move the head forward so the next write wraps
+        std::vector<uint8_t> filler(100, 0xAA);
+        ring.write(filler.data(), filler.size());
+        ring.consume(90);
+        std::vector<uint8_t> data(80);
+        for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i);
+        ring.write(data.data(), data.size());
+        ASSERT_EQ(ring.capacity(), capacity);
+        ASSERT_EQ(ring.size(), 90u);
+        ASSERT_EQ(ring.readable(iov), 2u);
+        ASSERT_EQ(iov[0].iov_len + iov[1].iov_len, 90u);
+
+        uint8_t skipped[10];
+        ring.read(skipped, sizeof(skipped));
+        ASSERT_EQ(skipped[9], 0xAA);
+        uint8_t peeked[4];
+        ring.peek(peeked, sizeof(peeked), 30);
+        ASSERT_EQ(peeked[0], 30);
+        // In-place access only for ranges that do not wrap
+        const uint8_t* inPlace = ring.contiguous(0, 20);
+        ASSERT_TRUE(inPlace != nullptr);
+        ASSERT_EQ(inPlace[0], 0);
+        ASSERT_TRUE(ring.contiguous(0, 80) == nullptr);
+        ASSERT_TRUE(ring.contiguous(70, 11) == nullptr);
+        ASSERT_EQ(ring.size(), 80u);
+
+        // Growing while wrapped linearizes without reordering
+        std::vector<uint8_t> more(200, 0x55);
+        ring.write(more.data(), more.size());
+        ASSERT_EQ(ring.capacity(), 512u);
+        ASSERT_EQ(ring.readable(iov), 1u);
+        std::vector<uint8_t> back(80);
+        ring.read(back.data(), back.size());
+        ASSERT_TRUE(back == data);
+        ASSERT_EQ(ring.size(), 200u);
+
+        // Free space, filled in place then committed
+        const size_t pieces = ring.writable(iov, 16);
+        ASSERT_TRUE(pieces >= 1);
+        ASSERT_EQ(iov[0].iov_len + (pieces == 2 ? iov[1].iov_len : 0), ring.capacity() - ring.size());
+        std::memset(iov[0].iov_base, 0x77, 16);
+        ring.commit(16);
+        ring.consume(200);
+        uint8_t tail[16];
+        ring.read(tail, sizeof(tail));
+        ASSERT_EQ(tail[15], 0x77);
+        ASSERT_TRUE(ring.empty());
+
+        bool threw = false;
+        try { ring.consume(1); } catch (const std::out_of_range&) { threw = true; }
+        ASSERT_TRUE(threw);
+
+        // Room for a record whose start is queued near the end of the array
+        RingBuffer record(128);
+        std::vector<uint8_t> head(100, 0x11);
+        record.write(head.data(), head.size());
+        record.consume(90);
+        record.makeContiguous(60);
+        ASSERT_EQ(record.capacity(), 128u);
+        ASSERT_TRUE(record.contiguous(0, 10) != nullptr);
+        ASSERT_EQ(record.writable(iov, 50), 1u);
+        ASSERT_TRUE(static_cast<uint8_t*>(iov[0].iov_base) == record.contiguous(0, 10) + 10);
+        std::memset(iov[0].iov_base, 0x22, 50);
+        record.commit(50);
+        const uint8_t* whole = record.contiguous(0, 60);
+        ASSERT_TRUE(whole != nullptr);
+        ASSERT_EQ(whole[9], 0x11);
+        ASSERT_EQ(whole[59], 0x22);
+        // queued bytes already split by the wrap point are relocated
+        record.consume(50);
+        record.write(head.data(), 100);
+        ASSERT_TRUE(record.contiguous(0, 110) == nullptr);
+        record.makeContiguous(120);
+        ASSERT_EQ(record.capacity(), 128u);
+        ASSERT_TRUE(record.contiguous(0, 110) != nullptr);
+        record.makeContiguous(200);
+        ASSERT_EQ(record.capacity(), 256u);
+        ASSERT_EQ(record.size(), 110u);
+
+        RingBuffer moved(std::move(ring));
+        ASSERT_EQ(ring.capacity(), 0u);
+        moved.shrink();
+        ASSERT_EQ(moved.capacity(), 0u);
+    } catch (...) {
+        return 255;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "../../test_utils.hpp"
+#include "data_structures/segmented_buffer.hpp"
+#include <string>
+#include <vector>
+
+// Written bytes never move, segments come from the pool first and the
+// iovec export covers exactly the written data.
+extern "C" int segmented_buffer_test(void) {
+    try {
+        SegmentedBuffer::SegmentPool segments;
+        segments.resize(2);
+
+        std::vector<uint8_t> blob(SegmentedBuffer::SEGMENT_SIZE * 3 + 123);
+        for (size_t i = 0; i < blob.size(); ++i) blob[i] = static_cast<uint8_t>(i * 31);
+
+        {
+            SegmentedBuffer buf(segments);
+            buf << uint32_t(7) << std::string("header");
+            std::vector<iovec> first = buf.iovecs();
+            ASSERT_EQ(first.size(), 1u);
+            const void* firstSegment = first[0].iov_base;
+
+            buf.write(blob.data(), blob.size());
+            ASSERT_EQ(buf.size(), sizeof(uint32_t) + sizeof(size_t) + 6 + blob.size());
+            ASSERT_EQ(buf.segmentCount(), 4u);
+            // both pool slots are in use, the rest spilled to the heap
+            ASSERT_EQ(segments.availableCount(), 0u);
+
+            std::vector<iovec> iov = buf.iovecs();
+            ASSERT_EQ(iov.size(), 4u);
+            ASSERT_TRUE(iov[0].iov_base == firstSegment);
+            size_t total = 0;
+            for (const auto& v : iov) total += v.iov_len;
+            ASSERT_EQ(total, buf.size());
+
+            uint32_t head = 0;
+            std::string name;
+            buf >> head >> name;
+            ASSERT_EQ(head, 7u);
+            ASSERT_EQ(name, "header");
+            std::vector<uint8_t> back(blob.size());
+            buf.read(back.data(), back.size());
+            ASSERT_TRUE(back == blob);
+
+            bool threw = false;
+            try {
+                uint8_t extra;
+                buf >> extra;
+            } catch (const std::out_of_range&) {
+                threw = true;
+            }
+            ASSERT_TRUE(threw);
+
+            DataBuffer flat;
+            buf.copyTo(flat);
+            ASSERT_EQ(flat.size(), buf.size());
+
+            SegmentedBuffer moved = std::move(buf);
+            ASSERT_EQ(moved.size(), flat.size());
+            ASSERT_EQ(buf.size(), 0u);
+        }
+        // destroying the buffer hands the segments back to the pool
+        ASSERT_EQ(segments.availableCount(), 2u);
+        return 0;
+    } catch (...) {
+        return 255;
+    }
+}
@@ -0,0 +1,116 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include "networking/socket_io.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+namespace {
+
+// Read one frame carrying a uint32_t payload; false on error or timeout
+bool read_u32_frame(int fd, int32_t& type, uint32_t& value) {
+    uint8_t frame[FRAME_HEADER_SIZE + sizeof(uint32_t)];
+    size_t got = 0;
+    while (got < sizeof(frame)) {
+        ssize_t r = ::recv(fd, frame + got, sizeof(frame) - got, 0);
+        if (r <= 0) return false;
+        got += static_cast<size_t>(r);
+    }
+    int32_t netType;
+    std::memcpy(&netType, frame + 4, 4);
+    type = static_cast<int32_t>(ntohl(static_cast<uint32_t>(netType)));
+    std::memcpy(&value, frame + FRAME_HEADER_SIZE, sizeof(value));
+    return true;
+}
+
+std::vector<Message> numbered(Message::Type type, uint32_t first, uint32_t count) {
+    std::vector<Message> messages;
+    for (uint32_t i = 0; i < count; ++i) {
+        messages.emplace_back(type);
+        messages.back() << (first + i);
+    }
+    return messages;
+}
+
+}
+
+// Batched sends on both sides keep frame order; TCP options per connection.
+extern "C" int batch_send_test(void) {
+    Server srv;
+    srv.setDefaultNoDelay(true);
+    ASSERT_TRUE(srv.defaultNoDelay());
+    std::mutex lock;
+    std::vector<uint32_t> received;
+    // A burst of requests answered from the loop: the replies of one read
+    // are flushed together
+    srv.defineAction(1, [&](Server::ClientID id, const Message &m) {
+        uint32_t value = 0;
+        std::memcpy(&value, m.payload().data(), sizeof(value));
+        {
+            std::lock_guard<std::mutex> lg(lock);
+            received.push_back(value);
+        }
+        Message reply(2);
+        reply << value;
+        srv.sendTo(reply, id);
+    });
+    srv.defineAction(3, [&srv](Server::ClientID id, const Message &) {
+        srv.sendBatchTo(numbered(4, 1000, 50), id);
+    });
+    srv.start(0);
+
+    Client c;
+    c.setNoDelay(true);
+    std::atomic<uint32_t> replies{0};
+    std::atomic<bool> ordered{true};
+    c.defineAction(2, [&](const Message &m) {
+        uint32_t value = 0;
+        std::memcpy(&value, m.payload().data(), sizeof(value));
+        if (value != replies.load()) ordered = false;
+        ++replies;
+    });
+    c.connect("127.0.0.1", srv.getPort());
+    c.sendBatch(numbered(1, 0, 200));
+    ASSERT_TRUE(wait_for([&] { c.update(); return replies.load() == 200; }));
+    ASSERT_TRUE(ordered.load());
+    {
+        std::lock_guard<std::mutex> lg(lock);
+        ASSERT_EQ(received.size(), 200u);
+        for (uint32_t i = 0; i < 200; ++i) ASSERT_EQ(received[i], i);
+    }
+    c.disconnect();
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 0; }));
+
+    // Server batch behind a cork, pushed out by uncorking
+    int fd = connect_raw(srv.getPort());
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 1; }));
+    const Server::ClientID id = 2; // the Client above was 1
+    ASSERT_EQ(srv.ownerLoop(id), 0);
+    ASSERT_TRUE(srv.setClientNoDelay(id, false));
+    ASSERT_TRUE(srv.setClientCork(id, true));
+    uint8_t request[FRAME_HEADER_SIZE];
+    encode_frame_header(request, 3, 0);
+    ASSERT_EQ(::send(fd, request, sizeof(request), 0), static_cast<ssize_t>(sizeof(request)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(srv.setClientCork(id, false));
+    for (uint32_t i = 0; i < 50; ++i) {
+        int32_t type = 0;
+        uint32_t value = 0;
+        ASSERT_TRUE(read_u32_frame(fd, type, value));
+        ASSERT_EQ(type, 4);
+        ASSERT_EQ(value, 1000 + i);
+    }
+    ::close(fd);
+
+    ASSERT_TRUE(!srv.setClientCork(12345, true));
+    ASSERT_TRUE(!srv.setClientNoDelay(12345, true));
+    srv.stop();
+    return 0;
+}
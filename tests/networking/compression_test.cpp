@@ -0,0 +1,146 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include "networking/socket_io.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+bool roundTrips(const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> block(lz_compress_bound(input.size()));
+    const size_t packed = lz_compress(input.data(), input.size(), block.data(), block.size());
+    if (packed == 0) return false;
+    std::vector<uint8_t> output(input.size());
+    lz_decompress(block.data(), packed, output.data(), output.size());
+    return output == input;
+}
+
+// Repetitive state dump: entity records that differ in a few fields
+std::vector<uint8_t> stateDump(size_t entities) {
+    DataBuffer buf;
+    for (size_t i = 0; i < entities; ++i) {
+        buf << uint32_t(i) << float(i % 16) << float(0) << float(1.5f) << std::string("npc_guard") << uint8_t(i & 1);
+    }
+    return std::vector<uint8_t>(buf.data(), buf.data() + buf.size());
+}
+
+}
+
+// Block round trips, rejection of corrupt blocks, the frame flag on the
+// wire, and transparent decompression on both Client and Server.
+extern "C" int compression_test(void) {
+    using namespace std::chrono_literals;
+
+    // Edge cases and typical inputs
+    uint32_t seed = 12345;
+    std::vector<uint8_t> noise(5000);
+    for (auto& b : noise) { seed = seed * 1103515245u + 12345u; b = static_cast<uint8_t>(seed >> 24); }
+    ASSERT_TRUE(roundTrips({}));
+    ASSERT_TRUE(roundTrips({42}));
+    ASSERT_TRUE(roundTrips(std::vector<uint8_t>(13, 'a')));
+    ASSERT_TRUE(roundTrips(std::vector<uint8_t>(100000, 0)));
+    ASSERT_TRUE(roundTrips(noise));
+    const std::vector<uint8_t> dump = stateDump(4000);
+    ASSERT_TRUE(roundTrips(dump));
+
+    std::vector<uint8_t> block(lz_compress_bound(dump.size()));
+    const size_t packed = lz_compress(dump.data(), dump.size(), block.data(), block.size());
+    ASSERT_TRUE(packed * 4 < dump.size());
+    ASSERT_EQ(lz_compress(dump.data(), dump.size(), block.data(), 16), 0u);
+
+    // Truncated block, wrong size and a bogus offset are rejected
+    std::vector<uint8_t> out(dump.size());
+    bool threw = false;
+    try { lz_decompress(block.data(), packed / 2, out.data(), out.size()); } catch (const std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+    threw = false;
+    try { lz_decompress(block.data(), packed, out.data(), out.size() - 1); } catch (const std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+    const uint8_t badOffset[] = {0x10, 'x', 0xFF, 0x00, 0x00};
+    threw = false;
+    try { lz_decompress(badOffset, sizeof(badOffset), out.data(), 10); } catch (const std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+
+    // The frame carries the flag and a smaller body; it decodes into a DataBuffer
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    Message big(9);
+    big.payload().write(dump.data(), dump.size());
+    std::thread writer([&] { send_message_frame(fds[0], big, 1024); });
+    uint8_t header[FRAME_HEADER_SIZE];
+    ASSERT_EQ(::recv(fds[1], header, sizeof(header), MSG_WAITALL), static_cast<ssize_t>(sizeof(header)));
+    uint32_t len = 0;
+    std::memcpy(&len, header, sizeof(len));
+    len = ntohl(len);
+    ASSERT_TRUE((len & FRAME_COMPRESSED_FLAG) != 0);
+    const size_t body = (len & ~FRAME_COMPRESSED_FLAG) - 4;
+    ASSERT_TRUE(body < dump.size());
+    std::vector<uint8_t> wire(body);
+    ASSERT_EQ(::recv(fds[1], wire.data(), body, MSG_WAITALL), static_cast<ssize_t>(body));
+    writer.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+    DataBuffer decoded;
+    decoded << uint8_t(7);
+    decompress_frame_payload(wire.data(), wire.size(), MAX_FRAME_SIZE, decoded);
+    ASSERT_EQ(decoded.size(), dump.size() + 1);
+    ASSERT_TRUE(std::memcmp(decoded.data() + 1, dump.data(), dump.size()) == 0);
+
+    // A length that would reach the compression flag is refused, even
+    // when the payload would compress below the cap
+    threw = false;
+    try { encode_frame_header(header, 1, MAX_FRAME_SIZE); } catch (const std::length_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+    encode_frame_header(header, 1, MAX_FRAME_SIZE - sizeof(int32_t));
+    Message huge(1);
+    std::memset(huge.payload().extend(MAX_FRAME_SIZE).data(), 0, MAX_FRAME_SIZE);
+    threw = false;
+    try {
+        std::unique_ptr<uint8_t[]> scratch;
+        iovec iov[2];
+        frame_message(huge, 1024, header, scratch, iov);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // Both directions through a real connection
+    Server srv;
+    srv.setCompressionThreshold(1024);
+    std::atomic<bool> serverOk{false};
+    srv.defineAction(9, [&](Server::ClientID id, const Message& m) {
+        serverOk = m.payload().size() == dump.size()
+            && std::memcmp(m.payload().data(), dump.data(), dump.size()) == 0;
+        Message echo(10);
+        echo.payload().write(m.payload().data(), m.payload().size());
+        srv.sendTo(echo, id);
+    });
+    srv.start(0);
+
+    Client c;
+    c.setCompressionThreshold(1024);
+    ASSERT_EQ(c.compressionThreshold(), 1024u);
+    std::atomic<bool> echoed{false};
+    c.defineAction(10, [&](const Message& m) {
+        echoed = m.payload().size() == dump.size()
+            && std::memcmp(m.payload().data(), dump.data(), dump.size()) == 0;
+    });
+    c.connect("127.0.0.1", srv.getPort());
+    c.send(big);
+    for (int i = 0; i < 100 && !echoed.load(); ++i) {
+        std::this_thread::sleep_for(20ms);
+        c.update();
+    }
+    srv.stop();
+    c.disconnect();
+    ASSERT_TRUE(serverOk.load());
+    ASSERT_TRUE(echoed.load());
+    return 0;
+}
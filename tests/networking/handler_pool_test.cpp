@@ -0,0 +1,216 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include "networking/socket_io.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+namespace {
+
+// Send `count` frames of `type` carrying 0, 1, ... count - 1
+bool send_sequence(int fd, int32_t type, uint32_t count) {
+    std::vector<uint8_t> out;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t frame[FRAME_HEADER_SIZE + sizeof(uint32_t)];
+        encode_frame_header(frame, type, sizeof(uint32_t));
+        std::memcpy(frame + FRAME_HEADER_SIZE, &i, sizeof(i));
+        out.insert(out.end(), frame, frame + sizeof(frame));
+    }
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t w = ::send(fd, out.data() + sent, out.size() - sent, 0);
+        if (w <= 0) return false;
+        sent += static_cast<size_t>(w);
+    }
+    return true;
+}
+
+bool read_frame_type(int fd, int32_t& type) {
+    uint8_t frame[FRAME_HEADER_SIZE];
+    size_t got = 0;
+    while (got < sizeof(frame)) {
+        ssize_t r = ::recv(fd, frame + got, sizeof(frame) - got, 0);
+        if (r <= 0) return false;
+        got += static_cast<size_t>(r);
+    }
+    int32_t netType;
+    std::memcpy(&netType, frame + 4, 4);
+    type = static_cast<int32_t>(ntohl(static_cast<uint32_t>(netType)));
+    return true;
+}
+
+// Each client's messages arrive in order although 4 workers run handlers
+int per_client_order() {
+    constexpr int clients = 8;
+    constexpr uint32_t perClient = 500;
+    Server srv;
+    srv.setHandlerThreads(4);
+    std::mutex lock;
+    std::map<Server::ClientID, uint32_t> next;
+    std::atomic<uint32_t> handled{0};
+    std::atomic<bool> ordered{true};
+    srv.defineAction(1, [&](Server::ClientID id, const Message &m) {
+        uint32_t value = 0;
+        std::memcpy(&value, m.payload().data(), sizeof(value));
+        {
+            std::lock_guard<std::mutex> lg(lock);
+            if (next[id] != value) ordered = false;
+            next[id] = value + 1;
+        }
+        ++handled;
+    });
+    srv.start(0);
+    ASSERT_EQ(srv.handlerThreads(), 4u);
+
+    std::vector<int> fds;
+    for (int i = 0; i < clients; ++i) {
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        fds.push_back(fd);
+    }
+    for (int fd : fds) ASSERT_TRUE(send_sequence(fd, 1, perClient));
+    ASSERT_TRUE(wait_for([&] { return handled.load() == clients * perClient; }));
+    ASSERT_TRUE(ordered.load());
+    ASSERT_EQ(srv.pendingHandlers(), 0u);
+    for (int fd : fds) ::close(fd);
+    srv.stop();
+    return 0;
+}
+
+// A client whose handler blocks does not hold up another client's replies
+int slow_handler_isolated() {
+    Server srv;
+    srv.setHandlerThreads(2);
+    std::atomic<bool> release{false};
+    srv.defineAction(1, [&](Server::ClientID, const Message &) {
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    srv.defineAction(2, [&srv](Server::ClientID id, const Message &) {
+        srv.sendTo(Message(3), id);
+    });
+    srv.start(0);
+
+    int slow = connect_raw(srv.getPort());
+    int fast = connect_raw(srv.getPort());
+    ASSERT_TRUE(slow >= 0 && fast >= 0);
+    ASSERT_TRUE(send_sequence(slow, 1, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(send_sequence(fast, 2, 1));
+    int32_t type = 0;
+    ASSERT_TRUE(read_frame_type(fast, type));
+    ASSERT_EQ(type, 3);
+    release = true;
+    ::close(slow);
+    ::close(fast);
+    srv.stop();
+    return 0;
+}
+
+// A tiny queue pauses reads, then resumes them without losing messages
+int backpressure_resumes() {
+    constexpr uint32_t total = 2000;
+    Server srv;
+    srv.setHandlerThreads(1, 8);
+    std::atomic<uint32_t> handled{0};
+    std::atomic<bool> ordered{true};
+    std::atomic<size_t> maxPending{0};
+    srv.defineAction(1, [&](Server::ClientID, const Message &m) {
+        uint32_t value = 0;
+        std::memcpy(&value, m.payload().data(), sizeof(value));
+        if (value != handled.load()) ordered = false;
+        size_t pending = srv.pendingHandlers();
+        if (pending > maxPending.load()) maxPending = pending;
+        if (value % 64 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++handled;
+    });
+    srv.start(0);
+
+    int fd = connect_raw(srv.getPort());
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_TRUE(send_sequence(fd, 1, total));
+    ASSERT_TRUE(wait_for([&] { return handled.load() == total; }));
+    ASSERT_TRUE(ordered.load());
+    // Parsing stops at capacity: the bound is exact
+    ASSERT_TRUE(maxPending.load() <= 8);
+    ::close(fd);
+    srv.stop();
+    return 0;
+}
+
+// With room for one message, frames already read wait in the receive
+// buffer and are served on resume even though the socket stays silent;
+// large frames are still read in large pieces, not a few bytes per slot
+int buffered_frames_resume() {
+    constexpr uint32_t small = 50;
+    constexpr uint32_t large = 24;
+    constexpr size_t largePayload = 128 * 1024;
+    Server srv;
+    srv.setHandlerThreads(1, 1);
+    std::atomic<uint32_t> handled{0};
+    std::atomic<bool> ordered{true};
+    srv.defineAction(1, [&](Server::ClientID, const Message &m) {
+        uint32_t value = 0;
+        std::memcpy(&value, m.payload().data(), sizeof(value));
+        if (value != handled.load()) ordered = false;
+        ++handled;
+    });
+    srv.defineAction(2, [&](Server::ClientID, const Message &m) {
+        uint32_t value = 0;
+        std::memcpy(&value, m.payload().data(), sizeof(value));
+        if (value != handled.load() - small || m.payload().size() != largePayload) ordered = false;
+        ++handled;
+    });
+    srv.start(0);
+
+    int fd = connect_raw(srv.getPort());
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_TRUE(send_sequence(fd, 1, small));
+    ASSERT_TRUE(wait_for([&] { return handled.load() == small; }));
+
+    std::vector<uint8_t> out;
+    for (uint32_t i = 0; i < large; ++i) {
+        uint8_t header[FRAME_HEADER_SIZE];
+        encode_frame_header(header, 2, largePayload);
+        out.insert(out.end(), header, header + sizeof(header));
+        const size_t at = out.size();
+        out.resize(at + largePayload);
+        std::memcpy(out.data() + at, &i, sizeof(i));
+    }
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t w = ::send(fd, out.data() + sent, out.size() - sent, 0);
+        if (w <= 0) break;
+        sent += static_cast<size_t>(w);
+    }
+    ASSERT_EQ(sent, out.size());
+    const bool done = wait_for([&] { return handled.load() == small + large; });
+    ::close(fd);
+    srv.stop();
+    ASSERT_TRUE(done);
+    ASSERT_TRUE(ordered.load());
+    return 0;
+}
+
+}
+
+// Server handlers on a worker pool: per-client order, isolation, backpressure.
+extern "C" int handler_pool_test(void) {
+    if (per_client_order() != 0) return 255;
+    if (slow_handler_isolated() != 0) return 255;
+    if (backpressure_resumes() != 0) return 255;
+    if (buffered_frames_resume() != 0) return 255;
+
+    Server srv;
+    bool threw = false;
+    try { srv.setHandlerThreads(2, 0); } catch (const std::invalid_argument &) { threw = true; }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(srv.handlerThreads(), 0u);
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+
+namespace {
+
+struct Move {
+    uint32_t entity;
+    float x;
+    float y;
+    float z;
+    std::string label;
+    uint8_t flags;
+    uint16_t seq;       // after uint8_t: padded, so this run is copied field by field
+    std::vector<int16_t> path;
+};
+
+using MoveSchema = MessageSchema<30, &Move::entity, &Move::x, &Move::y, &Move::z,
+                                 &Move::label, &Move::flags, &Move::seq, &Move::path>;
+
+static_assert(MoveSchema::fixedSize == 4 + 3 * 4 + 1 + 2, "fixed fields are summed at compile time");
+static_assert(std::is_same<MoveSchema::Struct, Move>::value, "struct is deduced from the members");
+
+}
+
+// Encode/decode round trip, wire compatibility with the manual << chain,
+// truncation detection and typed handlers over a real connection.
+extern "C" int message_schema_test(void) {
+    using namespace std::chrono_literals;
+
+    const Move move{42, 1.0f, -2.0f, 3.5f, "scout", 0x5, 513, {1, -1, 7}};
+    Message encoded = MoveSchema::encode(move);
+    ASSERT_EQ(encoded.type(), 30);
+    ASSERT_EQ(encoded.payload().size(), MoveSchema::encodedSize(move));
+
+    // same bytes as writing the fields by hand, counts in host order too
+    Message manual(30);
+    manual << move.entity << move.x << move.y << move.z << uint32_t(move.label.size());
+    manual.payload().write(move.label.data(), move.label.size());
+    manual << move.flags << move.seq << uint32_t(3);
+    manual.payload().write(move.path.data(), move.path.size() * sizeof(int16_t));
+    ASSERT_EQ(manual.payload().size(), encoded.payload().size());
+    ASSERT_TRUE(std::memcmp(manual.payload().data(), encoded.payload().data(), manual.payload().size()) == 0);
+
+    Move decoded = MoveSchema::decode(encoded);
+    ASSERT_EQ(decoded.entity, 42u);
+    ASSERT_EQ(decoded.z, 3.5f);
+    ASSERT_EQ(decoded.label, "scout");
+    ASSERT_EQ(decoded.flags, 0x5);
+    ASSERT_EQ(decoded.seq, 513);
+    ASSERT_TRUE(decoded.path == move.path);
+
+    // wrong type id and truncated payloads are rejected
+    bool threw = false;
+    try {
+        Message other(31);
+        MoveSchema::decode(other);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    threw = false;
+    try {
+        Message truncated(30);
+        truncated.payload().write(encoded.payload().data(), 10);
+        MoveSchema::decode(truncated);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // typed handlers on both ends
+    Server srv;
+    std::atomic<uint32_t> serverSeen{0};
+    srv.defineAction(MoveSchema::type, MoveSchema::serverHandler(
+        [&](Server::ClientID id, const Move& m) {
+            serverSeen = m.entity;
+            Move reply = m;
+            reply.label = "ack";
+            srv.sendTo(MoveSchema::encode(reply), id);
+        }));
+    srv.start(0);
+
+    Client c;
+    std::atomic<bool> acked{false};
+    c.defineAction(MoveSchema::type, MoveSchema::clientHandler([&](const Move& m) {
+        acked = (m.label == "ack" && m.path.size() == 3);
+    }));
+    c.connect("127.0.0.1", srv.getPort());
+    c.send(encoded);
+    for (int i = 0; i < 100 && !acked.load(); ++i) {
+        std::this_thread::sleep_for(20ms);
+        c.update();
+    }
+    srv.stop();
+    c.disconnect();
+    ASSERT_EQ(serverSeen.load(), 42u);
+    ASSERT_TRUE(acked.load());
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+
+extern "C" int message_view_test(void) {
+    Message m(3);
+    m << std::string("forwarded field") << int32_t(99);
+    const float coords[3] = {1.0f, 2.5f, -3.0f};
+    m.payload().write(coords, sizeof(coords));
+
+    std::string_view name = m.readStringView();
+    if (name != "forwarded field") { std::cout << "bad view: " << name << std::endl; return 255; }
+    ASSERT_EQ(m.pop<int32_t>(), 99);
+
+    ArrayView<float> xyz = m.readArray<float>(3);
+    ASSERT_EQ(xyz.size(), 3u);
+    ASSERT_EQ(xyz[1], 2.5f);
+
+    // readString() still returns an owning copy
+    Message copy(4);
+    copy << std::string("owned");
+    std::string owned = copy.popString();
+    ASSERT_EQ(owned, "owned");
+
+    // a length prefix larger than the payload is rejected
+    Message bad(5);
+    bad << uint32_t(htonl(1000)) << uint8_t('x');
+    bool threw = false;
+    try {
+        bad.readStringView();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // so is a length prefix cut short
+    Message cut(6);
+    cut << uint16_t(0);
+    threw = false;
+    try {
+        cut.readStringView();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include "networking/socket_io.hpp"
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+namespace {
+
+// Read one frame carrying a uint32_t payload; false on error or timeout
+bool read_u32_frame(int fd, int32_t& type, uint32_t& value) {
+    uint8_t frame[FRAME_HEADER_SIZE + sizeof(uint32_t)];
+    size_t got = 0;
+    while (got < sizeof(frame)) {
+        ssize_t r = ::recv(fd, frame + got, sizeof(frame) - got, 0);
+        if (r <= 0) return false;
+        got += static_cast<size_t>(r);
+    }
+    int32_t netType;
+    std::memcpy(&netType, frame + 4, 4);
+    type = static_cast<int32_t>(ntohl(static_cast<uint32_t>(netType)));
+    std::memcpy(&value, frame + FRAME_HEADER_SIZE, sizeof(value));
+    return true;
+}
+
+int run_with(Server::AcceptDistribution distribution) {
+    constexpr size_t loops = 4;
+    constexpr uint32_t clients = 40;
+    Server srv;
+    srv.setEventLoops(loops, distribution);
+    // Reply with the index of the loop that owns the sender
+    srv.defineAction(1, [&srv](Server::ClientID id, const Message &) {
+        Message reply(2);
+        reply << static_cast<uint32_t>(srv.ownerLoop(id));
+        srv.sendTo(reply, id);
+    });
+    srv.start(0);
+    ASSERT_EQ(srv.eventLoops(), loops);
+
+    std::vector<int> fds;
+    for (uint32_t i = 0; i < clients; ++i) {
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        fds.push_back(fd);
+    }
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == clients; }));
+
+    uint8_t request[FRAME_HEADER_SIZE];
+    encode_frame_header(request, 1, 0);
+    std::vector<size_t> perLoop(loops, 0);
+    for (int fd : fds) {
+        ASSERT_EQ(::send(fd, request, sizeof(request), 0), static_cast<ssize_t>(sizeof(request)));
+    }
+    for (int fd : fds) {
+        int32_t type = 0;
+        uint32_t owner = 0;
+        ASSERT_TRUE(read_u32_frame(fd, type, owner));
+        ASSERT_EQ(type, 2);
+        ASSERT_TRUE(owner < loops);
+        ++perLoop[owner];
+    }
+    if (srv.acceptDistribution() == Server::AcceptDistribution::RoundRobin) {
+        for (size_t count : perLoop) ASSERT_EQ(count, clients / loops);
+    }
+    size_t busyLoops = 0;
+    for (size_t count : perLoop) busyLoops += count > 0;
+    ASSERT_TRUE(busyLoops > 1);
+
+    // Sends from a foreign thread reach clients of every loop
+    Message all(3);
+    all << uint32_t(42);
+    srv.sendToAll(all);
+    for (int fd : fds) {
+        int32_t type = 0;
+        uint32_t value = 0;
+        ASSERT_TRUE(read_u32_frame(fd, type, value));
+        ASSERT_EQ(type, 3);
+        ASSERT_EQ(value, 42u);
+    }
+
+    // Each loop notices its own hang-ups
+    for (int fd : fds) ::close(fd);
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 0; }));
+    srv.stop();
+    return 0;
+}
+
+}
+
+// Connections spread over several event loops, with both accept strategies.
+extern "C" int multi_loop_test(void) {
+    if (run_with(Server::AcceptDistribution::RoundRobin) != 0) return 255;
+    if (run_with(Server::AcceptDistribution::ReusePort) != 0) return 255;
+
+    Server srv;
+    bool threw = false;
+    try { srv.setEventLoops(0); } catch (const std::invalid_argument &) { threw = true; }
+    ASSERT_TRUE(threw);
+    return 0;
+}
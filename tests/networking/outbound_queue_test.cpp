@@ -0,0 +1,245 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include "networking/socket_io.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+namespace {
+
+constexpr size_t kChunk = 16 * 1024;
+// 8 MiB: more than the kernel socket buffers (up to 4 MiB) absorb
+constexpr uint32_t kBurst = 512;
+// Small client receive buffer so the server side fills up quickly
+constexpr int kSmallRcvBuf = 4096;
+
+// Read one kChunk frame and return its sequence number, -1 on error or EOF
+long read_chunk(int fd) {
+    std::vector<uint8_t> frame(FRAME_HEADER_SIZE + kChunk);
+    size_t got = 0;
+    while (got < frame.size()) {
+        ssize_t r = ::recv(fd, frame.data() + got, frame.size() - got, 0);
+        if (r <= 0) return -1;
+        got += static_cast<size_t>(r);
+    }
+    uint32_t seq;
+    std::memcpy(&seq, frame.data() + FRAME_HEADER_SIZE, sizeof(seq));
+    return seq;
+}
+
+Message chunk(uint32_t seq) {
+    Message m(1);
+    std::vector<uint8_t> bytes(kChunk, 0x5A);
+    std::memcpy(bytes.data(), &seq, sizeof(seq));
+    m.payload().write(bytes.data(), bytes.size());
+    return m;
+}
+
+// Start a server with one connected raw client; returns the client's id
+int setup(Server& srv, int& fd, Server::ClientID& id) {
+    std::atomic<Server::ClientID> hello{0};
+    srv.defineAction(9, [&hello](Server::ClientID from, const Message &) { hello = from; });
+    srv.start(0);
+    fd = connect_raw(srv.getPort(), kSmallRcvBuf);
+    ASSERT_TRUE(fd >= 0);
+    uint8_t header[FRAME_HEADER_SIZE];
+    encode_frame_header(header, 9, 0);
+    ASSERT_EQ(::send(fd, header, sizeof(header), 0), static_cast<ssize_t>(sizeof(header)));
+    ASSERT_TRUE(wait_for([&] { return hello.load() != 0; }));
+    id = hello.load();
+    return 0;
+}
+
+// A reader slower than the sender keeps its connection; everything arrives
+int slow_reader_kept() {
+    constexpr uint32_t count = kBurst;
+    Server srv;
+    srv.setOutboundWatermarks(64 * 1024 * 1024, 16 * 1024 * 1024);
+    int fd;
+    Server::ClientID id;
+    if (setup(srv, fd, id) != 0) return 255;
+
+    for (uint32_t i = 0; i < count; ++i) srv.sendTo(chunk(i), id);
+    ASSERT_TRUE(wait_for([&] { return srv.queuedBytes(id) > 0; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(srv.clientCount(), 1u);
+    for (uint32_t i = 0; i < count; ++i) ASSERT_EQ(read_chunk(fd), static_cast<long>(i));
+    ASSERT_TRUE(wait_for([&] { return srv.queuedBytes(id) == 0; }));
+    ::close(fd);
+    srv.stop();
+    return 0;
+}
+
+// Output queued right before stop() is still delivered
+int stop_flushes_queued() {
+    constexpr uint32_t count = kBurst; // more than the socket buffers take at once
+    Server srv;
+    // the whole burst is queued whatever the reader does: no policy kicks in
+    srv.setOutboundWatermarks(2 * count * (FRAME_HEADER_SIZE + kChunk), count * (FRAME_HEADER_SIZE + kChunk));
+    int fd;
+    Server::ClientID id;
+    if (setup(srv, fd, id) != 0) return 255;
+
+    std::atomic<bool> complete{false};
+    std::thread reader([&] {
+        bool ordered = true;
+        for (uint32_t i = 0; i < count && ordered; ++i) ordered = read_chunk(fd) == static_cast<long>(i);
+        complete = ordered;
+    });
+    for (uint32_t i = 0; i < count; ++i) srv.sendTo(chunk(i), id);
+    srv.stop();
+    reader.join();
+    ::close(fd);
+    ASSERT_TRUE(complete.load());
+    return 0;
+}
+
+// Over the high watermark, Drop discards whole messages and keeps the client
+int drop_policy() {
+    Server srv;
+    srv.setOutboundWatermarks(8 * kChunk, 2 * kChunk);
+    srv.setSlowConsumerPolicy(Server::SlowConsumerPolicy::Drop);
+    int fd;
+    Server::ClientID id;
+    if (setup(srv, fd, id) != 0) return 255;
+
+    for (uint32_t i = 0; i < kBurst; ++i) srv.sendTo(chunk(i), id);
+    ASSERT_TRUE(srv.droppedMessages() > 0);
+    ASSERT_TRUE(srv.queuedBytes(id) <= 9 * (FRAME_HEADER_SIZE + kChunk));
+    ASSERT_EQ(srv.clientCount(), 1u);
+    // What was kept arrives intact and in order
+    long previous = -1;
+    size_t received = 0;
+    while (received + srv.droppedMessages() < kBurst) {
+        long seq = read_chunk(fd);
+        ASSERT_TRUE(seq > previous);
+        previous = seq;
+        ++received;
+    }
+    ::close(fd);
+    srv.stop();
+    return 0;
+}
+
+// Over the high watermark, Disconnect drops the client
+int disconnect_policy() {
+    Server srv;
+    srv.setOutboundWatermarks(8 * kChunk, 2 * kChunk);
+    int fd;
+    Server::ClientID id;
+    if (setup(srv, fd, id) != 0) return 255;
+    ASSERT_TRUE(srv.slowConsumerPolicy() == Server::SlowConsumerPolicy::Disconnect);
+
+    for (uint32_t i = 0; i < kBurst; ++i) srv.sendTo(chunk(i), id);
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 0; }));
+    ASSERT_EQ(srv.droppedMessages(), 0u);
+    ::close(fd);
+    srv.stop();
+    return 0;
+}
+
+// Over the high watermark, Block holds a foreign sender until the reader catches up
+int block_policy() {
+    constexpr uint32_t count = kBurst;
+    Server srv;
+    srv.setOutboundWatermarks(8 * kChunk, 2 * kChunk);
+    srv.setSlowConsumerPolicy(Server::SlowConsumerPolicy::Block);
+    int fd;
+    Server::ClientID id;
+    if (setup(srv, fd, id) != 0) return 255;
+
+    std::atomic<uint32_t> sent{0};
+    std::thread sender([&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            srv.sendTo(chunk(i), id);
+            ++sent;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const bool blocked = sent.load() < count;
+    const bool bounded = srv.queuedBytes(id) <= 9 * (FRAME_HEADER_SIZE + kChunk);
+    bool ordered = true;
+    for (uint32_t i = 0; i < count && ordered; ++i) ordered = read_chunk(fd) == static_cast<long>(i);
+    if (!ordered) srv.stop(); // releases the sender
+    sender.join();
+    ASSERT_TRUE(blocked);
+    ASSERT_TRUE(bounded);
+    ASSERT_TRUE(ordered);
+
+    // stop() releases a sender still waiting on a reader that never reads
+    std::thread stuck([&] {
+        for (uint32_t i = 0; i < count; ++i) srv.sendTo(chunk(i), id);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    srv.stop();
+    stuck.join();
+    ::close(fd);
+    return 0;
+}
+
+// Foreign threads keep sending while stop() tears the loops down
+int sends_during_stop() {
+    for (int round = 0; round < 50; ++round) {
+        Server srv;
+        // keep the client whatever its queue does, so sends keep reaching a loop
+        srv.setSlowConsumerPolicy(Server::SlowConsumerPolicy::Drop);
+        int fd;
+        Server::ClientID id;
+        if (setup(srv, fd, id) != 0) return 255;
+        std::thread reader([fd] {
+            uint8_t bytes[64 * 1024];
+            while (::recv(fd, bytes, sizeof(bytes), 0) > 0) {}
+        });
+        std::atomic<bool> done{false};
+        std::atomic<uint32_t> sent{0};
+        std::vector<std::thread> senders;
+        for (int i = 0; i < 4; ++i) {
+            senders.emplace_back([&] {
+                Message small(1);
+                small << uint32_t(7);
+                while (!done) {
+                    srv.sendTo(small, id);
+                    ++sent;
+                }
+            });
+        }
+        const bool sending = wait_for([&] { return sent.load() > 100; });
+        srv.stop();
+        // and after it: the client is gone, sends are ignored
+        const uint32_t stoppedAt = sent.load();
+        const bool stillSending = wait_for([&] { return sent.load() > stoppedAt + 100; });
+        done = true;
+        for (std::thread &sender : senders) sender.join();
+        reader.join();
+        ::close(fd);
+        ASSERT_TRUE(sending);
+        ASSERT_TRUE(stillSending);
+        ASSERT_EQ(srv.clientCount(), 0u);
+    }
+    return 0;
+}
+
+}
+
+// Server outbound queues: slow readers, flush on stop, sends racing stop(),
+// watermarks and the three policies.
+extern "C" int outbound_queue_test(void) {
+    if (slow_reader_kept() != 0) return 255;
+    if (stop_flushes_queued() != 0) return 255;
+    if (sends_during_stop() != 0) return 255;
+    if (drop_policy() != 0) return 255;
+    if (disconnect_policy() != 0) return 255;
+    if (block_policy() != 0) return 255;
+
+    Server srv;
+    bool threw = false;
+    try { srv.setOutboundWatermarks(10, 20); } catch (const std::invalid_argument &) { threw = true; }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(srv.outboundHighWatermark(), Server::DEFAULT_OUTBOUND_HIGH_WATERMARK);
+    return 0;
+}
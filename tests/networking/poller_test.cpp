@@ -0,0 +1,112 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+namespace {
+
+// Echo through a server holding many idle connections; hang-ups are noticed
+int server_with_backend(Poller::Backend backend) {
+    Server srv;
+    srv.setEventBackend(backend);
+    srv.defineAction(1, [&srv](Server::ClientID id, const Message &m) {
+        Message reply(2);
+        reply.payload().write(m.payload().data(), m.payload().size());
+        srv.sendTo(reply, id);
+    });
+    srv.start(0);
+
+    std::vector<int> idle;
+    for (int i = 0; i < 200; ++i) {
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        idle.push_back(fd);
+    }
+    Client c;
+    std::atomic<int> echoed{0};
+    c.defineAction(2, [&](const Message &m) { echoed += static_cast<int>(m.payload().size()); });
+    c.connect("127.0.0.1", srv.getPort());
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 201; }));
+
+    for (int i = 0; i < 10; ++i) {
+        Message m(1);
+        m << uint32_t(i);
+        c.send(m);
+    }
+    ASSERT_TRUE(wait_for([&] { c.update(); return echoed.load() == 40; }));
+
+    for (int fd : idle) ::close(fd);
+    ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 1; }));
+
+    // stop() wakes the blocked loop instead of waiting for a timeout
+    auto before = std::chrono::steady_clock::now();
+    srv.stop();
+    ASSERT_TRUE(std::chrono::steady_clock::now() - before < std::chrono::milliseconds(150));
+    c.disconnect();
+    return 0;
+}
+
+}
+
+// Poller readiness (edge vs level), wake(), and the Server loop on both backends.
+extern "C" int poller_test(void) {
+    for (Poller::Backend backend : {Poller::Backend::Epoll, Poller::Backend::Poll}) {
+        Poller poller(backend);
+        int fds[2];
+        ASSERT_EQ(::pipe(fds), 0);
+        poller.add(fds[0], Poller::Readable);
+        ASSERT_EQ(poller.size(), 1u);
+        std::vector<Poller::Event> ready;
+        ASSERT_EQ(poller.wait(ready, 0), 0u);
+
+        char byte = 'x';
+        ASSERT_EQ(::write(fds[1], &byte, 1), 1);
+        ASSERT_EQ(poller.wait(ready, 100), 1u);
+        ASSERT_EQ(ready[0].fd, fds[0]);
+        ASSERT_TRUE(ready[0].events & Poller::Readable);
+        // Not drained: epoll is edge-triggered, poll level-triggered
+        const size_t again = poller.wait(ready, 0);
+        ASSERT_EQ(again, backend == Poller::Backend::Epoll ? 0u : 1u);
+
+        std::thread waker([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            poller.wake();
+        });
+        ASSERT_EQ(::read(fds[0], &byte, 1), 1);
+        auto before = std::chrono::steady_clock::now();
+        ASSERT_EQ(poller.wait(ready, 5000), 0u);
+        waker.join();
+        ASSERT_TRUE(std::chrono::steady_clock::now() - before < std::chrono::seconds(2));
+
+        poller.remove(fds[0]);
+        ASSERT_EQ(poller.size(), 0u);
+        ::close(fds[0]);
+        ::close(fds[1]);
+
+        // A hang-up on a descriptor watched for nothing (a paused client)
+        // must not make every wait return
+        int pair[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+        poller.add(pair[0], Poller::Readable);
+        poller.modify(pair[0], 0);
+        ::close(pair[1]);
+        poller.wait(ready, 0); // epoll reports the edge at most once
+        ASSERT_EQ(poller.wait(ready, 0), 0u);
+        poller.modify(pair[0], Poller::Readable);
+        ASSERT_EQ(poller.wait(ready, 100), 1u);
+        ASSERT_EQ(ready[0].fd, pair[0]);
+        ASSERT_TRUE(ready[0].events & Poller::Readable);
+        poller.modify(pair[0], 0);
+        poller.remove(pair[0]);
+        ASSERT_EQ(poller.size(), 0u);
+        ::close(pair[0]);
+
+        if (server_with_backend(backend) != 0) return 255;
+    }
+    return 0;
+}
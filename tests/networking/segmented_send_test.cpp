@@ -0,0 +1,51 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+
+// A multi-segment payload sent with sendmsg() arrives as one ordinary Message.
+extern "C" int segmented_send_test(void) {
+    using namespace std::chrono_literals;
+    Server srv;
+    std::atomic<size_t> serverBytes{0};
+    std::atomic<bool> serverOk{false};
+    srv.defineAction(20, [&](Server::ClientID id, const Message &m) {
+        serverBytes = m.payload().size();
+        bool ok = true;
+        for (size_t i = 0; i < m.payload().size(); ++i) {
+            if (m.payload().data()[i] != static_cast<uint8_t>(i % 251)) { ok = false; break; }
+        }
+        serverOk = ok;
+        SegmentedBuffer reply;
+        reply << uint64_t(m.payload().size());
+        srv.sendTo(21, reply, id);
+    });
+    srv.start(0);
+
+    Client c;
+    std::atomic<uint64_t> echoed{0};
+    c.defineAction(21, [&](const Message &m) {
+        uint64_t v = 0;
+        if (m.payload().size() == sizeof(v)) std::memcpy(&v, m.payload().data(), sizeof(v));
+        echoed = v;
+    });
+    c.connect("127.0.0.1", srv.getPort());
+
+    SegmentedBuffer big;
+    const size_t size = SegmentedBuffer::SEGMENT_SIZE * 5 + 17;
+    for (size_t i = 0; i < size; ++i) big << static_cast<uint8_t>(i % 251);
+    c.send(20, big);
+
+    for (int i = 0; i < 100 && echoed.load() == 0; ++i) {
+        std::this_thread::sleep_for(20ms);
+        c.update();
+    }
+
+    srv.stop();
+    c.disconnect();
+    ASSERT_EQ(serverBytes.load(), size);
+    ASSERT_TRUE(serverOk.load());
+    ASSERT_EQ(echoed.load(), size);
+    return 0;
+}
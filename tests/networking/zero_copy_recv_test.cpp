@@ -0,0 +1,159 @@
+#include "../test_utils.hpp"
+#include "../libftpp.hpp"
+#include "networking/socket_io.hpp"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+namespace {
+
+bool send_all(int fd, const std::vector<uint8_t>& bytes) {
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        ssize_t w = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (w <= 0) return false;
+        sent += static_cast<size_t>(w);
+    }
+    return true;
+}
+
+// Frame `seq` carries its number then `size - 4` bytes derived from it
+void append_frame(std::vector<uint8_t>& out, uint32_t seq, size_t size) {
+    uint8_t header[FRAME_HEADER_SIZE];
+    encode_frame_header(header, 1, size);
+    out.insert(out.end(), header, header + sizeof(header));
+    const size_t start = out.size();
+    out.resize(start + size);
+    std::memcpy(out.data() + start, &seq, sizeof(seq));
+    for (size_t i = sizeof(seq); i < size; ++i) out[start + i] = static_cast<uint8_t>(seq + i);
+}
+
+bool frame_intact(const Message& m, uint32_t expected) {
+    const DataBuffer& p = m.payload();
+    uint32_t seq = 0;
+    if (p.size() < sizeof(seq)) return false;
+    std::memcpy(&seq, p.data(), sizeof(seq));
+    if (seq != expected) return false;
+    for (size_t i = sizeof(seq); i < p.size(); ++i) {
+        if (p.data()[i] != static_cast<uint8_t>(seq + i)) return false;
+    }
+    return true;
+}
+
+// Sizes cycle so that frames keep landing across the ring's wrap point
+size_t frame_size(uint32_t seq) {
+    return seq % 97 == 0 ? 70000 : 4 + (seq * 131) % 3000;
+}
+
+}
+
+// Frames read into the per-connection ring reach inline handlers without a
+// copy, in order and intact, whether many arrive per read, a frame spans
+// many reads, or it starts just before the wrap point; pool handlers get
+// copies, and an undecodable compressed frame closes the connection.
+extern "C" int zero_copy_recv_test(void) {
+    constexpr uint32_t kFrames = 2000;
+    std::vector<uint8_t> stream;
+    for (uint32_t seq = 0; seq < kFrames; ++seq) append_frame(stream, seq, frame_size(seq));
+
+    std::atomic<uint32_t> received{0};
+    std::atomic<uint32_t> borrowed{0};
+    std::atomic<bool> intact{true};
+    auto handler = [&](Server::ClientID, const Message &m) {
+        if (!frame_intact(m, received.load())) intact = false;
+        if (m.payload().isBorrowed()) ++borrowed;
+        ++received;
+    };
+
+    {
+        Server srv;
+        srv.defineAction(1, handler);
+        srv.start(0);
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        // in odd-sized pieces, so frames are cut at arbitrary points
+        bool sent = true;
+        for (size_t off = 0; off < stream.size() && sent; off += 50001) {
+            std::vector<uint8_t> piece(stream.begin() + off, stream.begin() + std::min(stream.size(), off + 50001));
+            sent = send_all(fd, piece);
+        }
+        bool done = sent && wait_for([&] { return received.load() == kFrames; });
+        ::close(fd);
+        srv.stop();
+        ASSERT_TRUE(done);
+        ASSERT_TRUE(intact.load());
+        // only a frame whose header was cut by a read may still be copied
+        ASSERT_TRUE(borrowed.load() >= kFrames - kFrames / 20);
+    }
+
+    // A frame whose start lands near the end of the ring is moved clear of
+    // the wrap point, so it is still read in place once complete
+    {
+        Server srv;
+        std::atomic<int> lastBorrowed{-1};
+        std::atomic<uint32_t> count{0};
+        srv.defineAction(1, [&](Server::ClientID, const Message &m) {
+            lastBorrowed = m.payload().isBorrowed() ? 1 : 0;
+            ++count;
+        });
+        srv.start(0);
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        std::vector<uint8_t> pair;
+        append_frame(pair, 0, 26000);
+        append_frame(pair, 1, 12000);
+        const size_t cut = FRAME_HEADER_SIZE + 26000 + 100;
+        bool sent = send_all(fd, std::vector<uint8_t>(pair.begin(), pair.begin() + cut));
+        bool first = sent && wait_for([&] { return count.load() == 1; });
+        sent = sent && send_all(fd, std::vector<uint8_t>(pair.begin() + cut, pair.end()));
+        bool second = sent && wait_for([&] { return count.load() == 2; });
+        ::close(fd);
+        srv.stop();
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        ASSERT_EQ(lastBorrowed.load(), 1);
+    }
+
+    // A compressed frame that does not decode closes the connection
+    {
+        Server srv;
+        srv.start(0);
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        ASSERT_TRUE(wait_for([&] { return srv.clientCount() == 1; }));
+        std::vector<uint8_t> bad(FRAME_HEADER_SIZE + 16, 0xFF);
+        encode_frame_header(bad.data(), 1, 16, true);
+        bool sent = send_all(fd, bad);
+        bool dropped = sent && wait_for([&] { return srv.clientCount() == 0; });
+        uint8_t byte;
+        const ssize_t r = ::recv(fd, &byte, 1, 0);
+        ::close(fd);
+        srv.stop();
+        ASSERT_TRUE(dropped);
+        ASSERT_TRUE(r <= 0);
+    }
+
+    received = 0;
+    borrowed = 0;
+    {
+        Server srv;
+        srv.setHandlerThreads(2);
+        srv.defineAction(1, handler);
+        srv.start(0);
+        int fd = connect_raw(srv.getPort());
+        ASSERT_TRUE(fd >= 0);
+        bool sent = send_all(fd, stream);
+        bool done = sent && wait_for([&] { return received.load() == kFrames; });
+        ::close(fd);
+        srv.stop();
+        ASSERT_TRUE(done);
+        ASSERT_TRUE(intact.load());
+        ASSERT_EQ(borrowed.load(), 0u);
+    }
+    return 0;
+}
@@ -2,9 +2,44 @@
 #define TEST_UTILS_HPP
 
 #include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
 
 // Simple helper macros for tests
 #define ASSERT_TRUE(expr) if (!(expr)) { std::cout << "Assertion failed: " #expr << std::endl; return 255; }
 #define ASSERT_EQ(a,b) if (!((a) == (b))) { std::cout << "Assertion failed: " #a " == " #b << std::endl; return 255; }
 
+// Blocking TCP connection to 127.0.0.1:port, -1 on failure. Reads time out
+// after 2 s. A non-zero rcvbuf sets SO_RCVBUF before connecting: a small
+// one makes the server side back up quickly.
+inline int connect_raw(size_t port, int rcvbuf = 0) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (rcvbuf > 0) ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    timeval timeout{2, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+// Poll pred every 10 ms for up to 5 s; returns its last result
+template <typename Pred>
+bool wait_for(Pred pred) {
+    for (int i = 0; i < 500 && !pred(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return pred();
+}
+
 #endif // TEST_UTILS_HPP
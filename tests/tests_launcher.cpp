@@ -1,36 +1,94 @@
 #include "framework/includes/libunit.hpp"
 #include "test_utils.hpp"
 
+extern "C" int loopback_test(void);
+extern "C" int compression_test(void);
+extern "C" int broadcast_test(void);
+extern "C" int outbound_queue_test(void);
+extern "C" int multi_loop_test(void);
+extern "C" int message_test(void);
+extern "C" int message_view_test(void);
+extern "C" int batch_send_test(void);
+extern "C" int poller_test(void);
+extern "C" int zero_copy_recv_test(void);
+extern "C" int message_schema_test(void);
+extern "C" int segmented_send_test(void);
+extern "C" int message_helpers_test(void);
+extern "C" int handler_pool_test(void);
+extern "C" int ring_buffer_test(void);
+extern "C" int data_buffer_byte_order_test(void);
+extern "C" int data_buffer_varint_test(void);
+extern "C" int data_buffer_more_tests(void);
+extern "C" int data_buffer_borrow_test(void);
+extern "C" int data_buffer_append_test(void);
 extern "C" int data_multiple_types_test(void);
 extern "C" int data_buffer_overflow_test(void);
-extern "C" int data_buffer_more_tests(void);
+extern "C" int data_buffer_container_codec_test(void);
+extern "C" int data_buffer_view_test(void);
+extern "C" int data_buffer_inline_storage_test(void);
+extern "C" int segmented_buffer_test(void);
+extern "C" int memory_resource_test(void);
+extern "C" int concurrent_pool_test(void);
 extern "C" int pool_handle_test(void);
+extern "C" int pool_slab_test(void);
+extern "C" int pool_growth_test(void);
+extern "C" int pool_reset_policy_test(void);
+extern "C" int pool_id_test(void);
+extern "C" int pool_batch_test(void);
+extern "C" int persistent_pool_test(void);
+extern "C" int pool_stats_test(void);
+extern "C" int magazine_pool_test(void);
 extern "C" int pool_basic_test(void);
-extern "C" int loopback_test(void);
-extern "C" int message_helpers_test(void);
-extern "C" int message_test(void);
-extern "C" int broadcast_test(void);
-extern "C" int state_machine_basic_test(void);
-extern "C" int observer_basic_test(void);
 extern "C" int memento_basic_test(void);
 extern "C" int singleton_basic_test(void);
+extern "C" int state_machine_basic_test(void);
+extern "C" int observer_basic_test(void);
 
 int main() {
     t_test *tests = NULL;
 
+    load_test(&tests, "Networking", "loopback", (void*)loopback_test, 0);
+    load_test(&tests, "Networking", "compression", (void*)compression_test, 0);
+    load_test(&tests, "Networking", "broadcast", (void*)broadcast_test, 0);
+    load_test(&tests, "Networking", "outbound_queue", (void*)outbound_queue_test, 0);
+    load_test(&tests, "Networking", "multi_loop", (void*)multi_loop_test, 0);
+    load_test(&tests, "Networking", "message", (void*)message_test, 0);
+    load_test(&tests, "Networking", "message_view", (void*)message_view_test, 0);
+    load_test(&tests, "Networking", "batch_send", (void*)batch_send_test, 0);
+    load_test(&tests, "Networking", "poller", (void*)poller_test, 0);
+    load_test(&tests, "Networking", "zero_copy_recv", (void*)zero_copy_recv_test, 0);
+    load_test(&tests, "Networking", "message_schema", (void*)message_schema_test, 0);
+    load_test(&tests, "Networking", "segmented_send", (void*)segmented_send_test, 0);
+    load_test(&tests, "Networking", "message_helpers", (void*)message_helpers_test, 0);
+    load_test(&tests, "Networking", "handler_pool", (void*)handler_pool_test, 0);
+    load_test(&tests, "RingBuffer", "ring_buffer", (void*)ring_buffer_test, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_byte_order", (void*)data_buffer_byte_order_test, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_varint", (void*)data_buffer_varint_test, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_more_tests", (void*)data_buffer_more_tests, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_borrow", (void*)data_buffer_borrow_test, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_append", (void*)data_buffer_append_test, 0);
     load_test(&tests, "DataBuffer", "data_multiple_types", (void*)data_multiple_types_test, 0);
     load_test(&tests, "DataBuffer", "data_buffer_overflow", (void*)data_buffer_overflow_test, 0);
-    load_test(&tests, "DataBuffer", "data_buffer_more_tests", (void*)data_buffer_more_tests, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_container_codec", (void*)data_buffer_container_codec_test, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_view", (void*)data_buffer_view_test, 0);
+    load_test(&tests, "DataBuffer", "data_buffer_inline_storage", (void*)data_buffer_inline_storage_test, 0);
+    load_test(&tests, "SegmentedBuffer", "segmented_buffer", (void*)segmented_buffer_test, 0);
+    load_test(&tests, "MemoryResource", "memory_resource", (void*)memory_resource_test, 0);
+    load_test(&tests, "Pool", "concurrent_pool", (void*)concurrent_pool_test, 0);
     load_test(&tests, "Pool", "pool_handle", (void*)pool_handle_test, 0);
+    load_test(&tests, "Pool", "pool_slab", (void*)pool_slab_test, 0);
+    load_test(&tests, "Pool", "pool_growth", (void*)pool_growth_test, 0);
+    load_test(&tests, "Pool", "pool_reset_policy", (void*)pool_reset_policy_test, 0);
+    load_test(&tests, "Pool", "pool_id", (void*)pool_id_test, 0);
+    load_test(&tests, "Pool", "pool_batch", (void*)pool_batch_test, 0);
+    load_test(&tests, "Pool", "persistent_pool", (void*)persistent_pool_test, 0);
+    load_test(&tests, "Pool", "pool_stats", (void*)pool_stats_test, 0);
+    load_test(&tests, "Pool", "magazine_pool", (void*)magazine_pool_test, 0);
     load_test(&tests, "Pool", "pool_basic", (void*)pool_basic_test, 0);
-    load_test(&tests, "Networking", "loopback", (void*)loopback_test, 0);
-    load_test(&tests, "Networking", "message_helpers", (void*)message_helpers_test, 0);
-    load_test(&tests, "Networking", "message", (void*)message_test, 0);
-    load_test(&tests, "Networking", "broadcast", (void*)broadcast_test, 0);
-    load_test(&tests, "DesignPatterns", "state_machine_basic", (void*)state_machine_basic_test, 0);
-    load_test(&tests, "DesignPatterns", "observer_basic", (void*)observer_basic_test, 0);
     load_test(&tests, "DesignPatterns", "memento_basic", (void*)memento_basic_test, 0);
     load_test(&tests, "DesignPatterns", "singleton_basic", (void*)singleton_basic_test, 0);
+    load_test(&tests, "DesignPatterns", "state_machine_basic", (void*)state_machine_basic_test, 0);
+    load_test(&tests, "DesignPatterns", "observer_basic", (void*)observer_basic_test, 0);
 
     return launch_tests(&tests);
 }
\ No newline at end of file